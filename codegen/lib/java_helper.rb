@@ -70,6 +70,8 @@ module JavaHelper
       'int'
     when :data
       'byte[]'
+    when :bytes
+      'byte[]'
     when 'Data'
       'byte[]'
     when :string
@@ -50,6 +50,8 @@ module JNIHelper
         (param.name || 'value') + 'Data'
       elsif param.type.name == :string
         (param.name || 'value') + 'String'
+      elsif param.type.name == :bytes
+        (param.type.is_inout ? '(uint8_t *) ' : '(const uint8_t *) ') + (param.name || 'value') + 'Bytes'
       elsif param.type.is_enum
         (param.name || 'value') + 'Value'
       elsif param.type.is_proto
@@ -88,6 +90,8 @@ module JNIHelper
       'jsize'
     when :data
       'jbyteArray'
+    when :bytes
+      'jbyteArray'
     when 'Data'
       'jbyteArray'
     when :string
@@ -61,6 +61,8 @@ class Parser
       return TypeDecl.new(name: :data, is_nullable: @buffer[1] == '_Nullable', is_inout: false)
     elsif @buffer.scan(/TWString\s?\*\s?(_Nullable|_Nonnull)/)
       return TypeDecl.new(name: :string, is_nullable: @buffer[1] == '_Nullable', is_inout: false)
+    elsif @buffer.scan(/(const )?uint8_t\s?\*\s?(_Nullable|_Nonnull)/)
+      return TypeDecl.new(name: :bytes, is_nullable: @buffer[2] == '_Nullable', is_inout: @buffer[1].nil?)
     elsif @buffer.scan(/enum TW(\w+)/)
       return TypeDecl.new(name: @buffer[1], is_enum: true)
     elsif @buffer.scan(/TW_(\w+)/)
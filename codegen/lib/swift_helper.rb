@@ -87,6 +87,9 @@ module SwiftHelper
       else
         'String'
       end
+    when :bytes
+      pointer = t.is_inout ? 'UnsafeMutablePointer<UInt8>' : 'UnsafePointer<UInt8>'
+      t.is_nullable ? pointer + '?' : pointer
     else
       if t.is_proto
         t.name
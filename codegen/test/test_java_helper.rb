@@ -10,5 +10,6 @@ class JavaHelperTest < Test::Unit::TestCase
   def test_type
     assert_equal(JavaHelper.type(TypeDecl.new(name: :bool)), 'boolean')
     assert_equal(JavaHelper.type(TypeDecl.new(name: :data)), 'byte[]')
+    assert_equal(JavaHelper.type(TypeDecl.new(name: :bytes)), 'byte[]')
   end
 end
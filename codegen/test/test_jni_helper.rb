@@ -17,5 +17,6 @@ class JNIHelperTest < Test::Unit::TestCase
   def test_type
     assert_equal(JNIHelper.type(TypeDecl.new(name: :bool)), 'jboolean')
     assert_equal(JNIHelper.type(TypeDecl.new(name: :data)), 'jbyteArray')
+    assert_equal(JNIHelper.type(TypeDecl.new(name: :bytes)), 'jbyteArray')
   end
 end
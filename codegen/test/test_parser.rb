@@ -32,6 +32,18 @@ class ParserTest < Test::Unit::TestCase
     assert_equal(func.parameters.first.type.name, :data)
   end
 
+  def test_parse_method_byte_buffers
+    parser = Parser.new(path: '', string: 'void TWHashSHA256Into(const uint8_t *_Nonnull data, size_t size, uint8_t *_Nullable output);')
+    func = parser.parse_func
+
+    assert_equal(func.parameters[0].type.name, :bytes)
+    assert_equal(func.parameters[0].type.is_inout, false)
+    assert_equal(func.parameters[1].type.name, :size)
+    assert_equal(func.parameters[2].type.name, :bytes)
+    assert_equal(func.parameters[2].type.is_inout, true)
+    assert_equal(func.parameters[2].type.is_nullable, true)
+  end
+
   def test_parse_invalid_method
     parser = Parser.new(path: '', string: '
       TW_EXPORT_METHOD
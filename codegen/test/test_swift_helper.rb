@@ -11,5 +11,7 @@ class SwiftHelperTest < Test::Unit::TestCase
   def test_type
     assert_equal(SwiftHelper.type(TypeDecl.new(name: :bool)), 'Bool')
     assert_equal(SwiftHelper.type(TypeDecl.new(name: :data)), 'Data')
+    assert_equal(SwiftHelper.type(TypeDecl.new(name: :bytes)), 'UnsafePointer<UInt8>')
+    assert_equal(SwiftHelper.type(TypeDecl.new(name: :bytes, is_inout: true, is_nullable: true)), 'UnsafeMutablePointer<UInt8>?')
   end
 end
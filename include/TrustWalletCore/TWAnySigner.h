@@ -18,6 +18,13 @@ struct TWAnySigner;
 /// Signs a transaction.
 extern TWData *_Nonnull TWAnySignerSign(TWData *_Nonnull input, enum TWCoinType coin);
 
+/// Signs a batch of transactions of the same coin, concurrently.
+/// Input: serialized SigningInputs, each preceded by its length (4 bytes, little endian).
+/// Output: one entry per input, in input order: a status byte (0: success, 1: error), the length of the result
+/// (4 bytes, little endian), and the result, which is the serialized SigningOutput or the UTF-8 error message.
+/// Returns null if the input stream is malformed.
+extern TWData *_Nullable TWAnySignerSignBatch(TWData *_Nonnull inputs, enum TWCoinType coin);
+
 /// Signs a json transaction with private key.
 extern TWString *_Nonnull TWAnySignerSignJSON(TWString *_Nonnull json, TWData *_Nonnull key, enum TWCoinType coin);
 
@@ -34,4 +41,22 @@ extern TWData *_Nonnull TWAnySignerDecode(TWData *_Nonnull input, enum TWCoinTyp
 /// Plan a transaction (for UTXO chains).
 extern TWData *_Nonnull TWAnySignerPlan(TWData *_Nonnull input, enum TWCoinType coin);
 
+/// Signs a transaction, like `TWAnySignerSign`, reading the serialized SigningInput from a borrowed buffer and writing
+/// the serialized SigningOutput into a caller-provided buffer, so that no `TWData` is allocated.
+/// Returns the size of the output; it is written only if it fits in capacity.  Output may be null to query the size,
+/// in which case the transaction is signed and nothing is kept: the call with a large enough buffer signs again, so
+/// callers should pass a buffer of the expected size and only query when it is too small.
+extern size_t TWAnySignerSignInto(const uint8_t *_Nonnull input, size_t inputSize, enum TWCoinType coin,
+                                  uint8_t *_Nullable output, size_t capacity);
+
+/// Encodes a transaction, like `TWAnySignerEncode`, with borrowed input and caller-provided output buffers, see
+/// `TWAnySignerSignInto`.
+extern size_t TWAnySignerEncodeInto(const uint8_t *_Nonnull input, size_t inputSize, enum TWCoinType coin,
+                                    uint8_t *_Nullable output, size_t capacity);
+
+/// Plans a transaction, like `TWAnySignerPlan`, with borrowed input and caller-provided output buffers, see
+/// `TWAnySignerSignInto`.
+extern size_t TWAnySignerPlanInto(const uint8_t *_Nonnull input, size_t inputSize, enum TWCoinType coin,
+                                  uint8_t *_Nullable output, size_t capacity);
+
 TW_EXTERN_C_END
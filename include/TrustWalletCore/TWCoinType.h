@@ -128,6 +128,18 @@ TW_EXPORT_METHOD
 TWString *_Nonnull TWCoinTypeDeriveAddressFromPublicKey(enum TWCoinType coin,
                                                         struct TWPublicKey *_Nonnull publicKey);
 
+/// Derives the address for a particular coin from raw public key bytes (of the coin's public key type), into a
+/// caller-provided buffer, without allocating wrapper objects.
+/// Returns the length of the address, 0 if the public key is invalid.  The address is written, null-terminated,
+/// only if it fits in capacity (including the terminator).
+size_t TWCoinTypeDeriveAddressFromPublicKeyInto(enum TWCoinType coin, const uint8_t *_Nonnull publicKey,
+                                                size_t publicKeySize, char *_Nullable output, size_t capacity);
+
+/// Derives the address for a particular coin from raw private key bytes, into a caller-provided buffer, see
+/// `TWCoinTypeDeriveAddressFromPublicKeyInto`.  Returns 0 if the private key is invalid.
+size_t TWCoinTypeDeriveAddressInto(enum TWCoinType coin, const uint8_t *_Nonnull privateKey, size_t privateKeySize,
+                                   char *_Nullable output, size_t capacity);
+
 /// HRP for this coin type
 TW_EXPORT_PROPERTY
 enum TWHRP TWCoinTypeHRP(enum TWCoinType coin);
@@ -82,4 +82,29 @@ TWData *_Nonnull TWHashBlake256RIPEMD(TWData *_Nonnull data);
 TW_EXPORT_STATIC_METHOD
 TWData *_Nonnull TWHashGroestl512Groestl512(TWData *_Nonnull data);
 
+// Variants hashing a borrowed buffer into a caller-provided output buffer of the hash length, without allocation.
+
+TW_EXPORT_STATIC_METHOD
+void TWHashSHA256Into(const uint8_t *_Nonnull data, size_t size, uint8_t *_Nonnull output);
+
+TW_EXPORT_STATIC_METHOD
+void TWHashSHA512Into(const uint8_t *_Nonnull data, size_t size, uint8_t *_Nonnull output);
+
+/// Output is 32 bytes.
+TW_EXPORT_STATIC_METHOD
+void TWHashKeccak256Into(const uint8_t *_Nonnull data, size_t size, uint8_t *_Nonnull output);
+
+TW_EXPORT_STATIC_METHOD
+void TWHashRIPEMDInto(const uint8_t *_Nonnull data, size_t size, uint8_t *_Nonnull output);
+
+/// Output is outputSize bytes, from 1 to 64.  Returns false, without writing output, if outputSize is out of range.
+TW_EXPORT_STATIC_METHOD
+bool TWHashBlake2bInto(const uint8_t *_Nonnull data, size_t size, uint8_t *_Nonnull output, size_t outputSize);
+
+TW_EXPORT_STATIC_METHOD
+void TWHashSHA256SHA256Into(const uint8_t *_Nonnull data, size_t size, uint8_t *_Nonnull output);
+
+TW_EXPORT_STATIC_METHOD
+void TWHashSHA256RIPEMDInto(const uint8_t *_Nonnull data, size_t size, uint8_t *_Nonnull output);
+
 TW_EXTERN_C_END
@@ -11,6 +11,22 @@
 #include "AnySigner.h"
 #include "TWJNI.h"
 
+/// Calls one of the TWAnySigner*Into functions on Java arrays; output may be null to query the size.
+static jint anySignerInto(JNIEnv *env, size_t (*function)(const uint8_t *, size_t, enum TWCoinType, uint8_t *, size_t),
+                          jbyteArray input, jint coin, jbyteArray output) {
+    jbyte *inputBytes = (*env)->GetByteArrayElements(env, input, NULL);
+    jsize inputSize = (*env)->GetArrayLength(env, input);
+    jbyte *outputBytes = output == NULL ? NULL : (*env)->GetByteArrayElements(env, output, NULL);
+    jsize capacity = output == NULL ? 0 : (*env)->GetArrayLength(env, output);
+    size_t size = function((const uint8_t *) inputBytes, inputSize, coin, (uint8_t *) outputBytes, capacity);
+    if (output != NULL) {
+        // copy back only if the output was written
+        (*env)->ReleaseByteArrayElements(env, output, outputBytes, size <= (size_t) capacity ? 0 : JNI_ABORT);
+    }
+    (*env)->ReleaseByteArrayElements(env, input, inputBytes, JNI_ABORT);
+    return (jint) size;
+}
+
 jbyteArray JNICALL Java_wallet_core_java_AnySigner_nativeSign(JNIEnv *env, jclass thisClass, jbyteArray input, jint coin) {
     TWData *inputData = TWDataCreateWithJByteArray(env, input);
     TWData *outputData = TWAnySignerSign(inputData, coin);
@@ -35,6 +51,18 @@ jbyteArray JNICALL Java_wallet_core_java_AnySigner_nativeDecode(JNIEnv *env, jcl
     return resultData;
 }
 
+jint JNICALL Java_wallet_core_java_AnySigner_nativeSignInto(JNIEnv *env, jclass thisClass, jbyteArray input, jint coin, jbyteArray output) {
+    return anySignerInto(env, TWAnySignerSignInto, input, coin, output);
+}
+
+jint JNICALL Java_wallet_core_java_AnySigner_nativeEncodeInto(JNIEnv *env, jclass thisClass, jbyteArray input, jint coin, jbyteArray output) {
+    return anySignerInto(env, TWAnySignerEncodeInto, input, coin, output);
+}
+
+jint JNICALL Java_wallet_core_java_AnySigner_nativePlanInto(JNIEnv *env, jclass thisClass, jbyteArray input, jint coin, jbyteArray output) {
+    return anySignerInto(env, TWAnySignerPlanInto, input, coin, output);
+}
+
 jboolean JNICALL Java_wallet_core_java_AnySigner_supportsJSON(JNIEnv *env, jclass thisClass, jint coin) {
     return TWAnySignerSupportsJSON(coin);
 }
@@ -21,6 +21,15 @@ jbyteArray JNICALL Java_wallet_core_java_AnySigner_nativeEncode(JNIEnv *env, jcl
 JNIEXPORT
 jbyteArray JNICALL Java_wallet_core_java_AnySigner_nativeDecode(JNIEnv *env, jclass thisClass, jbyteArray input, jint coin);
 
+JNIEXPORT
+jint JNICALL Java_wallet_core_java_AnySigner_nativeSignInto(JNIEnv *env, jclass thisClass, jbyteArray input, jint coin, jbyteArray output);
+
+JNIEXPORT
+jint JNICALL Java_wallet_core_java_AnySigner_nativeEncodeInto(JNIEnv *env, jclass thisClass, jbyteArray input, jint coin, jbyteArray output);
+
+JNIEXPORT
+jint JNICALL Java_wallet_core_java_AnySigner_nativePlanInto(JNIEnv *env, jclass thisClass, jbyteArray input, jint coin, jbyteArray output);
+
 JNIEXPORT
 jboolean JNICALL Java_wallet_core_java_AnySigner_supportsJSON(JNIEnv *env, jclass thisClass, jint coin);
 
@@ -21,6 +21,10 @@ public class AnySigner {
     }
     public static native byte[] nativeSign(byte[] data, int coin);
 
+    // Signs into output, without allocating, and returns the size of the signed output; output is written only if
+    // it is large enough, and may be null to query the size (which signs, see TWAnySignerSignInto).
+    public static native int nativeSignInto(byte[] data, int coin, byte[] output);
+
     public static byte[] encode(Message input, CoinType coin) throws Exception {
         byte[] data = input.toByteArray();
         return nativeEncode(data, coin.value());
@@ -28,6 +32,8 @@ public class AnySigner {
 
     public static native byte[] nativeEncode(byte[] data, int coin);
 
+    public static native int nativeEncodeInto(byte[] data, int coin, byte[] output);
+
     public static byte[] decode(byte[] data, CoinType coin) throws Exception {
         return nativeDecode(data, coin.value());
     }
@@ -46,4 +52,6 @@ public class AnySigner {
         return output;
     }
     public static native byte[] nativePlan(byte[] data, int coin);
+
+    public static native int nativePlanInto(byte[] data, int coin, byte[] output);
 }
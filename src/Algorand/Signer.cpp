@@ -7,6 +7,9 @@
 #include "Signer.h"
 #include "Address.h"
 #include "../PublicKey.h"
+#include "../SigningKey.h"
+
+#include <stdexcept>
 
 using namespace TW;
 using namespace TW::Algorand;
@@ -44,3 +47,25 @@ Data Signer::sign(const PrivateKey &privateKey, Transaction &transaction) noexce
     auto signature = privateKey.sign(data, TWCurveED25519);
     return Data(signature.begin(), signature.end());
 }
+
+std::vector<Data> Signer::sign(const std::vector<PrivateKey>& privateKeys,
+                               const std::vector<Transaction>& transactions, size_t threadCount) {
+    if (privateKeys.size() != transactions.size()) {
+        throw std::invalid_argument("One key per transaction is needed");
+    }
+    const auto keys = SigningKey::prepareAll(privateKeys, TWCurveED25519, threadCount);
+
+    std::vector<Data> messages;
+    messages.reserve(transactions.size());
+    std::vector<Data> signatures(transactions.size(), Data(64));
+    std::vector<SigningRequest> requests;
+    requests.reserve(transactions.size());
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        Data& data = messages.emplace_back();
+        append(data, TRANSACTION_TAG);
+        append(data, transactions[i].serialize());
+        requests.push_back({&keys[i], data.data(), data.size(), signatures[i].data()});
+    }
+    SigningKey::signAll(requests, threadCount);
+    return signatures;
+}
@@ -11,6 +11,8 @@
 #include "../Data.h"
 #include "../PrivateKey.h"
 
+#include <vector>
+
 namespace TW::Algorand {
 
 /// Helper class that performs Algorand transaction signing.
@@ -23,6 +25,14 @@ class Signer {
 
     /// Signs the given transaction.
     static Data sign(const PrivateKey& privateKey, Transaction& transaction) noexcept;
+
+    /// Signs each transaction with the key at the same index, e.g. the transactions of an atomic group, over worker
+    /// threads (see `parallelFor`).
+    ///
+    /// @returns the signatures, in transaction order.
+    /// @throws std::invalid_argument if the numbers of keys and transactions differ.
+    static std::vector<Data> sign(const std::vector<PrivateKey>& privateKeys,
+                                  const std::vector<Transaction>& transactions, size_t threadCount = 0);
 };
 
 } // namespace TW::Algorand
@@ -15,8 +15,6 @@ using namespace TW;
 using namespace TW::Binance;
 using namespace google::protobuf;
 
-using json = nlohmann::json;
-
 static inline std::string addressString(const std::string& bytes) {
     auto data = Data(bytes.begin(), bytes.end());
     return Address(data).string();
@@ -27,157 +25,204 @@ static inline std::string validatorAddress(const std::string& bytes) {
     return Bech32Address(Address::hrpValidator, data).string();
 }
 
-json Binance::signatureJSON(const Proto::SigningInput& input) {
-    json j;
-    j["account_number"] = std::to_string(input.account_number());
-    j["chain_id"] = input.chain_id();
-    j["data"] = nullptr;
-    j["memo"] = input.memo();
-    j["msgs"] = json::array({orderJSON(input)});
-    j["sequence"] = std::to_string(input.sequence());
-    j["source"] = std::to_string(input.source());
-    return j;
+std::string Binance::signatureJSON(const Proto::SigningInput& input) {
+    JSONWriter writer;
+    writer.reserve(512);
+    writer.beginObject()
+        .field("account_number", std::to_string(input.account_number()))
+        .field("chain_id", input.chain_id())
+        .key("data").null()
+        .field("memo", input.memo())
+        .key("msgs").beginArray();
+    orderJSON(writer, input);
+    writer.endArray()
+        .field("sequence", std::to_string(input.sequence()))
+        .field("source", std::to_string(input.source()))
+        .endObject();
+    return writer.release();
 }
 
-json Binance::orderJSON(const Proto::SigningInput& input) {
-    json j;
+void Binance::orderJSON(JSONWriter& writer, const Proto::SigningInput& input) {
+    // keys in sorted order
     if (input.has_trade_order()) {
-        j["id"] = input.trade_order().id();
-        j["ordertype"] = 2;
-        j["price"] = input.trade_order().price();
-        j["quantity"] = input.trade_order().quantity();
-        j["sender"] = addressString(input.trade_order().sender());
-        j["side"] = input.trade_order().side();
-        j["symbol"] = input.trade_order().symbol();
-        j["timeinforce"] = input.trade_order().timeinforce();
+        writer.beginObject()
+            .field("id", input.trade_order().id())
+            .field("ordertype", 2)
+            .field("price", input.trade_order().price())
+            .field("quantity", input.trade_order().quantity())
+            .field("sender", addressString(input.trade_order().sender()))
+            .field("side", input.trade_order().side())
+            .field("symbol", input.trade_order().symbol())
+            .field("timeinforce", input.trade_order().timeinforce())
+            .endObject();
     } else if (input.has_cancel_trade_order()) {
-        j["refid"] = input.cancel_trade_order().refid();
-        j["sender"] = addressString(input.cancel_trade_order().sender());
-        j["symbol"] = input.cancel_trade_order().symbol();
+        writer.beginObject()
+            .field("refid", input.cancel_trade_order().refid())
+            .field("sender", addressString(input.cancel_trade_order().sender()))
+            .field("symbol", input.cancel_trade_order().symbol())
+            .endObject();
     } else if (input.has_send_order()) {
-        j["inputs"] = inputsJSON(input.send_order());
-        j["outputs"] = outputsJSON(input.send_order());
+        writer.beginObject().key("inputs");
+        inputsJSON(writer, input.send_order());
+        writer.key("outputs");
+        outputsJSON(writer, input.send_order());
+        writer.endObject();
     } else if (input.has_freeze_order()) {
-        j["from"] = addressString(input.freeze_order().from());
-        j["symbol"] = input.freeze_order().symbol();
-        j["amount"] = input.freeze_order().amount();
+        writer.beginObject()
+            .field("amount", input.freeze_order().amount())
+            .field("from", addressString(input.freeze_order().from()))
+            .field("symbol", input.freeze_order().symbol())
+            .endObject();
     } else if (input.has_unfreeze_order()) {
-        j["from"] = addressString(input.unfreeze_order().from());
-        j["symbol"] = input.unfreeze_order().symbol();
-        j["amount"] = input.unfreeze_order().amount();
+        writer.beginObject()
+            .field("amount", input.unfreeze_order().amount())
+            .field("from", addressString(input.unfreeze_order().from()))
+            .field("symbol", input.unfreeze_order().symbol())
+            .endObject();
     } else if (input.has_htlt_order()) {
-        j["from"] = addressString(input.htlt_order().from());
-        j["to"] = addressString(input.htlt_order().to());
-        j["recipient_other_chain"] = input.htlt_order().recipient_other_chain();
-        j["sender_other_chain"] = input.htlt_order().sender_other_chain();
-        j["random_number_hash"] = hex(input.htlt_order().random_number_hash());
-        j["timestamp"] = input.htlt_order().timestamp();
-        j["amount"] = tokensJSON(input.htlt_order().amount());
-        j["expected_income"] = input.htlt_order().expected_income();
-        j["height_span"] = input.htlt_order().height_span();
-        j["cross_chain"] = input.htlt_order().cross_chain();
+        const auto& order = input.htlt_order();
+        writer.beginObject().key("amount");
+        tokensJSON(writer, order.amount());
+        writer.field("cross_chain", order.cross_chain())
+            .field("expected_income", order.expected_income())
+            .field("from", addressString(order.from()))
+            .field("height_span", order.height_span())
+            .field("random_number_hash", hex(order.random_number_hash()))
+            .field("recipient_other_chain", order.recipient_other_chain())
+            .field("sender_other_chain", order.sender_other_chain())
+            .field("timestamp", order.timestamp())
+            .field("to", addressString(order.to()))
+            .endObject();
     } else if (input.has_deposithtlt_order()) {
-        j["from"] = addressString(input.deposithtlt_order().from());
-        j["swap_id"] = hex(input.deposithtlt_order().swap_id());
-        j["amount"] = tokensJSON(input.deposithtlt_order().amount());
+        writer.beginObject().key("amount");
+        tokensJSON(writer, input.deposithtlt_order().amount());
+        writer.field("from", addressString(input.deposithtlt_order().from()))
+            .field("swap_id", hex(input.deposithtlt_order().swap_id()))
+            .endObject();
     } else if (input.has_claimhtlt_order()) {
-        j["from"] = addressString(input.claimhtlt_order().from());
-        j["swap_id"] = hex(input.claimhtlt_order().swap_id());
-        j["random_number"] = hex(input.claimhtlt_order().random_number());
+        writer.beginObject()
+            .field("from", addressString(input.claimhtlt_order().from()))
+            .field("random_number", hex(input.claimhtlt_order().random_number()))
+            .field("swap_id", hex(input.claimhtlt_order().swap_id()))
+            .endObject();
     } else if (input.has_refundhtlt_order()) {
-        j["from"] = addressString(input.refundhtlt_order().from());
-        j["swap_id"] = hex(input.refundhtlt_order().swap_id());
+        writer.beginObject()
+            .field("from", addressString(input.refundhtlt_order().from()))
+            .field("swap_id", hex(input.refundhtlt_order().swap_id()))
+            .endObject();
     } else if (input.has_transfer_out_order()) {
         auto to = input.transfer_out_order().to();
         auto addr = Ethereum::Address(Data(to.begin(), to.end()));
-        j["from"] = addressString(input.transfer_out_order().from());
-        j["to"] = addr.string();
-        j["amount"] = tokenJSON(input.transfer_out_order().amount());
-        j["expire_time"] = input.transfer_out_order().expire_time();
+        writer.beginObject().key("amount");
+        tokenJSON(writer, input.transfer_out_order().amount());
+        writer.field("expire_time", input.transfer_out_order().expire_time())
+            .field("from", addressString(input.transfer_out_order().from()))
+            .field("to", addr.string())
+            .endObject();
     } else if (input.has_side_delegate_order()) {
-        j["type"] = "cosmos-sdk/MsgSideChainDelegate";
-        j["value"] = {
-            {"delegator_addr", addressString(input.side_delegate_order().delegator_addr())},
-            {"validator_addr",validatorAddress(input.side_delegate_order().validator_addr())},
-            {"delegation", tokenJSON(input.side_delegate_order().delegation(), true)},
-            {"side_chain_id", input.side_delegate_order().chain_id()},
-        };
+        writer.beginObject()
+            .field("type", "cosmos-sdk/MsgSideChainDelegate")
+            .key("value").beginObject()
+                .key("delegation");
+        tokenJSON(writer, input.side_delegate_order().delegation(), true);
+        writer.field("delegator_addr", addressString(input.side_delegate_order().delegator_addr()))
+                .field("side_chain_id", input.side_delegate_order().chain_id())
+                .field("validator_addr", validatorAddress(input.side_delegate_order().validator_addr()))
+            .endObject()
+        .endObject();
     } else if (input.has_side_redelegate_order()) {
-        j["type"] = "cosmos-sdk/MsgSideChainRedelegate";
-        j["value"] = {
-            {"delegator_addr", addressString(input.side_redelegate_order().delegator_addr())},
-            {"validator_src_addr", validatorAddress(input.side_redelegate_order().validator_src_addr())},
-            {"validator_dst_addr", validatorAddress(input.side_redelegate_order().validator_dst_addr())},
-            {"amount", tokenJSON(input.side_redelegate_order().amount(), true)},
-            {"side_chain_id", input.side_redelegate_order().chain_id()},
-        };
+        writer.beginObject()
+            .field("type", "cosmos-sdk/MsgSideChainRedelegate")
+            .key("value").beginObject()
+                .key("amount");
+        tokenJSON(writer, input.side_redelegate_order().amount(), true);
+        writer.field("delegator_addr", addressString(input.side_redelegate_order().delegator_addr()))
+                .field("side_chain_id", input.side_redelegate_order().chain_id())
+                .field("validator_dst_addr", validatorAddress(input.side_redelegate_order().validator_dst_addr()))
+                .field("validator_src_addr", validatorAddress(input.side_redelegate_order().validator_src_addr()))
+            .endObject()
+        .endObject();
     } else if (input.has_side_undelegate_order()) {
-        j["type"] = "cosmos-sdk/MsgSideChainUndelegate";
-        j["value"] = {
-            {"delegator_addr", addressString(input.side_undelegate_order().delegator_addr())},
-            {"validator_addr", validatorAddress(input.side_undelegate_order().validator_addr())},
-            {"amount", tokenJSON(input.side_undelegate_order().amount(), true)},
-            {"side_chain_id", input.side_undelegate_order().chain_id()},
-        };
+        writer.beginObject()
+            .field("type", "cosmos-sdk/MsgSideChainUndelegate")
+            .key("value").beginObject()
+                .key("amount");
+        tokenJSON(writer, input.side_undelegate_order().amount(), true);
+        writer.field("delegator_addr", addressString(input.side_undelegate_order().delegator_addr()))
+                .field("side_chain_id", input.side_undelegate_order().chain_id())
+                .field("validator_addr", validatorAddress(input.side_undelegate_order().validator_addr()))
+            .endObject()
+        .endObject();
     } else if (input.has_time_lock_order()) {
-        j["from"] = addressString(input.time_lock_order().from_address());
-        j["description"] = input.time_lock_order().description();
-        j["amount"] = tokensJSON(input.time_lock_order().amount());
-        j["lock_time"] = input.time_lock_order().lock_time();
+        writer.beginObject().key("amount");
+        tokensJSON(writer, input.time_lock_order().amount());
+        writer.field("description", input.time_lock_order().description())
+            .field("from", addressString(input.time_lock_order().from_address()))
+            .field("lock_time", input.time_lock_order().lock_time())
+            .endObject();
     } else if (input.has_time_relock_order()) {
-        const auto amount = input.time_relock_order().amount();
-        j["from"] = addressString(input.time_relock_order().from_address());
-        j["time_lock_id"] = input.time_relock_order().id();
-        j["description"] = input.time_relock_order().description();
+        const auto& amount = input.time_relock_order().amount();
+        writer.beginObject().key("amount");
         // if amount is empty or omitted, set null to avoid signature verification error
-        j["amount"] = nullptr;
         if (amount.size() > 0) {
-            j["amount"] = tokensJSON(amount);
+            tokensJSON(writer, amount);
+        } else {
+            writer.null();
         }
-        j["lock_time"] = input.time_relock_order().lock_time();
+        writer.field("description", input.time_relock_order().description())
+            .field("from", addressString(input.time_relock_order().from_address()))
+            .field("lock_time", input.time_relock_order().lock_time())
+            .field("time_lock_id", input.time_relock_order().id())
+            .endObject();
     } else if (input.has_time_unlock_order()) {
-        j["from"] = addressString(input.time_unlock_order().from_address());
-        j["time_lock_id"] = input.time_unlock_order().id();
+        writer.beginObject()
+            .field("from", addressString(input.time_unlock_order().from_address()))
+            .field("time_lock_id", input.time_unlock_order().id())
+            .endObject();
+    } else {
+        writer.null();
     }
-    return j;
 }
 
-json Binance::inputsJSON(const Proto::SendOrder& order) {
-    json j = json::array();
+void Binance::inputsJSON(JSONWriter& writer, const Proto::SendOrder& order) {
+    writer.beginArray();
     for (auto& input : order.inputs()) {
-        j.push_back({
-            {"address", addressString(input.address())},
-            {"coins", tokensJSON(input.coins())}
-        });
+        writer.beginObject()
+            .field("address", addressString(input.address()))
+            .key("coins");
+        tokensJSON(writer, input.coins());
+        writer.endObject();
     }
-    return j;
+    writer.endArray();
 }
 
-json Binance::outputsJSON(const Proto::SendOrder& order) {
-    json j = json::array();
+void Binance::outputsJSON(JSONWriter& writer, const Proto::SendOrder& order) {
+    writer.beginArray();
     for (auto& output : order.outputs()) {
-        j.push_back({
-            {"address", addressString(output.address())},
-            {"coins", tokensJSON(output.coins())}
-        });
+        writer.beginObject()
+            .field("address", addressString(output.address()))
+            .key("coins");
+        tokensJSON(writer, output.coins());
+        writer.endObject();
     }
-    return j;
+    writer.endArray();
 }
 
-json Binance::tokenJSON(const Proto::SendOrder_Token& token, bool stringAmount) {
-    json j = { {"denom", token.denom()} };
+void Binance::tokenJSON(JSONWriter& writer, const Proto::SendOrder_Token& token, bool stringAmount) {
+    writer.beginObject();
     if (stringAmount) {
-        j["amount"] = std::to_string(token.amount());
+        writer.field("amount", std::to_string(token.amount()));
     } else {
-        j["amount"] = token.amount();
+        writer.field("amount", token.amount());
     }
-    return j;
+    writer.field("denom", token.denom())
+        .endObject();
 }
 
-json Binance::tokensJSON(const RepeatedPtrField<Proto::SendOrder_Token>& tokens) {
-    json j = json::array();
+void Binance::tokensJSON(JSONWriter& writer, const RepeatedPtrField<Proto::SendOrder_Token>& tokens) {
+    writer.beginArray();
     for (auto& token : tokens) {
-        j.push_back(tokenJSON(token));
+        tokenJSON(writer, token);
     }
-    return j;
+    writer.endArray();
 }
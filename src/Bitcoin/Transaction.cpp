@@ -18,7 +18,8 @@ using namespace TW;
 using namespace TW::Bitcoin;
 
 Data Transaction::getPreImage(const Script& scriptCode, size_t index,
-                              enum TWBitcoinSigHashType hashType, uint64_t amount) const {
+                              enum TWBitcoinSigHashType hashType, uint64_t amount,
+                              const SignatureHashCache* cache) const {
     assert(index < inputs.size());
 
     Data data;
@@ -28,7 +29,7 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
 
     // Input prevouts (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0) {
-        auto hashPrevouts = getPrevoutHash();
+        auto hashPrevouts = cache != nullptr ? cache->prevoutHash : getPrevoutHash();
         std::copy(std::begin(hashPrevouts), std::end(hashPrevouts), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -37,7 +38,7 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
     // Input nSequence (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 &&
         !hashTypeIsSingle(hashType) && !hashTypeIsNone(hashType)) {
-        auto hashSequence = getSequenceHash();
+        auto hashSequence = cache != nullptr ? cache->sequenceHash : getSequenceHash();
         std::copy(std::begin(hashSequence), std::end(hashSequence), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -54,7 +55,7 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
 
     // Outputs (none/one/all, depending on flags)
     if (!hashTypeIsSingle(hashType) && !hashTypeIsNone(hashType)) {
-        auto hashOutputs = getOutputsHash();
+        auto hashOutputs = cache != nullptr ? cache->outputsHash : getOutputsHash();
         copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
     } else if (hashTypeIsSingle(hashType) && index < outputs.size()) {
         Data outputData;
@@ -102,6 +103,10 @@ Data Transaction::getOutputsHash() const {
     return hash;
 }
 
+SignatureHashCache Transaction::getSignatureHashCache() const {
+    return SignatureHashCache{getPrevoutHash(), getSequenceHash(), getOutputsHash()};
+}
+
 void Transaction::encode(Data& data, enum SegwitFormatMode segwitFormat) const {
     bool useWitnessFormat = true;
     switch (segwitFormat) {
@@ -149,20 +154,20 @@ bool Transaction::hasWitness() const {
 
 Data Transaction::getSignatureHash(const Script& scriptCode, size_t index,
                                    enum TWBitcoinSigHashType hashType, uint64_t amount,
-                                   enum SignatureVersion version) const {
+                                   enum SignatureVersion version, const SignatureHashCache* cache) const {
     switch (version) {
     case BASE:
         return getSignatureHashBase(scriptCode, index, hashType);
     case WITNESS_V0:
-        return getSignatureHashWitnessV0(scriptCode, index, hashType, amount);
+        return getSignatureHashWitnessV0(scriptCode, index, hashType, amount, cache);
     }
 }
 
 /// Generates the signature hash for Witness version 0 scripts.
 Data Transaction::getSignatureHashWitnessV0(const Script& scriptCode, size_t index,
                                             enum TWBitcoinSigHashType hashType,
-                                            uint64_t amount) const {
-    auto preimage = getPreImage(scriptCode, index, hashType, amount);
+                                            uint64_t amount, const SignatureHashCache* cache) const {
+    auto preimage = getPreImage(scriptCode, index, hashType, amount, cache);
     auto hash = TW::Hash::hash(hasher, preimage);
     return hash;
 }
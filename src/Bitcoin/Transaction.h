@@ -18,6 +18,13 @@
 
 namespace TW::Bitcoin {
 
+/// Hashes over all inputs and outputs, shared by the signature hashes of every input (BIP143, ZIP-143/243).
+struct SignatureHashCache {
+    Data prevoutHash;
+    Data sequenceHash;
+    Data outputsHash;
+};
+
 struct Transaction {
 public:
     /// Transaction data format version (note, this is signed)
@@ -55,12 +62,16 @@ public:
     /// Whether the transaction is empty.
     bool empty() const { return inputs.empty() && outputs.empty(); }
 
-    /// Generates the signature pre-image.
-    Data getPreImage(const Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType, uint64_t amount) const;
+    /// Generates the signature pre-image, with the shared hashes of cache if given (see `getSignatureHash`).
+    Data getPreImage(const Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType, uint64_t amount,
+                     const SignatureHashCache* cache = nullptr) const;
     Data getPrevoutHash() const;
     Data getSequenceHash() const;
     Data getOutputsHash() const;
 
+    /// Computes the hashes shared by the signature hashes of all inputs, for signing many inputs.
+    SignatureHashCache getSignatureHashCache() const;
+
     enum SegwitFormatMode {
         NonSegwit,
         IfHasWitness,
@@ -79,8 +90,12 @@ public:
     bool hasWitness() const;
 
     /// Generates the signature hash for this transaction.
+    ///
+    /// cache, if given, must come from `getSignatureHashCache` with the current inputs and outputs; it saves
+    /// rehashing all of them for each input.
     Data getSignatureHash(const Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType,
-                          uint64_t amount, enum SignatureVersion version) const;
+                          uint64_t amount, enum SignatureVersion version,
+                          const SignatureHashCache* cache = nullptr) const;
 
     void serializeInput(size_t subindex, const Script&, size_t index, enum TWBitcoinSigHashType hashType, Data& data) const;
 
@@ -90,7 +105,8 @@ public:
 private:
     /// Generates the signature hash for Witness version 0 scripts.
     Data getSignatureHashWitnessV0(const Script& scriptCode, size_t index,
-                                   enum TWBitcoinSigHashType hashType, uint64_t amount) const;
+                                   enum TWBitcoinSigHashType hashType, uint64_t amount,
+                                   const SignatureHashCache* cache) const;
 
     /// Generates the signature hash for for scripts other than witness scripts.
     Data getSignatureHashBase(const Script& scriptCode, size_t index,
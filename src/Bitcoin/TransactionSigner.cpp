@@ -14,6 +14,7 @@
 #include "../BinaryCoding.h"
 #include "../Hash.h"
 #include "../HexCoding.h"
+#include "../Parallel.h"
 #include "../Zcash/Transaction.h"
 #include "../Groestlcoin/Transaction.h"
 
@@ -34,19 +35,29 @@ Result<Transaction, Error> TransactionSigner<Transaction, TransactionBuilder>::s
     std::copy(std::begin(transaction.inputs), std::end(transaction.inputs),
               std::back_inserter(signedInputs));
 
+    // Signature hashes depend on the prevouts, sequences and outputs only, not on the scripts of other inputs, so
+    // the shared hashes are computed once and inputs are signed independently, in parallel for larger transactions.
+    signatureHashCache = transaction.getSignatureHashCache();
+    const auto count = std::min(plan.utxos.size(), transaction.inputs.size());
+    std::vector<Error> errors(count);
     const auto hashSingle = hashTypeIsSingle(static_cast<enum TWBitcoinSigHashType>(input.hash_type()));
-    for (auto i = 0; i < plan.utxos.size(); i++) {
+    parallelFor(count, [&](size_t i) {
         // Only sign TWBitcoinSigHashTypeSingle if there's a corresponding output
         if (hashSingle && i >= transaction.outputs.size()) {
-            continue;
+            return;
         }
         auto& utxo = plan.utxos[i];
         auto script = Script(utxo.script().begin(), utxo.script().end());
-        if (i < transaction.inputs.size()) {
-            auto result = sign(script, i, utxo);
-            if (!result) {
-                return Result<Transaction, Error>::failure(result.error());
-            }
+        auto result = sign(script, i, utxo);
+        if (!result) {
+            errors[i] = result.error();
+        }
+    }, count < parallelSigningMinInputs ? 1 : 0);
+    signatureHashCache.reset();
+
+    for (auto& error : errors) {
+        if (error.hasError()) {
+            return Result<Transaction, Error>::failure(std::move(error));
         }
     }
 
@@ -132,9 +143,8 @@ Result<void, Error> TransactionSigner<Transaction, TransactionBuilder>::sign(Scr
 template <typename Transaction, typename TransactionBuilder>
 Result<std::vector<Data>, Error> TransactionSigner<Transaction, TransactionBuilder>::signStep(
     Script script, size_t index, const Bitcoin::Proto::UnspentTransaction& utxo, uint32_t version) const {
-    Transaction transactionToSign(transaction);
-    transactionToSign.inputs = signedInputs;
-    transactionToSign.outputs = transaction.outputs;
+    // other inputs are signed concurrently; their scripts are not part of the signature hash
+    const auto& transactionToSign = transaction;
 
     Data data;
     std::vector<Data> keys;
@@ -236,7 +246,8 @@ Data TransactionSigner<Transaction, TransactionBuilder>::createSignature(const T
         return Data(72);
     }
     Data sighash = transaction.getSignatureHash(script, index, static_cast<TWBitcoinSigHashType>(input.hash_type()), amount,
-                                                static_cast<SignatureVersion>(version));
+                                                static_cast<SignatureVersion>(version),
+                                                signatureHashCache ? &*signatureHashCache : nullptr);
     auto pk = PrivateKey(key);
     auto sig = pk.signAsDER(sighash, TWCurveSECP256k1);
     if (!sig.empty()) {
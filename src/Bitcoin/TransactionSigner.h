@@ -20,6 +20,7 @@
 #include "../proto/Bitcoin.pb.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -45,6 +46,12 @@ class TransactionSigner {
 
     bool estimationMode = false;
 
+    /// Hashes shared by the signature hashes of all inputs, set while `sign` signs the inputs of `transaction`.
+    std::optional<SignatureHashCache> signatureHashCache;
+
+    /// Transactions with fewer inputs are signed on the calling thread only.
+    static constexpr size_t parallelSigningMinInputs = 8;
+
   public:
     /// Initializes a transaction signer with signing input.
     /// estimationMode: is set, no real signing is performed, only as much as needed to get the almost-exact signed size 
@@ -19,35 +19,47 @@ TW::Data Encode::encoded() const {
     if (openIndefCount > 0) {
         throw invalid_argument("CBOR Unclosed indefinite length building");
     }
+    if (!openCounts.empty()) {
+        throw invalid_argument("CBOR Unclosed definite length building");
+    }
     return data;
 }
 
 Encode Encode::uint(uint64_t value) {
-    return Encode().appendValue(Decode::MT_uint, value);
+    Encode e;
+    e.addUint(value);
+    return e;
 }
 
 Encode Encode::negInt(uint64_t value) {
-    if (value == 0) {
-        // special handling for -1, to avoid underflow
-        return Encode().appendValue(Decode::MT_uint, 0);
-    }
-    return Encode().appendValue(Decode::MT_negint, value - 1);
+    Encode e;
+    e.addNegInt(value);
+    return e;
 }
 
 Encode Encode::string(const std::string& str) {
-    return Encode().appendValue(Decode::MT_string, str.size()).append(TW::data(str));
+    Encode e;
+    e.addString(str);
+    return e;
 }
 
 Encode Encode::bytes(const Data& str) {
-    return Encode().appendValue(Decode::MT_bytes, str.size()).append(str);
+    Encode e;
+    e.addBytes(str);
+    return e;
 }
 
 Encode Encode::array(const vector<Encode>& elems) {
     Encode e;
     auto n = elems.size();
-    e.appendValue(Decode::MT_array, n);
-    for (int i = 0; i < n; ++i) {
-        e.append(elems[i].encoded());
+    size_t size = 9;
+    for (const auto& elem: elems) {
+        size += elem.size();
+    }
+    e.reserve(size);
+    e.beginArray(n);
+    for (const auto& elem: elems) {
+        e.addEncoded(elem);
     }
     return e;
 }
@@ -55,18 +67,24 @@ Encode Encode::array(const vector<Encode>& elems) {
 Encode Encode::map(const vector<std::pair<Encode, Encode>>& elems) {
     Encode e;
     auto n = elems.size();
-    e.appendValue(Decode::MT_map, n);
-    for (int i = 0; i < n; ++i) {
-        e.append(elems[i].first.encoded());
-        e.append(elems[i].second.encoded());
+    size_t size = 9;
+    for (const auto& elem: elems) {
+        size += elem.first.size() + elem.second.size();
+    }
+    e.reserve(size);
+    e.beginMap(n);
+    for (const auto& elem: elems) {
+        e.addEncoded(elem.first);
+        e.addEncoded(elem.second);
     }
     return e;
 }
 
 Encode Encode::tag(uint64_t value, const Encode& elem) {
     Encode e;
-    e.appendValue(Decode::MT_tag, value);
-    e.append(elem.encoded());
+    e.reserve(9 + elem.size());
+    e.beginTag(value);
+    e.addEncoded(elem);
     return e;
 }
 
@@ -77,7 +95,7 @@ Encode Encode::indefArray() {
     return e;
 }
 
-Encode Encode::addIndefArrayElem(const Encode& elem) {
+Encode& Encode::addIndefArrayElem(const Encode& elem) {
     if (openIndefCount == 0) {
         throw invalid_argument("CBOR Not inside indefinite-length array");
     }
@@ -85,7 +103,7 @@ Encode Encode::addIndefArrayElem(const Encode& elem) {
     return *this;
 }
 
-Encode Encode::closeIndefArray() {
+Encode& Encode::closeIndefArray() {
     if (openIndefCount == 0) {
         throw invalid_argument("CBOR Not inside indefinite-length array");
     }
@@ -96,6 +114,83 @@ Encode Encode::closeIndefArray() {
     return *this;
 }
 
+void Encode::countElement() {
+    if (openCounts.empty()) {
+        return;
+    }
+    --openCounts.back();
+    // close all completed containers
+    while (!openCounts.empty() && openCounts.back() == 0) {
+        openCounts.pop_back();
+    }
+}
+
+void Encode::openContainer(uint64_t count) {
+    // the container itself is an element of the enclosing one
+    countElement();
+    if (count > 0) {
+        openCounts.push_back(count);
+    }
+}
+
+Encode& Encode::beginArray(uint64_t count) {
+    appendValue(Decode::MT_array, count);
+    openContainer(count);
+    return *this;
+}
+
+Encode& Encode::beginMap(uint64_t count) {
+    appendValue(Decode::MT_map, count);
+    openContainer(2 * count);
+    return *this;
+}
+
+Encode& Encode::beginTag(uint64_t value) {
+    appendValue(Decode::MT_tag, value);
+    openContainer(1);
+    return *this;
+}
+
+Encode& Encode::addUint(uint64_t value) {
+    appendValue(Decode::MT_uint, value);
+    countElement();
+    return *this;
+}
+
+Encode& Encode::addNegInt(uint64_t value) {
+    if (value == 0) {
+        // special handling for -1, to avoid underflow
+        appendValue(Decode::MT_uint, 0);
+    } else {
+        appendValue(Decode::MT_negint, value - 1);
+    }
+    countElement();
+    return *this;
+}
+
+Encode& Encode::addString(const std::string& str) {
+    appendValue(Decode::MT_string, str.size());
+    data.insert(data.end(), str.begin(), str.end());
+    countElement();
+    return *this;
+}
+
+Encode& Encode::addBytes(const Data& str) {
+    appendValue(Decode::MT_bytes, str.size());
+    append(str);
+    countElement();
+    return *this;
+}
+
+Encode& Encode::addEncoded(const Encode& elem) {
+    if (elem.openIndefCount > 0 || !elem.openCounts.empty()) {
+        throw invalid_argument("CBOR Unclosed building in added element");
+    }
+    append(elem.data);
+    countElement();
+    return *this;
+}
+
 Encode Encode::fromRaw(const TW::Data& rawData) {
     // check validity, may throw
     Decode check(rawData);
@@ -103,7 +198,7 @@ Encode Encode::fromRaw(const TW::Data& rawData) {
     return Encode(rawData);
 }
 
-Encode Encode::appendValue(byte majorType, uint64_t value) {
+Encode& Encode::appendValue(byte majorType, uint64_t value) {
     byte byteCount = 0;
     byte minorType = 0;
     if (value < 24) {
@@ -124,12 +219,9 @@ Encode Encode::appendValue(byte majorType, uint64_t value) {
     }
     // add bytes
     TW::append(data, (byte)((majorType << 5) | (minorType & 0x1F)));
-    Data valBytes = Data(byteCount - 1);
-    for (int i = 0; i < valBytes.size(); ++i) {
-        valBytes[valBytes.size() - 1 - i] = (byte)(value & 0xFF);
-        value = value >> 8;
+    for (int i = byteCount - 2; i >= 0; --i) {
+        data.push_back((byte)((value >> (i * 8)) & 0xFF));
     }
-    append(valBytes);
     return *this;
 }
 
@@ -146,6 +238,12 @@ Decode::Decode(const Data& input)
     subLen = (uint32_t)input.size();
 }
 
+Decode::Decode(Data&& input)
+: data(std::make_shared<OrigDataRef>(std::move(input))) {
+    subStart = 0;
+    subLen = (uint32_t)data->origData.size();
+}
+
 Decode::Decode(const std::shared_ptr<OrigDataRef>& nData, uint32_t nSubStart, uint32_t nSubLen)
 : data(nData) {
     // shared_ptr to original input data added
@@ -244,11 +342,10 @@ uint64_t Decode::getValue() const {
 }
 
 std::string Decode::getString() const {
-    Data strData = getBytes();
-    return std::string((const char*)strData.data(), strData.size()); 
+    return std::string(getStringView());
 }
 
-Data Decode::getBytes() const {
+std::string_view Decode::getStringView() const {
     TypeDesc typeDesc = getTypeDesc();
     if (typeDesc.majorType != MT_bytes && typeDesc.majorType != MT_string) {
         throw std::invalid_argument("CBOR data type not bytes/string");
@@ -258,7 +355,12 @@ Data Decode::getBytes() const {
         throw std::invalid_argument("CBOR bytes/string data too short");
     }
     assert(subStart + typeDesc.byteCount + len <= data->origData.size());
-    return TW::data(data->origData.data() + (subStart + typeDesc.byteCount), len); 
+    return std::string_view((const char*)data->origData.data() + (subStart + typeDesc.byteCount), len);
+}
+
+Data Decode::getBytes() const {
+    auto view = getStringView();
+    return Data(view.begin(), view.end());
 }
 
 bool Decode::isBreak() const {
@@ -289,40 +391,107 @@ uint32_t Decode::getCompoundLength(uint32_t countMultiplier) const {
     return len;
 }
 
-vector<Decode> Decode::getCompoundElements(uint32_t countMultiplier, TW::byte expectedType) const {
+Decode::Range<Decode::ArrayIterator> Decode::iterateCompound(uint32_t countMultiplier, TW::byte expectedType) const {
     TypeDesc typeDesc = getTypeDesc();
     if (typeDesc.majorType != expectedType) {
         throw std::invalid_argument("CBOR data type mismatch");
     }
-    vector<Decode> elems;
     uint32_t count = typeDesc.isIndefiniteValue ? 0 : (uint32_t)(typeDesc.value * countMultiplier);
-    // process elements
-    uint32_t idx = typeDesc.byteCount;
-    for (int i = 0; i < count || typeDesc.isIndefiniteValue; ++i) {
-        Decode nextElem = skipClone(idx);
-        if (typeDesc.isIndefiniteValue && nextElem.isBreak()) {
-            // end of indefinite-length
-            break;
-        }
-        uint32_t elemLen = nextElem.getTotalLen();
-        if (idx + elemLen > length()) {
-            throw std::invalid_argument("CBOR array data too short");
-        }
-        elems.push_back(Decode(data, subStart + idx, elemLen));
-        idx += elemLen;
+    uint32_t limit = subStart + subLen;
+    ArrayIterator first(*this, subStart + typeDesc.byteCount, limit, count, typeDesc.isIndefiniteValue);
+    ArrayIterator last(*this, limit, limit, 0, false);
+    return Range<ArrayIterator>{first, last};
+}
+
+vector<Decode> Decode::getCompoundElements(uint32_t countMultiplier, TW::byte expectedType) const {
+    vector<Decode> elems;
+    for (const auto& elem: iterateCompound(countMultiplier, expectedType)) {
+        elems.push_back(elem);
     }
     return elems;
 }
 
+Decode::Range<Decode::ArrayIterator> Decode::iterateArray() const {
+    return iterateCompound(1, MT_array);
+}
+
+Decode::Range<Decode::MapIterator> Decode::iterateMap() const {
+    auto elems = iterateCompound(2, MT_map);
+    return Range<MapIterator>{MapIterator(elems.first), MapIterator(elems.last)};
+}
+
 vector<pair<Decode, Decode>> Decode::getMapElements() const {
-    auto elems = getCompoundElements(2, MT_map);
     vector<pair<Decode, Decode>> map;
-    for (int i = 0; i < elems.size(); i += 2) {
-        map.push_back(make_pair(elems[i], elems[i + 1]));
+    for (const auto& elem: iterateMap()) {
+        map.push_back(elem);
     }
     return map;
 }
 
+Decode::ArrayIterator::ArrayIterator(const Decode& parent, uint32_t start, uint32_t limit, uint32_t count, bool indefinite)
+: current(parent.data, start, 0), limit(limit), remaining(count), indefinite(indefinite), finished(false) {
+    load();
+}
+
+void Decode::ArrayIterator::load() {
+    if (!indefinite && remaining == 0) {
+        finished = true;
+        current.subLen = 0;
+        return;
+    }
+    // element extends at most until the end of the container
+    current.subLen = limit - current.subStart;
+    if (indefinite && current.isBreak()) {
+        // end of indefinite-length
+        finished = true;
+        current.subLen = 0;
+        return;
+    }
+    uint32_t elemLen = current.getTotalLen();
+    if (current.subStart + elemLen > limit) {
+        throw std::invalid_argument("CBOR array data too short");
+    }
+    current.subLen = elemLen;
+}
+
+Decode::ArrayIterator& Decode::ArrayIterator::operator++() {
+    if (finished) {
+        return *this;
+    }
+    current.subStart += current.subLen;
+    if (!indefinite) {
+        --remaining;
+    }
+    load();
+    return *this;
+}
+
+bool Decode::ArrayIterator::operator==(const ArrayIterator& other) const {
+    if (finished || other.finished) {
+        return finished == other.finished;
+    }
+    return current.subStart == other.current.subStart;
+}
+
+Decode::MapIterator::MapIterator(const ArrayIterator& elems)
+: elems(elems), current(*elems, *elems), finished(false) {
+    load();
+}
+
+void Decode::MapIterator::load() {
+    if (elems.atEnd()) {
+        finished = true;
+        return;
+    }
+    current.first = *elems;
+    ++elems;
+    if (elems.atEnd()) {
+        throw std::invalid_argument("CBOR map value missing");
+    }
+    current.second = *elems;
+    ++elems;
+}
+
 uint64_t Decode::getTagValue() const {
     TypeDesc typeDesc = getTypeDesc();
     if (typeDesc.majorType != MT_tag) {
@@ -409,10 +578,10 @@ string Decode::dumpToStringInternal() const {
                 } else {
                     s << "[";
                 }
-                vector<Decode> elems = getArrayElements();
-                for (int i = 0; i < elems.size(); ++i) {
-                    if (i > 0) s << ", ";
-                    s << elems[i].dumpToStringInternal();
+                int i = 0;
+                for (const auto& elem: iterateArray()) {
+                    if (i++ > 0) s << ", ";
+                    s << elem.dumpToStringInternal();
                 }
                 s << "]";
             }
@@ -425,10 +594,10 @@ string Decode::dumpToStringInternal() const {
                 } else {
                     s << "{";
                 }
-                auto elems = getMapElements();
-                for (int i = 0; i < elems.size(); ++i) {
-                    if (i > 0) s << ", ";
-                    s << elems[i].first.dumpToStringInternal() << ": " << elems[i].second.dumpToStringInternal();
+                int i = 0;
+                for (const auto& elem: iterateMap()) {
+                    if (i++ > 0) s << ", ";
+                    s << elem.first.dumpToStringInternal() << ": " << elem.second.dumpToStringInternal();
                 }
                 s << "}";
             }
@@ -8,8 +8,11 @@
 
 #include "Data.h"
 
-#include <string>
+#include <iterator>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
 
 namespace TW::Cbor {
 
@@ -22,6 +25,9 @@ namespace TW::Cbor {
 /// See CborTests.cpp for usage.
 class Encode {
 public:
+    /// Empty encoder, for stateful building
+    Encode() {}
+
     /// Return encoded bytes
     TW::Data encoded() const;
 
@@ -45,26 +51,50 @@ public:
     /// Start an indefinite-length array
     static Encode indefArray();
     /// Add an element to indefinite-length array
-    Encode addIndefArrayElem(const Encode& elem);
+    Encode& addIndefArrayElem(const Encode& elem);
     /// Close an indefinite-length array
-    Encode closeIndefArray();
+    Encode& closeIndefArray();
+
+    /// Stateful building into a single buffer, without intermediate Encode objects.
+    /// Containers are started with their element count, and are closed automatically after the last element.
+    /// Start an array of count elements
+    Encode& beginArray(uint64_t count);
+    /// Start a map of count key-value pairs; keys and values are added alternately
+    Encode& beginMap(uint64_t count);
+    /// Start a tag, the next element is the tagged one
+    Encode& beginTag(uint64_t value);
+    Encode& addUint(uint64_t value);
+    Encode& addNegInt(uint64_t value);
+    Encode& addString(const std::string& str);
+    Encode& addBytes(const Data& str);
+    /// Add an already encoded element
+    Encode& addEncoded(const Encode& elem);
+    /// Reserve buffer space, to avoid reallocations
+    void reserve(size_t size) { data.reserve(size); }
+    /// Current size of the encoded data
+    size_t size() const { return data.size(); }
 
     /// Create from raw content, must be valid CBOR data, may throw
     static Encode fromRaw(const TW::Data& rawData);
 
 private:
-    Encode() {}
     Encode(const TW::Data& rawData) : data(rawData) {}
     /// Append types + value, on variable number of bytes (1..8). Return object to support chain syntax.
-    Encode appendValue(byte majorType, uint64_t value);
-    inline Encode append(const TW::Data& data) { TW::append(this->data, data); return *this; }
+    Encode& appendValue(byte majorType, uint64_t value);
+    inline Encode& append(const TW::Data& data) { TW::append(this->data, data); return *this; }
     void appendIndefinite(byte majorType);
+    /// Account for an added element in the innermost open definite-length container
+    void countElement();
+    /// Open a definite-length container expecting count elements
+    void openContainer(uint64_t count);
 
 private:
     /// Encoded data is stored here, always well-formed, but my be partial.
     TW::Data data;
     /// number of currently open indefinite buildingds (0, 1, or more for nested)
     int openIndefCount = 0;
+    /// Remaining element counts of currently open definite-length containers (innermost last)
+    std::vector<uint64_t> openCounts;
 };
 
 /// CBOR Decoder and container for data for decoding.  Contains reference to read-only CBOR data.
@@ -73,6 +103,19 @@ class Decode {
 public:
     /// Constructor, create from CBOR byte stream
     Decode(const Data& input);
+    /// Constructor, create from CBOR byte stream, taking over the data without copying
+    Decode(Data&& input);
+
+    class ArrayIterator;
+    class MapIterator;
+    /// Range of lazily parsed elements, for use in range-based for loops
+    template <typename Iterator>
+    struct Range {
+        Iterator first;
+        Iterator last;
+        Iterator begin() const { return first; }
+        Iterator end() const { return last; }
+    };
 
 public: // decoding
     /// Check if contains a valid CBOR byte stream.
@@ -81,12 +124,19 @@ public: // decoding
     uint64_t getValue() const;
     /// Get the value of a string/bytes as string
     std::string getString() const;
+    /// Get the value of a string/bytes as a view into the original data, without copying.
+    /// Valid as long as this or any other Decode derived from the same input exists.
+    std::string_view getStringView() const;
     /// Get the value of a string/bytes as Data
     TW::Data getBytes() const;
     /// Get all elements of array
     std::vector<Decode> getArrayElements() const { return getCompoundElements(1, MT_array); }
     /// Get all elements of map
     std::vector<std::pair<Decode, Decode>> getMapElements() const;
+    /// Iterate over the elements of an array, parsing them lazily; elements refer to the original data
+    Range<ArrayIterator> iterateArray() const;
+    /// Iterate over the key-value pairs of a map, parsing them lazily; elements refer to the original data
+    Range<MapIterator> iterateMap() const;
     /// Get the tag number
     uint64_t getTagValue() const;
     /// Get the tag element
@@ -112,7 +162,8 @@ private:
     /// Struct used to keep reference to original data
     struct OrigDataRef {
         Data origData;
-        OrigDataRef(const Data& o) : origData(o) {}
+        explicit OrigDataRef(const Data& o) : origData(o) {}
+        explicit OrigDataRef(Data&& o) : origData(std::move(o)) {}
     };
     Decode(const std::shared_ptr<OrigDataRef>& nData, uint32_t nSubIdx, uint32_t nSubLen);
     /// Skip ahead: form other Decode data with offset
@@ -133,6 +184,7 @@ private:
     uint32_t getTotalLen() const;
     uint32_t getCompoundLength(uint32_t countMultiplier) const;
     std::vector<Decode> getCompoundElements(uint32_t countMultiplier, TW::byte expectedType) const;
+    Range<ArrayIterator> iterateCompound(uint32_t countMultiplier, TW::byte expectedType) const;
     bool isBreak() const;
     std::string dumpToStringInternal() const;
 
@@ -144,4 +196,62 @@ private:
     uint32_t subLen;
 };
 
+/// Forward iterator over the elements of an array (or the keys and values of a map), parsed on the go.
+/// Elements share the original data, no bytes are copied.
+class Decode::ArrayIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Decode;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Decode*;
+    using reference = const Decode&;
+
+    reference operator*() const { return current; }
+    pointer operator->() const { return &current; }
+    ArrayIterator& operator++();
+    ArrayIterator operator++(int) { auto prev = *this; ++(*this); return prev; }
+    bool operator==(const ArrayIterator& other) const;
+    bool operator!=(const ArrayIterator& other) const { return !(*this == other); }
+    bool atEnd() const { return finished; }
+
+private:
+    friend class Decode;
+    /// Start iterating at absolute offset start, until limit; count is ignored for indefinite length
+    ArrayIterator(const Decode& parent, uint32_t start, uint32_t limit, uint32_t count, bool indefinite);
+    /// Parse the length of the element at the current position, or detect end
+    void load();
+
+    Decode current;
+    uint32_t limit;
+    uint32_t remaining;
+    bool indefinite;
+    bool finished;
+};
+
+/// Forward iterator over the key-value pairs of a map, parsed on the go.
+class Decode::MapIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<Decode, Decode>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    reference operator*() const { return current; }
+    pointer operator->() const { return &current; }
+    MapIterator& operator++() { load(); return *this; }
+    MapIterator operator++(int) { auto prev = *this; ++(*this); return prev; }
+    bool operator==(const MapIterator& other) const { return finished == other.finished && (finished || elems == other.elems); }
+    bool operator!=(const MapIterator& other) const { return !(*this == other); }
+
+private:
+    friend class Decode;
+    explicit MapIterator(const ArrayIterator& elems);
+    void load();
+
+    ArrayIterator elems;
+    value_type current;
+    bool finished;
+};
+
 } // namespace TW::Cbor
@@ -7,176 +7,17 @@
 #include "Coin.h"
 
 #include "CoinEntry.h"
+#include "Parallel.h"
 #include <TrustWalletCore/TWCoinTypeConfiguration.h>
 #include <TrustWalletCore/TWHRP.h>
 
 #include <map>
 
-// #coin-list# Includes for entry points for coin implementations
-#include "Aeternity/Entry.h"
-#include "Aion/Entry.h"
-#include "Algorand/Entry.h"
-#include "Bitcoin/Entry.h"
-#include "Binance/Entry.h"
-#include "Cardano/Entry.h"
-#include "Cosmos/Entry.h"
-#include "Decred/Entry.h"
-#include "Elrond/Entry.h"
-#include "EOS/Entry.h"
-#include "Ethereum/Entry.h"
-#include "Filecoin/Entry.h"
-#include "FIO/Entry.h"
-#include "Groestlcoin/Entry.h"
-#include "Harmony/Entry.h"
-#include "Icon/Entry.h"
-#include "IoTeX/Entry.h"
-#include "Kusama/Entry.h"
-#include "Nano/Entry.h"
-#include "NEAR/Entry.h"
-#include "Nebulas/Entry.h"
-#include "NEO/Entry.h"
-#include "Nimiq/Entry.h"
-#include "NULS/Entry.h"
-#include "Ontology/Entry.h"
-#include "Polkadot/Entry.h"
-#include "Ripple/Entry.h"
-#include "Solana/Entry.h"
-#include "Stellar/Entry.h"
-#include "Tezos/Entry.h"
-#include "Theta/Entry.h"
-#include "TON/Entry.h"
-#include "Tron/Entry.h"
-#include "VeChain/Entry.h"
-#include "Wanchain/Entry.h"
-#include "Waves/Entry.h"
-#include "Zcash/Entry.h"
-#include "Zilliqa/Entry.h"
-#include "Oasis/Entry.h"
-// end_of_coin_includes_marker_do_not_modify
-
 using namespace TW;
 using namespace std;
 
-// #coin-list# Global coin entry dispatcher entries
-Aeternity::Entry aeternityDP;
-Aion::Entry aionDP;
-Algorand::Entry algorandDP;
-Binance::Entry binanceDP;
-Bitcoin::Entry bitcoinDP;
-Cardano::Entry cardanoDP;
-Cosmos::Entry cosmosDP;
-Elrond::Entry elrondDP;
-EOS::Entry eosDP;
-Ethereum::Entry ethereumDP;
-Decred::Entry decredDP;
-Filecoin::Entry filecoinDP;
-FIO::Entry fioDP;
-Groestlcoin::Entry groestlcoinDP;
-Harmony::Entry harmonyDP;
-Icon::Entry iconDP;
-IoTeX::Entry iotexDP;
-Kusama::Entry kusamaDP;
-Nano::Entry nanoDP;
-NEAR::Entry nearDP;
-Nebulas::Entry nebulasDP;
-NEO::Entry neoDP;
-Nimiq::Entry nimiqDP;
-NULS::Entry nulsDP;
-Ontology::Entry ontologyDP;
-Oasis::Entry oasisDP;
-Polkadot::Entry polkadotDP;
-Ripple::Entry rippleDP;
-Solana::Entry solanaDP;
-Stellar::Entry stellarDP;
-Tezos::Entry tezosDP;
-Theta::Entry thetaDP;
-TON::Entry tonDP;
-Tron::Entry tronDP;
-VeChain::Entry vechainDP;
-Wanchain::Entry wanchainDP;
-Waves::Entry wavesDP;
-Zcash::Entry zcashDP;
-Zilliqa::Entry zilliqaDP;
-// end_of_coin_dipatcher_declarations_marker_do_not_modify
-
-CoinEntry* coinDispatcher(TWCoinType coinType) {
-    // switch is preferred instead of a data structure, due to initialization issues
-    CoinEntry* entry = nullptr;
-    switch (coinType) {
-        // #coin-list#
-        case TWCoinTypeAeternity: entry = &aeternityDP; break;
-        case TWCoinTypeAion: entry = &aionDP; break;
-        case TWCoinTypeAlgorand: entry = &algorandDP; break;
-        case TWCoinTypeBinance: entry = &binanceDP; break;
-        case TWCoinTypeBitcoin: entry = &bitcoinDP; break;
-        case TWCoinTypeBitcoinSegwit: entry = &bitcoinDP; break;
-        case TWCoinTypeBitcoinTest: entry = &bitcoinDP; break;
-        case TWCoinTypeBitcoinSegwitTest: entry = &bitcoinDP; break;
-        case TWCoinTypeBitcoinCash: entry = &bitcoinDP; break;
-        case TWCoinTypeBitcoinGold: entry = &bitcoinDP; break;
-        case TWCoinTypeDash: entry = &bitcoinDP; break;
-        case TWCoinTypeDigiByte: entry = &bitcoinDP; break;
-        case TWCoinTypeDogecoin: entry = &bitcoinDP; break;
-        case TWCoinTypeLitecoin: entry = &bitcoinDP; break;
-        case TWCoinTypeMonacoin: entry = &bitcoinDP; break;
-        case TWCoinTypeQtum: entry = &bitcoinDP; break;
-        case TWCoinTypeRavencoin: entry = &bitcoinDP; break;
-        case TWCoinTypeViacoin: entry = &bitcoinDP; break;
-        case TWCoinTypeZcoin: entry = &bitcoinDP; break;
-        case TWCoinTypeCardano: entry = &cardanoDP; break;
-        case TWCoinTypeCosmos: entry = &cosmosDP; break;
-        case TWCoinTypeKava: entry = &cosmosDP; break;
-        case TWCoinTypeTerra: entry = &cosmosDP; break;
-        case TWCoinTypeBandChain: entry = &cosmosDP; break;
-        case TWCoinTypeElrond: entry = &elrondDP; break;
-        case TWCoinTypeEOS: entry = &eosDP; break;
-        case TWCoinTypeCallisto: entry = &ethereumDP; break;
-        case TWCoinTypeEthereum: entry = &ethereumDP; break;
-        case TWCoinTypeEthereumClassic: entry = &ethereumDP; break;
-        case TWCoinTypeGoChain: entry = &ethereumDP; break;
-        case TWCoinTypePOANetwork: entry = &ethereumDP; break;
-        case TWCoinTypeThunderToken: entry = &ethereumDP; break;
-        case TWCoinTypeTomoChain: entry = &ethereumDP; break;
-        case TWCoinTypeSmartChainLegacy: entry = &ethereumDP; break;
-        case TWCoinTypeSmartChain: entry = &ethereumDP; break;
-        case TWCoinTypeDecred: entry = &decredDP; break;
-        case TWCoinTypeFilecoin: entry = &filecoinDP; break;
-        case TWCoinTypeFIO: entry = &fioDP; break;
-        case TWCoinTypeGroestlcoin: entry = &groestlcoinDP; break;
-        case TWCoinTypeHarmony: entry = &harmonyDP; break;
-        case TWCoinTypeICON: entry = &iconDP; break;
-        case TWCoinTypeIoTeX: entry = &iotexDP; break;
-        case TWCoinTypeKusama: entry = &kusamaDP; break;
-        case TWCoinTypeNano: entry = &nanoDP; break;
-        case TWCoinTypeNEAR: entry = &nearDP; break;
-        case TWCoinTypeNebulas: entry = &nebulasDP; break;
-        case TWCoinTypeNEO: entry = &neoDP; break;
-        case TWCoinTypeNimiq: entry = &nimiqDP; break;
-        case TWCoinTypeNULS: entry = &nulsDP; break;
-        case TWCoinTypeOasis: entry = &oasisDP; break;
-        case TWCoinTypeOntology: entry = &ontologyDP; break;
-        case TWCoinTypePolkadot: entry = &polkadotDP; break;
-        case TWCoinTypeXRP: entry = &rippleDP; break;
-        case TWCoinTypeSolana: entry = &solanaDP; break;
-        case TWCoinTypeStellar: entry = &stellarDP; break;
-        case TWCoinTypeKin: entry = &stellarDP; break;
-        case TWCoinTypeTezos: entry = &tezosDP; break;
-        case TWCoinTypeTheta: entry = &thetaDP; break;
-        case TWCoinTypeTON: entry = &tonDP; break;
-        case TWCoinTypeTron: entry = &tronDP; break;
-        case TWCoinTypeVeChain: entry = &vechainDP; break;
-        case TWCoinTypeWanchain: entry = &wanchainDP; break;
-        case TWCoinTypeWaves: entry = &wavesDP; break;
-        case TWCoinTypeZcash: entry = &zcashDP; break;
-        case TWCoinTypeZelcash: entry = &zcashDP; break;
-        case TWCoinTypeZilliqa: entry = &zilliqaDP; break;
-        // end_of_coin_dipatcher_switch_marker_do_not_modify
-
-        default: entry = nullptr; break;
-    }
-    assert(entry != nullptr);
-    return entry;
-}
+// Entry of a coin, dispatched by a switch generated from coins.json (src/Generated/CoinDispatcher.cpp)
+CoinEntry* coinDispatcher(TWCoinType coinType);
 
 bool TW::validateAddress(TWCoinType coin, const std::string& string) {
     auto p2pkh = TW::p2pkhPrefix(coin);
@@ -222,6 +63,42 @@ void TW::anyCoinSign(TWCoinType coinType, const Data& dataIn, Data& dataOut) {
     dispatcher->sign(coinType, dataIn, dataOut);
 }
 
+static thread_local google::protobuf::Arena* currentSigningArena = nullptr;
+
+google::protobuf::Arena* TW::signingArena() {
+    return currentSigningArena;
+}
+
+TW::ScopedSigningArena::ScopedSigningArena(google::protobuf::Arena* arena) : previous(currentSigningArena) {
+    currentSigningArena = arena;
+}
+
+TW::ScopedSigningArena::~ScopedSigningArena() {
+    currentSigningArena = previous;
+}
+
+void TW::anyCoinSignBatch(TWCoinType coinType, const std::vector<Data>& inputs, std::vector<BatchSignResult>& outputs, size_t threadCount, google::protobuf::Arena* arena) {
+    auto dispatcher = coinDispatcher(coinType);
+    assert(dispatcher != nullptr);
+    outputs.clear();
+    outputs.resize(inputs.size());
+    parallelFor(inputs.size(), [&](size_t i) {
+        // arena allocation is thread-safe, so workers can share it
+        ScopedSigningArena scopedArena(arena);
+        auto& result = outputs[i];
+        try {
+            dispatcher->sign(coinType, inputs[i], result.output);
+            result.success = true;
+        } catch (const std::exception& ex) {
+            result.output.clear();
+            result.error = ex.what();
+        } catch (...) {
+            result.output.clear();
+            result.error = "unknown error";
+        }
+    }, threadCount);
+}
+
 std::string TW::anySignJSON(TWCoinType coinType, const std::string& json, const Data& key) {
     auto dispatcher = coinDispatcher(coinType);
     assert(dispatcher != nullptr);
@@ -254,7 +131,9 @@ void TW::anyCoinPlan(TWCoinType coinType, const Data& dataIn, Data& dataOut) {
 
 // Coin info accessors
 
-extern const CoinInfo getCoinInfo(TWCoinType coin); // in generated CoinInfoData.cpp file
+// in generated CoinInfoData.cpp file
+extern const CoinInfo& getCoinInfo(TWCoinType coin);
+extern const DerivationPath& getCoinDerivationPath(TWCoinType coin);
 
 TWBlockchain TW::blockchain(TWCoinType coin) {
     return getCoinInfo(coin).blockchain;
@@ -276,8 +155,8 @@ TWHDVersion TW::xprvVersion(TWCoinType coin) {
     return getCoinInfo(coin).xprvVersion;
 }
 
-DerivationPath TW::derivationPath(TWCoinType coin) {
-    return DerivationPath(getCoinInfo(coin).derivationPath);
+const DerivationPath& TW::derivationPath(TWCoinType coin) {
+    return getCoinDerivationPath(coin);
 }
 
 enum TWPublicKeyType TW::publicKeyType(TWCoinType coin) {
@@ -300,11 +179,11 @@ enum TWHRP TW::hrp(TWCoinType coin) {
     return getCoinInfo(coin).hrp;
 }
 
-Hash::Hasher TW::publicKeyHasher(TWCoinType coin) {
+Hash::HasherSimpleType TW::publicKeyHasher(TWCoinType coin) {
     return getCoinInfo(coin).publicKeyHasher;
 }
 
-Hash::Hasher TW::base58Hasher(TWCoinType coin) {
+Hash::HasherSimpleType TW::base58Hasher(TWCoinType coin) {
     return getCoinInfo(coin).base58Hasher;
 }
 
@@ -21,6 +21,10 @@
 #include <string>
 #include <vector>
 
+namespace google::protobuf {
+class Arena;
+} // namespace google::protobuf
+
 namespace TW {
 
 // Return the set of supported coin types.
@@ -48,7 +52,7 @@ TWHDVersion xpubVersion(TWCoinType coin);
 TWHDVersion xprvVersion(TWCoinType coin);
 
 /// Returns the default derivation path for a particular coin.
-DerivationPath derivationPath(TWCoinType coin);
+const DerivationPath& derivationPath(TWCoinType coin);
 
 /// Returns the public key type for a particular coin.
 enum TWPublicKeyType publicKeyType(TWCoinType coin);
@@ -60,10 +64,10 @@ std::string deriveAddress(TWCoinType coin, const PrivateKey& privateKey);
 std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey);
 
 /// Hasher for deriving the public key hash.
-Hash::Hasher publicKeyHasher(TWCoinType coin);
+Hash::HasherSimpleType publicKeyHasher(TWCoinType coin);
 
 /// Hasher to use for base 58 checksums.
-Hash::Hasher base58Hasher(TWCoinType coin);
+Hash::HasherSimpleType base58Hasher(TWCoinType coin);
 
 /// Returns static prefix for a coin type.
 byte staticPrefix(TWCoinType coin);
@@ -80,6 +84,22 @@ enum TWHRP hrp(TWCoinType coin);
 // Note: use output parameter to avoid unneeded copies
 void anyCoinSign(TWCoinType coinType, const Data& dataIn, Data& dataOut);
 
+/// Result of one item of a batch signing
+struct BatchSignResult {
+    bool success = false;
+    /// Serialized SigningOutput, if successful
+    Data output;
+    /// Error message, if not successful
+    std::string error;
+};
+
+/// Sign several inputs of the same coin, concurrently.  Results are in the order of the inputs;
+/// an error in one input is reported in its result and does not affect the others.
+/// Uses threadCount threads, or as many as the hardware supports if 0.
+/// Protobuf messages are created on arena if given (see ScopedSigningArena), which the caller may reuse across batches;
+/// it is not reset here, so the caller must call Arena::Reset() between batches to bound its size.
+void anyCoinSignBatch(TWCoinType coinType, const std::vector<Data>& inputs, std::vector<BatchSignResult>& outputs, size_t threadCount = 0, google::protobuf::Arena* arena = nullptr);
+
 uint32_t slip44Id(TWCoinType coin);
 
 std::string anySignJSON(TWCoinType coinType, const std::string& json, const Data& key);
@@ -95,8 +115,8 @@ void anyCoinPlan(TWCoinType coinType, const Data& dataIn, Data& dataOut);
 // Return coins handled by the same dispatcher as the given coin (mostly for testing)
 const std::vector<TWCoinType> getSimilarCoinTypes(TWCoinType coinType);
 
-// Contains only simple types.
-struct CoinInfo {
+// Contains only simple types, so that the generated table can be constexpr.
+struct alignas(64) CoinInfo {
     const char* id;
     const char* name;
     TWBlockchain blockchain;
@@ -110,8 +130,8 @@ struct CoinInfo {
     byte p2pkhPrefix;
     byte p2shPrefix;
     TWHRP hrp;
-    Hash::Hasher publicKeyHasher;
-    Hash::Hasher base58Hasher;
+    Hash::HasherSimpleType publicKeyHasher;
+    Hash::HasherSimpleType base58Hasher;
     const char* symbol;
     int decimals;
     const char* explorerTransactionUrl;
@@ -12,6 +12,8 @@
 #include "PublicKey.h"
 #include "PrivateKey.h"
 
+#include <google/protobuf/arena.h>
+
 #include <string>
 #include <vector>
 
@@ -40,32 +42,81 @@ public:
     virtual void plan(TWCoinType coin, const Data& dataIn, Data& dataOut) const { return; }
 };
 
+/// Arena used for protobuf messages created while signing on the current thread, or null if none is set.
+/// Callers may supply an arena (with ScopedSigningArena) to reuse it across calls.  Signers never reset it, so the
+/// parsed input messages accumulate on it: the caller must call Arena::Reset() between calls (when no signing
+/// uses it) to bound its size.
+google::protobuf::Arena* signingArena();
+
+/// Sets the signing arena of the current thread for the lifetime of this object.
+class ScopedSigningArena {
+public:
+    explicit ScopedSigningArena(google::protobuf::Arena* arena);
+    ~ScopedSigningArena();
+    ScopedSigningArena(const ScopedSigningArena&) = delete;
+    ScopedSigningArena& operator=(const ScopedSigningArena&) = delete;
+
+private:
+    google::protobuf::Arena* previous;
+};
+
+/// Size of the stack buffer used as first arena block, when no signing arena is supplied
+static const size_t signingArenaInitialBlockSize = 4096;
+
+/// Parse a protobuf input message on the signing arena (or a temporary one, backed by a stack buffer),
+/// and pass it to fn.
+template <typename Input, typename Fn>
+void withParsedInput(const Data& dataIn, Fn&& fn) {
+    auto arena = signingArena();
+    if (arena != nullptr) {
+        auto input = google::protobuf::Arena::CreateMessage<Input>(arena);
+        input->ParseFromArray(dataIn.data(), (int)dataIn.size());
+        fn(*input);
+        return;
+    }
+    alignas(16) char initialBlock[signingArenaInitialBlockSize];
+    google::protobuf::ArenaOptions options;
+    options.initial_block = initialBlock;
+    options.initial_block_size = sizeof(initialBlock);
+    google::protobuf::Arena localArena(options);
+    auto input = google::protobuf::Arena::CreateMessage<Input>(&localArena);
+    input->ParseFromArray(dataIn.data(), (int)dataIn.size());
+    fn(*input);
+}
+
+/// Serialize a protobuf message, appending directly to dataOut
+template <typename Message>
+void appendSerialized(const Message& message, Data& dataOut) {
+    const auto size = message.ByteSizeLong();
+    const auto start = dataOut.size();
+    dataOut.resize(start + size);
+    message.SerializeWithCachedSizesToArray(dataOut.data() + start);
+}
+
 // In each coin's Entry.cpp the specific types of the coin are used, this template enforces the Signer implement:
 // static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 // Note: use output parameter to avoid unneeded copies
 template <typename Signer, typename Input>
 void signTemplate(const Data& dataIn, Data& dataOut) {
-    auto input = Input();
-    input.ParseFromArray(dataIn.data(), (int)dataIn.size());
-    auto serializedOut = Signer::sign(input).SerializeAsString();
-    dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+    withParsedInput<Input>(dataIn, [&](const Input& input) {
+        appendSerialized(Signer::sign(input), dataOut);
+    });
 }
 
 template <typename Signer, typename Input>
 void encodeTemplate(const Data& dataIn, Data& dataOut) {
-    auto input = Input();
-    input.ParseFromArray(dataIn.data(), (int)dataIn.size());
-    auto encoded = Signer::sign(input).encoded();
-    dataOut.insert(dataOut.end(), encoded.begin(), encoded.end());
+    withParsedInput<Input>(dataIn, [&](const Input& input) {
+        auto encoded = Signer::sign(input).encoded();
+        dataOut.insert(dataOut.end(), encoded.begin(), encoded.end());
+    });
 }
 
 // Note: use output parameter to avoid unneeded copies
 template <typename Planner, typename Input>
 void planTemplate(const Data& dataIn, Data& dataOut) {
-    auto input = Input();
-    input.ParseFromArray(dataIn.data(), (int)dataIn.size());
-    auto serializedOut = Planner::plan(input).SerializeAsString();
-    dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+    withParsedInput<Input>(dataIn, [&](const Input& input) {
+        appendSerialized(Planner::plan(input), dataOut);
+    });
 }
 
 } // namespace TW
@@ -9,6 +9,7 @@
 #include "../Cosmos/Address.h"
 #include "../proto/Cosmos.pb.h"
 #include "Base64.h"
+#include "JSONWriter.h"
 #include "PrivateKey.h"
 
 using namespace TW;
@@ -34,163 +35,168 @@ static string broadcastMode(Proto::BroadcastMode mode) {
     }
 }
 
-static json broadcastJSON(json& j, Proto::BroadcastMode mode) {
-    return {
-        {"tx", j},
-        {"mode", broadcastMode(mode)}
-    };
+static void amountJSON(JSONWriter& writer, const Proto::Amount& amount) {
+    writer.beginObject()
+        .field("amount", std::to_string(amount.amount()))
+        .field("denom", amount.denom())
+        .endObject();
 }
 
-static json amountJSON(const Proto::Amount& amount) {
-    return {
-        {"amount", std::to_string(amount.amount())},
-        {"denom", amount.denom()}
-    };
-}
-
-static json amountsJSON(const ::google::protobuf::RepeatedPtrField<Proto::Amount>& amounts) {
-    json j = json::array();
+static void amountsJSON(JSONWriter& writer, const ::google::protobuf::RepeatedPtrField<Proto::Amount>& amounts) {
+    writer.beginArray();
     for (auto& amount : amounts) {
-        j.push_back(amountJSON(amount));
+        amountJSON(writer, amount);
     }
-    return j;
+    writer.endArray();
 }
 
-static json feeJSON(const Proto::Fee& fee) {
-    json js = json::array();
-
-    for (auto& amount : fee.amounts()) {
-        js.push_back(amountJSON(amount));
-    }
-
-    return {
-        {"amount", js},
-        {"gas", std::to_string(fee.gas())}
-    };
+static void feeJSON(JSONWriter& writer, const Proto::Fee& fee) {
+    writer.beginObject().key("amount");
+    amountsJSON(writer, fee.amounts());
+    writer.field("gas", std::to_string(fee.gas()))
+        .endObject();
 }
 
-static json messageSend(const Proto::Message_Send& message) {
+static void messageSend(JSONWriter& writer, const Proto::Message_Send& message) {
     auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_SEND : message.type_prefix();
 
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountsJSON(message.amounts())},
-            {"from_address", message.from_address()},
-            {"to_address", message.to_address()}
-        }}
-    };
+    writer.beginObject()
+        .field("type", typePrefix)
+        .key("value").beginObject()
+            .key("amount");
+    amountsJSON(writer, message.amounts());
+    writer.field("from_address", message.from_address())
+            .field("to_address", message.to_address())
+        .endObject()
+    .endObject();
 }
 
-static json messageDelegate(const Proto::Message_Delegate& message) {
+static void messageDelegate(JSONWriter& writer, const Proto::Message_Delegate& message) {
     auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_DELEGATE : message.type_prefix();
 
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountJSON(message.amount())},
-            {"delegator_address", message.delegator_address()},
-            {"validator_address", message.validator_address()}
-        }}
-    };
+    writer.beginObject()
+        .field("type", typePrefix)
+        .key("value").beginObject()
+            .key("amount");
+    amountJSON(writer, message.amount());
+    writer.field("delegator_address", message.delegator_address())
+            .field("validator_address", message.validator_address())
+        .endObject()
+    .endObject();
 }
 
-static json messageUndelegate(const Proto::Message_Undelegate& message) {
+static void messageUndelegate(JSONWriter& writer, const Proto::Message_Undelegate& message) {
     auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_UNDELEGATE : message.type_prefix();
 
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountJSON(message.amount())},
-            {"delegator_address", message.delegator_address()},
-            {"validator_address", message.validator_address()}
-        }}
-    };
+    writer.beginObject()
+        .field("type", typePrefix)
+        .key("value").beginObject()
+            .key("amount");
+    amountJSON(writer, message.amount());
+    writer.field("delegator_address", message.delegator_address())
+            .field("validator_address", message.validator_address())
+        .endObject()
+    .endObject();
 }
 
-static json messageRedelegate(const Proto::Message_BeginRedelegate& message) {
+static void messageRedelegate(JSONWriter& writer, const Proto::Message_BeginRedelegate& message) {
     auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_REDELEGATE : message.type_prefix();
 
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountJSON(message.amount())},
-            {"delegator_address", message.delegator_address()},
-            {"validator_src_address", message.validator_src_address()},
-            {"validator_dst_address", message.validator_dst_address()},
-        }}
-    };
+    writer.beginObject()
+        .field("type", typePrefix)
+        .key("value").beginObject()
+            .key("amount");
+    amountJSON(writer, message.amount());
+    writer.field("delegator_address", message.delegator_address())
+            .field("validator_dst_address", message.validator_dst_address())
+            .field("validator_src_address", message.validator_src_address())
+        .endObject()
+    .endObject();
 }
 
-static json messageWithdrawReward(const Proto::Message_WithdrawDelegationReward& message) {
+static void messageWithdrawReward(JSONWriter& writer, const Proto::Message_WithdrawDelegationReward& message) {
     auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_WITHDRAW_REWARD : message.type_prefix();
 
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"delegator_address", message.delegator_address()},
-            {"validator_address", message.validator_address()}
-        }}
-    };
+    writer.beginObject()
+        .field("type", typePrefix)
+        .key("value").beginObject()
+            .field("delegator_address", message.delegator_address())
+            .field("validator_address", message.validator_address())
+        .endObject()
+    .endObject();
 }
 
-static json messageRawJSON(const Proto::Message_RawJSON& message) {
-    return {
-        {"type", message.type()},
-        {"value", json::parse(message.value())},
-    };
+static void messageRawJSON(JSONWriter& writer, const Proto::Message_RawJSON& message) {
+    // arbitrary content, normalized through a parsed tree
+    writer.beginObject()
+        .field("type", message.type())
+        .key("value").raw(json::parse(message.value()).dump())
+    .endObject();
 }
-static json messagesJSON(const Proto::SigningInput& input) {
-    json j = json::array();
+
+static void messagesJSON(JSONWriter& writer, const Proto::SigningInput& input) {
+    writer.beginArray();
     for (auto& msg : input.messages()) {
         if (msg.has_send_coins_message()) {
-            j.push_back(messageSend(msg.send_coins_message()));
+            messageSend(writer, msg.send_coins_message());
         } else if (msg.has_stake_message()) {
-            j.push_back(messageDelegate(msg.stake_message()));
+            messageDelegate(writer, msg.stake_message());
         } else if (msg.has_unstake_message()) {
-            j.push_back(messageUndelegate(msg.unstake_message()));
+            messageUndelegate(writer, msg.unstake_message());
         } else if (msg.has_withdraw_stake_reward_message()) {
-            j.push_back(messageWithdrawReward(msg.withdraw_stake_reward_message()));
+            messageWithdrawReward(writer, msg.withdraw_stake_reward_message());
         } else if (msg.has_restake_message()) {
-            j.push_back(messageRedelegate(msg.restake_message()));
+            messageRedelegate(writer, msg.restake_message());
         } else if (msg.has_raw_json_message()) {
-            j.push_back(messageRawJSON(msg.raw_json_message()));
+            messageRawJSON(writer, msg.raw_json_message());
         }
     }
-    return j;
+    writer.endArray();
 }
 
-static json signatureJSON(const Data& signature, const Data& pubkey) {
-    return {
-        {"pub_key", {
-            {"type", TYPE_PREFIX_PUBLIC_KEY},
-            {"value", Base64::encode(pubkey)}
-        }},
-        {"signature", Base64::encode(signature)}
-    };
+static void signatureJSON(JSONWriter& writer, const Data& signature, const Data& pubkey) {
+    writer.beginObject()
+        .key("pub_key").beginObject()
+            .field("type", TYPE_PREFIX_PUBLIC_KEY)
+            .field("value", Base64::encode(pubkey))
+        .endObject()
+        .field("signature", Base64::encode(signature))
+    .endObject();
 }
 
-json Cosmos::signaturePreimage(const Proto::SigningInput& input) {
-    return {
-        {"account_number", std::to_string(input.account_number())},
-        {"chain_id", input.chain_id()},
-        {"fee", feeJSON(input.fee())},
-        {"memo", input.memo()},
-        {"msgs", messagesJSON(input)},
-        {"sequence", std::to_string(input.sequence())}
-    };
+string Cosmos::signaturePreimage(const Proto::SigningInput& input) {
+    JSONWriter writer;
+    writer.reserve(512);
+    writer.beginObject()
+        .field("account_number", std::to_string(input.account_number()))
+        .field("chain_id", input.chain_id())
+        .key("fee");
+    feeJSON(writer, input.fee());
+    writer.field("memo", input.memo())
+        .key("msgs");
+    messagesJSON(writer, input);
+    writer.field("sequence", std::to_string(input.sequence()))
+        .endObject();
+    return writer.release();
 }
 
-json Cosmos::transactionJSON(const Proto::SigningInput& input, const Data& signature) {
+string Cosmos::transactionJSON(const Proto::SigningInput& input, const Data& signature) {
     auto privateKey = PrivateKey(input.private_key());
     auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1);
-    json tx = {
-        {"fee", feeJSON(input.fee())},
-        {"memo", input.memo()},
-        {"msg", messagesJSON(input)},
-        {"signatures", json::array({
-            signatureJSON(signature, Data(publicKey.bytes))
-        })}
-    };
-    return broadcastJSON(tx, input.mode());
+    JSONWriter writer;
+    writer.reserve(768);
+    writer.beginObject()
+        .field("mode", broadcastMode(input.mode()))
+        .key("tx").beginObject()
+            .key("fee");
+    feeJSON(writer, input.fee());
+    writer.field("memo", input.memo())
+            .key("msg");
+    messagesJSON(writer, input);
+    writer.key("signatures").beginArray();
+    signatureJSON(writer, signature, Data(publicKey.bytes));
+    writer.endArray()
+        .endObject()
+    .endObject();
+    return writer.release();
 }
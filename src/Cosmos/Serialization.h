@@ -22,7 +22,9 @@ extern const string TYPE_PREFIX_PUBLIC_KEY;
 
 namespace TW::Cosmos {
 
-json signaturePreimage(const Proto::SigningInput& input);
-json transactionJSON(const Proto::SigningInput& input, const Data& signature);
+/// Canonical JSON document to sign.
+string signaturePreimage(const Proto::SigningInput& input);
+/// Canonical JSON of the signed transaction, for broadcasting.
+string transactionJSON(const Proto::SigningInput& input, const Data& signature);
 
 } // namespace
@@ -18,14 +18,14 @@ using namespace TW::Cosmos;
 
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto key = PrivateKey(input.private_key());
-    auto preimage = signaturePreimage(input).dump();
+    auto preimage = signaturePreimage(input);
     auto hash = Hash::sha256(preimage);
     auto signedHash = key.sign(hash, TWCurveSECP256k1);
 
     auto output = Proto::SigningOutput();
     auto signature = Data(signedHash.begin(), signedHash.end() - 1);
     auto txJson = transactionJSON(input, signature);
-    output.set_json(txJson.dump());
+    output.set_json(txJson);
     output.set_signature(signature.data(), signature.size());
     return output;
 }
@@ -56,6 +56,7 @@ Result<Transaction, TW::Bitcoin::Error> Signer::sign() {
     std::copy(std::begin(transaction.inputs), std::end(transaction.inputs),
               std::back_inserter(signedInputs));
 
+    prefixHashCache = transaction.computePrefixHashCache();
     const auto hashSingle = Bitcoin::hashTypeIsSingle(static_cast<enum TWBitcoinSigHashType>(input.hash_type()));
     for (auto i = 0; i < txPlan.utxos.size(); i += 1) {
         auto& utxo = txPlan.utxos[i];
@@ -67,10 +68,12 @@ Result<Transaction, TW::Bitcoin::Error> Signer::sign() {
         auto script = Bitcoin::Script(utxo.script().begin(), utxo.script().end());
         auto result = sign(script, i);
         if (!result) {
+            prefixHashCache.reset();
             return Result<Transaction, TW::Bitcoin::Error>::failure(result.error());
         }
         signedInputs[i].script = result.payload();
     }
+    prefixHashCache.reset();
 
     Transaction tx(transaction);
     tx.inputs = move(signedInputs);
@@ -108,9 +111,8 @@ Result<Bitcoin::Script, TW::Bitcoin::Error> Signer::sign(Bitcoin::Script script,
 }
 
 Result<std::vector<Data>, TW::Bitcoin::Error> Signer::signStep(Bitcoin::Script script, size_t index) {
-    Transaction transactionToSign(transaction);
-    transactionToSign.inputs = signedInputs;
-    transactionToSign.outputs = transaction.outputs;
+    // the scripts of other inputs are not part of the signature hash
+    const auto& transactionToSign = transaction;
 
     Data data;
     std::vector<Data> keys;
@@ -179,7 +181,8 @@ Result<std::vector<Data>, TW::Bitcoin::Error> Signer::signStep(Bitcoin::Script s
 
 Data Signer::createSignature(const Transaction& transaction, const Bitcoin::Script& script,
                              const Data& key, size_t index) {
-    auto sighash = transaction.computeSignatureHash(script, index, static_cast<TWBitcoinSigHashType>(input.hash_type()));
+    auto sighash = transaction.computeSignatureHash(script, index, static_cast<TWBitcoinSigHashType>(input.hash_type()),
+                                                    prefixHashCache ? &*prefixHashCache : nullptr);
     auto pk = PrivateKey(key);
     auto signature = pk.signAsDER(Data(begin(sighash), end(sighash)), TWCurveSECP256k1);
     if (script.empty()) {
@@ -20,6 +20,7 @@
 #include "../proto/Decred.pb.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -48,6 +49,9 @@ class Signer {
     /// List of signed inputs.
     std::vector<TransactionInput> signedInputs;
 
+    /// Prefix hash shared by the signature hashes of all inputs, set while `sign` signs the inputs of `transaction`.
+    std::optional<Data> prefixHashCache;
+
   public:
     /// Initializes a transaction signer.
     Signer() = default;
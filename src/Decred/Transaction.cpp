@@ -29,7 +29,7 @@ std::size_t sigHashWitnessSize(const std::vector<TransactionInput>& inputs,
 } // namespace
 
 Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, size_t index,
-                                       enum TWBitcoinSigHashType hashType) const {
+                                       enum TWBitcoinSigHashType hashType, const Data* prefixHashCache) const {
     assert(index < inputs.size());
 
     if (Bitcoin::hashTypeIsSingle(hashType) && index >= outputs.size()) {
@@ -37,34 +37,41 @@ Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, siz
                                     "larger than the number of outputs");
     }
 
-    auto inputsToSign = inputs;
+    // only the input being signed with AnyoneCanPay
+    std::vector<TransactionInput> inputToSign;
     auto signIndex = index;
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0) {
-        inputsToSign = {inputs[index]};
+        inputToSign = {inputs[index]};
         signIndex = 0;
     }
+    const auto& inputsToSign = inputToSign.empty() ? inputs : inputToSign;
 
-    auto outputsToSign = outputs;
+    std::vector<TransactionOutput> selectedOutputs;
+    auto allOutputs = false;
     switch (hashType & Bitcoin::SigHashMask) {
     case TWBitcoinSigHashTypeNone:
-        outputsToSign = {};
         break;
     case TWBitcoinSigHashTypeSingle:
-        outputsToSign.clear();
-        std::copy(outputs.begin(), outputs.begin() + index + 1, outputsToSign.end());
+        selectedOutputs.assign(outputs.begin(), outputs.begin() + index + 1);
         break;
     default:
         // Keep all outputs
+        allOutputs = true;
         break;
     }
+    const auto& outputsToSign = allOutputs ? outputs : selectedOutputs;
 
     auto preimage = Data();
     preimage.reserve(Hash::sha256Size * 2 + 4);
     encode32LE(hashType, preimage);
 
-    const auto prefixHash =
-        computePrefixHash(inputsToSign, outputsToSign, signIndex, index, hashType);
-    std::copy(prefixHash.begin(), prefixHash.end(), std::back_inserter(preimage));
+    if (prefixHashCache != nullptr && allOutputs && inputToSign.empty()) {
+        std::copy(prefixHashCache->begin(), prefixHashCache->end(), std::back_inserter(preimage));
+    } else {
+        const auto prefixHash =
+            computePrefixHash(inputsToSign, outputsToSign, signIndex, index, hashType);
+        std::copy(prefixHash.begin(), prefixHash.end(), std::back_inserter(preimage));
+    }
 
     const auto witnessHash = computeWitnessHash(inputsToSign, prevOutScript, signIndex);
     std::copy(witnessHash.begin(), witnessHash.end(), std::back_inserter(preimage));
@@ -72,11 +79,17 @@ Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, siz
     return Hash::blake256(preimage);
 }
 
+Data Transaction::computePrefixHashCache() const {
+    // the signed input's index only matters for SigHashSingle and SigHashNone
+    return computePrefixHash(inputs, outputs, 0, 0, TWBitcoinSigHashTypeAll);
+}
+
 Data Transaction::computePrefixHash(const std::vector<TransactionInput>& inputsToSign,
                                     const std::vector<TransactionOutput>& outputsToSign,
                                     std::size_t signIndex, std::size_t index,
                                     enum TWBitcoinSigHashType hashType) const {
     auto preimage = Data{};
+    preimage.reserve(4 + 9 + inputsToSign.size() * (32 + 4 + 1 + 4) + 9 + outputsToSign.size() * 64 + 8);
 
     // Commit to the version and hash serialization type.
     encode32LE(static_cast<uint32_t>(version) |
@@ -49,8 +49,14 @@ struct Transaction {
     bool empty() const { return inputs.empty() && outputs.empty(); }
 
     /// Generates the signature pre-image.
+    ///
+    /// prefixHashCache, if given, must come from `computePrefixHashCache` with the current inputs and outputs; it is
+    /// used for `TWBitcoinSigHashTypeAll` instead of rehashing all of them for each input.
     Data computeSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
-                              enum TWBitcoinSigHashType hashType) const;
+                              enum TWBitcoinSigHashType hashType, const Data* prefixHashCache = nullptr) const;
+
+    /// Computes the prefix hash shared by the signature hashes of all inputs, for signing many inputs.
+    Data computePrefixHashCache() const;
 
     /// Generates the transaction hash.
     Data hash() const;
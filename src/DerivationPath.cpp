@@ -6,12 +6,15 @@
 
 #include "DerivationPath.h"
 
-#include <cstdio>
+#include <charconv>
 #include <stdexcept>
 
 using namespace TW;
 
-DerivationPath::DerivationPath(const std::string& string) {
+namespace {
+
+/// Parses a derivation path into path, returns an error message, or nullptr on success.
+const char* parsePath(std::string_view string, DerivationPath& path) noexcept {
     auto it = string.data();
     const auto end = string.data() + string.size();
 
@@ -22,39 +25,85 @@ DerivationPath::DerivationPath(const std::string& string) {
         ++it;
     }
 
+    path.indices.clear();
     while (it != end) {
         uint32_t value;
-        if (std::sscanf(it, "%ud", &value) != 1) {
-            throw std::invalid_argument("Invalid component");
-        }
-        while (it != end && isdigit(*it)) {
-            ++it;
+        const auto result = std::from_chars(it, end, value);
+        if (result.ec != std::errc()) {
+            return "Invalid component";
         }
+        it = result.ptr;
 
         auto hardened = (it != end && *it == '\'');
         if (hardened) {
             ++it;
         }
-        indices.emplace_back(value, hardened);
+        if (path.indices.size() == DerivationPathIndices::maxSize) {
+            return "Too many components";
+        }
+        path.indices.push_back(DerivationPathIndex(value, hardened));
 
         if (it == end) {
             break;
         }
         if (*it != '/') {
-            throw std::invalid_argument("Components should be separated by '/'");
+            return "Components should be separated by '/'";
         }
         ++it;
     }
+    return nullptr;
 }
 
-std::string DerivationPath::string() const noexcept {
-    std::string result = "m/";
-    for (auto& index : indices) {
-        result += index.string();
-        result += "/";
+} // namespace
+
+size_t DerivationPathIndex::string(char* buffer) const noexcept {
+    auto end = std::to_chars(buffer, buffer + maxStringLength, value).ptr;
+    if (hardened) {
+        *end++ = '\'';
     }
-    if (result.back() == '/') {
-        result.erase(result.end() - 1);
+    return end - buffer;
+}
+
+DerivationPath::DerivationPath(std::string_view string) {
+    if (const auto error = parsePath(string, *this)) {
+        throw std::invalid_argument(error);
+    }
+}
+
+bool DerivationPath::parse(std::string_view string, DerivationPath& path) noexcept {
+    DerivationPath parsed;
+    if (parsePath(string, parsed) != nullptr) {
+        return false;
+    }
+    path = parsed;
+    return true;
+}
+
+size_t DerivationPath::string(char* buffer) const noexcept {
+    auto it = buffer;
+    *it++ = 'm';
+    for (const auto& index : indices) {
+        *it++ = '/';
+        it += index.string(it);
+    }
+    return it - buffer;
+}
+
+std::string DerivationPath::string() const noexcept {
+    char buffer[maxStringLength];
+    return std::string(buffer, string(buffer));
+}
+
+size_t DerivationPath::hash() const noexcept {
+    // FNV-1a over the derivation indices
+    uint64_t hash = 0xcbf29ce484222325;
+    for (const auto& index : indices) {
+        auto value = index.derivationIndex();
+        for (int i = 0; i < 4; ++i) {
+            hash ^= value & 0xFF;
+            hash *= 0x100000001b3;
+            value >>= 8;
+        }
     }
-    return result;
+    return static_cast<size_t>(hash);
 }
@@ -9,9 +9,15 @@
 #include <TrustWalletCore/TWCoinType.h>
 #include <TrustWalletCore/TWPurpose.h>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <initializer_list>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace TW {
@@ -20,11 +26,14 @@ struct DerivationPathIndex {
     uint32_t value = 0;
     bool hardened = true;
 
-    DerivationPathIndex() = default;
-    DerivationPathIndex(uint32_t value, bool hardened = true) : value(value), hardened(hardened) {}
+    /// Maximum length of the string representation.
+    static constexpr size_t maxStringLength = 11;
+
+    constexpr DerivationPathIndex() = default;
+    constexpr DerivationPathIndex(uint32_t value, bool hardened = true) : value(value), hardened(hardened) {}
 
     /// The derivation index.
-    uint32_t derivationIndex() const {
+    constexpr uint32_t derivationIndex() const {
         if (hardened) {
             return value | 0x80000000;
         } else {
@@ -32,18 +41,109 @@ struct DerivationPathIndex {
         }
     }
 
+    /// Writes the string representation into buffer (at least `maxStringLength` characters, not null-terminated),
+    /// returns its length.
+    size_t string(char* buffer) const noexcept;
+
     std::string string() const {
-        if (hardened) {
-            return std::to_string(value) + "'";
-        } else {
-            return std::to_string(value);
+        char buffer[maxStringLength];
+        return std::string(buffer, string(buffer));
+    }
+};
+
+/// Indices of a derivation path, stored inline up to a fixed depth, so that paths are copied and built without heap
+/// allocation.  Provides the subset of the `std::vector` interface used for paths.
+class DerivationPathIndices {
+public:
+    using value_type = DerivationPathIndex;
+    using iterator = DerivationPathIndex*;
+    using const_iterator = const DerivationPathIndex*;
+
+    /// Maximum depth of a derivation path.
+    static constexpr size_t maxSize = 10;
+
+    constexpr DerivationPathIndices() = default;
+
+    constexpr DerivationPathIndices(std::initializer_list<DerivationPathIndex> list) {
+        for (const auto& index : list) {
+            push_back(index);
+        }
+    }
+
+    DerivationPathIndices(const std::vector<DerivationPathIndex>& vector) {
+        for (const auto& index : vector) {
+            push_back(index);
+        }
+    }
+
+    /// Creates count default indices.
+    explicit DerivationPathIndices(size_t count) {
+        checkSize(count);
+        length = count;
+    }
+
+    constexpr size_t size() const { return length; }
+    constexpr bool empty() const { return length == 0; }
+
+    constexpr DerivationPathIndex& operator[](size_t i) { return items[i]; }
+    constexpr const DerivationPathIndex& operator[](size_t i) const { return items[i]; }
+
+    DerivationPathIndex* data() { return items.data(); }
+    const DerivationPathIndex* data() const { return items.data(); }
+
+    iterator begin() { return items.data(); }
+    iterator end() { return items.data() + length; }
+    const_iterator begin() const { return items.data(); }
+    const_iterator end() const { return items.data() + length; }
+
+    DerivationPathIndex& front() { return items[0]; }
+    const DerivationPathIndex& front() const { return items[0]; }
+    DerivationPathIndex& back() { return items[length - 1]; }
+    const DerivationPathIndex& back() const { return items[length - 1]; }
+
+    /// @throws std::length_error if the path is already at maximum depth.
+    constexpr void push_back(const DerivationPathIndex& index) {
+        checkSize(length + 1);
+        items[length++] = index;
+    }
+
+    /// @throws std::length_error if the path is already at maximum depth.
+    template <typename... Args>
+    DerivationPathIndex& emplace_back(Args&&... args) {
+        push_back(DerivationPathIndex(std::forward<Args>(args)...));
+        return back();
+    }
+
+    void pop_back() { --length; }
+
+    /// Keeps the first count indices, or adds default indices up to count.
+    void resize(size_t count) {
+        checkSize(count);
+        for (size_t i = length; i < count; ++i) {
+            items[i] = DerivationPathIndex();
+        }
+        length = count;
+    }
+
+    void clear() { length = 0; }
+
+private:
+    static constexpr void checkSize(size_t size) {
+        if (size > maxSize) {
+            throw std::length_error("Derivation path too deep");
         }
     }
+
+    std::array<DerivationPathIndex, maxSize> items{};
+    size_t length = 0;
 };
 
 /// A BIP32 HD wallet derivation path.
 struct DerivationPath {
-    std::vector<DerivationPathIndex> indices;
+    DerivationPathIndices indices;
+
+    /// Maximum length of the string representation.
+    static constexpr size_t maxStringLength = 1 + DerivationPathIndices::maxSize * (1 + DerivationPathIndex::maxStringLength);
 
     TWPurpose purpose() const {
         if (indices.size() == 0) { return TWPurposeBIP44; }
@@ -95,14 +195,14 @@ struct DerivationPath {
         indices[4] = DerivationPathIndex(v, /* hardened: */ false);
     }
 
-    DerivationPath() = default;
-    explicit DerivationPath(std::initializer_list<DerivationPathIndex> l) : indices(l) {}
-    explicit DerivationPath(std::vector<DerivationPathIndex> indices) : indices(std::move(indices)) {}
+    constexpr DerivationPath() = default;
+    constexpr explicit DerivationPath(std::initializer_list<DerivationPathIndex> l) : indices(l) {}
+    explicit DerivationPath(const std::vector<DerivationPathIndex>& indices) : indices(indices) {}
 
     /// Creates a `DerivationPath` by BIP44 components.
     DerivationPath(TWPurpose purpose, uint32_t coin, uint32_t account, uint32_t change,
-                   uint32_t address) 
-    : indices(std::vector<DerivationPathIndex>(5)) {
+                   uint32_t address)
+    : indices(5) {
         setPurpose(purpose);
         setCoin(coin);
         setAccount(account);
@@ -113,11 +213,37 @@ struct DerivationPath {
     /// Creates a derivation path with a string description like `m/10/0/2'/3`
     ///
     /// @throws std::invalid_argument if the string is not a valid derivation
-    /// path.
-    explicit DerivationPath(const std::string& string);
+    /// path, or is deeper than `DerivationPathIndices::maxSize`.
+    explicit DerivationPath(std::string_view string);
+
+    /// Parses a derivation path string like the string constructor, without throwing.
+    ///
+    /// @returns false, leaving path unchanged, if the string is not a valid derivation path.
+    static bool parse(std::string_view string, DerivationPath& path) noexcept;
+
+    /// Writes the string representation into buffer (at least `maxStringLength` characters, not null-terminated),
+    /// returns its length.
+    size_t string(char* buffer) const noexcept;
 
     /// String representation.
     std::string string() const noexcept;
+
+    /// Returns the path made of the first count indices (all if count is larger than the depth).
+    DerivationPath prefix(size_t count) const {
+        DerivationPath path;
+        path.indices.resize(std::min(count, indices.size()));
+        std::copy(indices.begin(), indices.begin() + path.indices.size(), path.indices.begin());
+        return path;
+    }
+
+    /// Whether the first indices of this path are those of other.
+    bool startsWith(const DerivationPath& other) const {
+        return other.indices.size() <= indices.size() &&
+               std::equal(other.indices.begin(), other.indices.end(), indices.begin());
+    }
+
+    /// Hash of the indices, for use as a cache key.
+    size_t hash() const noexcept;
 };
 
 inline bool operator==(const DerivationPathIndex& lhs, const DerivationPathIndex& rhs) {
@@ -129,4 +255,18 @@ inline bool operator==(const DerivationPath& lhs, const DerivationPath& rhs) {
                       rhs.indices.end());
 }
 
+inline bool operator!=(const DerivationPath& lhs, const DerivationPath& rhs) {
+    return !(lhs == rhs);
+}
+
 } // namespace TW
+
+namespace std {
+
+/// Hash of a derivation path, for use in unordered containers.
+template <>
+struct hash<TW::DerivationPath> {
+    size_t operator()(const TW::DerivationPath& path) const noexcept { return path.hash(); }
+};
+
+} // namespace std
@@ -7,6 +7,7 @@
 #include "Address.h"
 
 #include "../Base58.h"
+#include "../Parallel.h"
 #include <TrezorCrypto/ecdsa.h>
 
 #include <cassert>
@@ -33,6 +34,14 @@ bool Address::isValid(const std::string& string, const std::vector<byte>& validP
     return true;
 }
 
+std::vector<bool> Address::isValid(const std::vector<std::string>& strings, const std::vector<byte>& validPrefixes,
+                                   size_t threadCount) {
+    // std::vector<bool> packs bits, so concurrent writes go to whole bytes first
+    std::vector<uint8_t> valid(strings.size());
+    parallelFor(strings.size(), [&](size_t i) { valid[i] = isValid(strings[i], validPrefixes); }, threadCount);
+    return std::vector<bool>(valid.begin(), valid.end());
+}
+
 Address::Address(const std::string& string) {
     const auto decoded = Base58::bitcoin.decodeCheck(string, Hash::groestl512d);
     if (decoded.size() != Address::size) {
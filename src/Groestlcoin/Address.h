@@ -11,6 +11,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 namespace TW::Groestlcoin {
 
@@ -36,6 +37,13 @@ class Address {
     /// within the valid set.
     static bool isValid(const std::string& string, const std::vector<byte>& validPrefixes);
 
+    /// Validates a batch of address strings like `isValid(string, validPrefixes)`, with the Groestl checksums
+    /// computed over threadCount worker threads (the hardware concurrency if 0).
+    ///
+    /// @returns whether each string is a valid address, in order.
+    static std::vector<bool> isValid(const std::vector<std::string>& strings, const std::vector<byte>& validPrefixes,
+                                     size_t threadCount = 0);
+
     /// Initializes a  address with a string representation.
     explicit Address(const std::string& string);
 
@@ -11,13 +11,18 @@
 #include "Bitcoin/SegwitAddress.h"
 #include "Bitcoin/CashAddress.h"
 #include "Coin.h"
+#include "Parallel.h"
 
 #include <TrezorCrypto/bip32.h>
 #include <TrezorCrypto/bip39.h>
 #include <TrezorCrypto/curves.h>
+#include <TrezorCrypto/ed25519.h>
+#include <TrezorCrypto/memzero.h>
 #include <TrustWalletCore/TWHRP.h>
 
+#include <algorithm>
 #include <array>
+#include <map>
 
 using namespace TW;
 
@@ -28,6 +33,9 @@ std::string serialize(const HDNode *node, uint32_t fingerprint, uint32_t version
 bool deserialize(const std::string& extended, TWCurve curve, Hash::Hasher hasher, HDNode *node);
 HDNode getNode(const HDWallet& wallet, TWCurve curve, const DerivationPath& derivationPath);
 HDNode getMasterNode(const HDWallet& wallet, TWCurve curve);
+void deriveChild(HDNode& node, TWCurve curve, uint32_t index);
+PrivateKey getNodePrivateKey(const HDNode& node, TWCurve curve);
+std::string getNodeExtendedPublicKey(HDNode node, TWCoinType coin, TWHDVersion version);
 
 const char* curveName(TWCurve curve);
 } // namespace
@@ -89,30 +97,62 @@ PrivateKey HDWallet::getMasterKeyExtension(TWCurve curve) const {
 
 PrivateKey HDWallet::getKey(TWCoinType coin, const DerivationPath& derivationPath) const {
     const auto curve = TWCoinTypeCurve(coin);
-    const auto privateKeyType = getPrivateKeyType(curve);
     auto node = getNode(*this, curve, derivationPath);
-    switch (privateKeyType) {
-        case PrivateKeyTypeExtended96:
-            {
-                auto pkData = Data(node.private_key, node.private_key + PrivateKey::size);
-                auto extData = Data(node.private_key_extension, node.private_key_extension + PrivateKey::size);
-                auto chainCode = Data(node.chain_code, node.chain_code + PrivateKey::size);
-                return PrivateKey(pkData, extData, chainCode);
-            }
-
-        case PrivateKeyTypeDefault32:
-        default:
-            // default path
-            auto data = Data(node.private_key, node.private_key + PrivateKey::size);
-            return PrivateKey(data);
-    }
+    return getNodePrivateKey(node, curve);
 }
 
 std::string HDWallet::deriveAddress(TWCoinType coin) const {
-    const auto derivationPath = TW::derivationPath(coin);
+    const auto& derivationPath = TW::derivationPath(coin);
     return TW::deriveAddress(coin, getKey(coin, derivationPath));
 }
 
+std::vector<std::string> HDWallet::deriveAddresses(TWCoinType coin, const std::vector<DerivationPath>& paths,
+                                                   size_t threadCount) const {
+    const auto curve = TWCoinTypeCurve(coin);
+    const auto publicKeyType = TW::publicKeyType(coin);
+
+    // node at the longest common prefix of the paths
+    size_t prefixSize = paths.empty() ? 0 : paths[0].indices.size();
+    for (const auto& path : paths) {
+        const auto& first = paths[0].indices;
+        const auto mismatch = std::mismatch(first.begin(), first.begin() + std::min(prefixSize, path.indices.size()),
+                                            path.indices.begin(),
+                                            [](const DerivationPathIndex& lhs, const DerivationPathIndex& rhs) {
+                                                return lhs.derivationIndex() == rhs.derivationIndex();
+                                            });
+        prefixSize = mismatch.first - first.begin();
+    }
+    auto prefixNode = getMasterNode(*this, curve);
+    for (size_t index = 0; index < prefixSize; ++index) {
+        deriveChild(prefixNode, curve, paths[0].indices[index].derivationIndex());
+    }
+
+    // paths are handled in chunks, so that their public keys are derived together
+    const size_t chunkSize = ED25519_PUBLICKEY_BATCH_SIZE;
+    const auto chunkCount = (paths.size() + chunkSize - 1) / chunkSize;
+    std::vector<std::string> addresses(paths.size());
+    parallelFor(chunkCount, [&](size_t chunk) {
+        const auto begin = chunk * chunkSize;
+        const auto end = std::min(begin + chunkSize, paths.size());
+        std::vector<PrivateKey> privateKeys;
+        privateKeys.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            auto node = prefixNode;
+            for (size_t index = prefixSize; index < paths[i].indices.size(); ++index) {
+                deriveChild(node, curve, paths[i].indices[index].derivationIndex());
+            }
+            privateKeys.push_back(getNodePrivateKey(node, curve));
+            memzero(&node, sizeof(node));
+        }
+        const auto publicKeys = PrivateKey::getPublicKeys(privateKeys, publicKeyType);
+        for (size_t i = begin; i < end; ++i) {
+            addresses[i] = TW::deriveAddress(coin, publicKeys[i - begin]);
+        }
+    }, threadCount);
+    memzero(&prefixNode, sizeof(prefixNode));
+    return addresses;
+}
+
 std::string HDWallet::getExtendedPrivateKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version) const {
     if (version == TWHDVersionNone) {
         return "";
@@ -132,12 +172,55 @@ std::string HDWallet::getExtendedPublicKey(TWPurpose purpose, TWCoinType coin, T
     }
     
     const auto curve = TWCoinTypeCurve(coin);
-    auto derivationPath = TW::DerivationPath({DerivationPathIndex(purpose, true), DerivationPathIndex(coin, true)});
+    auto derivationPath = TW::DerivationPath({DerivationPathIndex(purpose, true)});
     auto node = getNode(*this, curve, derivationPath);
-    auto fingerprintValue = fingerprint(&node, publicKeyHasher(coin));
-    hdnode_private_ckd(&node, 0x80000000);
-    hdnode_fill_public_key(&node);
-    return serialize(&node, fingerprintValue, version, true, base58Hasher(coin));
+    return getNodeExtendedPublicKey(node, coin, version);
+}
+
+std::vector<HDWallet::CoinAccount> HDWallet::deriveAccounts(const std::vector<TWCoinType>& coins, size_t threadCount) const {
+    // nodes at m/purpose', shared by the coins with the same curve and purpose
+    std::map<std::pair<TWCurve, uint32_t>, HDNode> purposeNodes;
+    for (auto coin : coins) {
+        const auto& derivationPath = TW::derivationPath(coin);
+        if (derivationPath.indices.empty() || !derivationPath.indices[0].hardened) {
+            continue;
+        }
+        const auto key = std::make_pair(TWCoinTypeCurve(coin), derivationPath.indices[0].value);
+        if (purposeNodes.count(key) == 0) {
+            auto node = getMasterNode(*this, key.first);
+            deriveChild(node, key.first, derivationPath.indices[0].derivationIndex());
+            purposeNodes.emplace(key, node);
+        }
+    }
+
+    std::vector<CoinAccount> accounts(coins.size());
+    parallelFor(coins.size(), [&](size_t i) {
+        const auto coin = coins[i];
+        const auto& derivationPath = TW::derivationPath(coin);
+        const auto version = TW::xpubVersion(coin);
+        if (derivationPath.indices.empty() || !derivationPath.indices[0].hardened) {
+            accounts[i].address = deriveAddress(coin);
+            accounts[i].extendedPublicKey = getExtendedPublicKey(derivationPath.purpose(), coin, version);
+            return;
+        }
+        const auto curve = TWCoinTypeCurve(coin);
+        const auto& purposeNode = purposeNodes.at(std::make_pair(curve, derivationPath.indices[0].value));
+
+        auto node = purposeNode;
+        for (size_t index = 1; index < derivationPath.indices.size(); ++index) {
+            deriveChild(node, curve, derivationPath.indices[index].derivationIndex());
+        }
+        accounts[i].address = TW::deriveAddress(coin, getNodePrivateKey(node, curve));
+        memzero(&node, sizeof(node));
+        if (version != TWHDVersionNone) {
+            accounts[i].extendedPublicKey = getNodeExtendedPublicKey(purposeNode, coin, version);
+        }
+    }, threadCount);
+
+    for (auto& purposeNode : purposeNodes) {
+        memzero(&purposeNode.second, sizeof(HDNode));
+    }
+    return accounts;
 }
 
 std::optional<PublicKey> HDWallet::getPublicKeyFromExtended(const std::string& extended, TWCoinType coin, const DerivationPath& path) {
@@ -252,24 +335,56 @@ bool deserialize(const std::string& extended, TWCurve curve, Hash::Hasher hasher
 }
 
 HDNode getNode(const HDWallet& wallet, TWCurve curve, const DerivationPath& derivationPath) {
-    const auto privateKeyType = HDWallet::getPrivateKeyType(curve);
     auto node = getMasterNode(wallet, curve);
     for (auto& index : derivationPath.indices) {
-        switch (privateKeyType) {
-            case HDWallet::PrivateKeyTypeHD:
-            case HDWallet::PrivateKeyTypeExtended96:
-                // special handling for extended
-                hdnode_private_ckd_cardano(&node, index.derivationIndex());
-                break;
-            case HDWallet::PrivateKeyTypeDefault32:
-            default:
-                hdnode_private_ckd(&node, index.derivationIndex());
-                break;
-        }
+        deriveChild(node, curve, index.derivationIndex());
     }
     return node;
 }
 
+void deriveChild(HDNode& node, TWCurve curve, uint32_t index) {
+    switch (HDWallet::getPrivateKeyType(curve)) {
+        case HDWallet::PrivateKeyTypeHD:
+        case HDWallet::PrivateKeyTypeExtended96:
+            // special handling for extended
+            hdnode_private_ckd_cardano(&node, index);
+            break;
+        case HDWallet::PrivateKeyTypeDefault32:
+        default:
+            hdnode_private_ckd(&node, index);
+            break;
+    }
+}
+
+PrivateKey getNodePrivateKey(const HDNode& node, TWCurve curve) {
+    switch (HDWallet::getPrivateKeyType(curve)) {
+        case HDWallet::PrivateKeyTypeExtended96:
+            {
+                auto pkData = Data(node.private_key, node.private_key + PrivateKey::size);
+                auto extData = Data(node.private_key_extension, node.private_key_extension + PrivateKey::size);
+                auto chainCode = Data(node.chain_code, node.chain_code + PrivateKey::size);
+                return PrivateKey(pkData, extData, chainCode);
+            }
+
+        case HDWallet::PrivateKeyTypeDefault32:
+        default:
+            // default path
+            auto data = Data(node.private_key, node.private_key + PrivateKey::size);
+            return PrivateKey(data);
+    }
+}
+
+/// Extended public key of account 0' of a coin, from the m/purpose' node
+std::string getNodeExtendedPublicKey(HDNode node, TWCoinType coin, TWHDVersion version) {
+    deriveChild(node, TWCoinTypeCurve(coin), DerivationPathIndex(coin, true).derivationIndex());
+    auto fingerprintValue = fingerprint(&node, publicKeyHasher(coin));
+    hdnode_private_ckd(&node, 0x80000000);
+    hdnode_fill_public_key(&node);
+    auto extended = serialize(&node, fingerprintValue, version, true, base58Hasher(coin));
+    memzero(&node, sizeof(node));
+    return extended;
+}
+
 HDNode getMasterNode(const HDWallet& wallet, TWCurve curve) {
     const auto privateKeyType = HDWallet::getPrivateKeyType(curve);
     auto node = HDNode();
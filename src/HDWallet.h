@@ -20,6 +20,7 @@
 #include <array>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace TW {
 
@@ -82,6 +83,23 @@ class HDWallet {
     /// Returns the exteded public key.
     std::string getExtendedPublicKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version) const;
 
+    /// Default address and extended public key of a coin.
+    struct CoinAccount {
+        std::string address;
+        std::string extendedPublicKey;
+    };
+
+    /// Derives the default address (see `deriveAddress`) and extended public key (see `getExtendedPublicKey`)
+    /// of each coin, concurrently.  Nodes up to the purpose level are derived once per curve and purpose,
+    /// and shared by the coins.
+    std::vector<CoinAccount> deriveAccounts(const std::vector<TWCoinType>& coins, size_t threadCount = 0) const;
+
+    /// Derives the addresses of a coin at many derivation paths, e.g. receive addresses, concurrently.  The node at
+    /// the common prefix of the paths is derived once, and public keys are derived in batches (see
+    /// `PrivateKey::getPublicKeys`).
+    std::vector<std::string> deriveAddresses(TWCoinType coin, const std::vector<DerivationPath>& paths,
+                                             size_t threadCount = 0) const;
+
     /// Computes the public key from an exteded public key representation.
     static std::optional<PublicKey> getPublicKeyFromExtended(const std::string& extended, TWCoinType coin, const DerivationPath& path);
 
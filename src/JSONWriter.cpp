@@ -0,0 +1,185 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "JSONWriter.h"
+
+#include <stdexcept>
+
+using namespace TW;
+
+namespace {
+
+/// Length of the well-formed UTF-8 sequence starting at position, 0 if invalid.
+size_t utf8SequenceLength(const std::string& string, size_t position) {
+    const auto byte = [&](size_t offset) -> unsigned char {
+        return position + offset < string.size() ? static_cast<unsigned char>(string[position + offset]) : 0;
+    };
+    const auto continuation = [&](size_t offset, unsigned char low = 0x80, unsigned char high = 0xBF) {
+        const auto b = byte(offset);
+        return b >= low && b <= high;
+    };
+    const auto first = byte(0);
+    if (first >= 0xC2 && first <= 0xDF) {
+        return continuation(1) ? 2 : 0;
+    }
+    if (first >= 0xE0 && first <= 0xEF) {
+        const unsigned char low = first == 0xE0 ? 0xA0 : 0x80;
+        const unsigned char high = first == 0xED ? 0x9F : 0xBF;
+        return continuation(1, low, high) && continuation(2) ? 3 : 0;
+    }
+    if (first >= 0xF0 && first <= 0xF4) {
+        const unsigned char low = first == 0xF0 ? 0x90 : 0x80;
+        const unsigned char high = first == 0xF4 ? 0x8F : 0xBF;
+        return continuation(1, low, high) && continuation(2) && continuation(3) ? 4 : 0;
+    }
+    return 0;
+}
+
+} // namespace
+
+JSONWriter& JSONWriter::beginObject() {
+    beginValue();
+    buffer += '{';
+    levels.push_back(Level{true, true, false, {}});
+    return *this;
+}
+
+JSONWriter& JSONWriter::endObject() {
+    if (levels.empty() || !levels.back().isObject || levels.back().expectValue) {
+        throw std::logic_error("Unexpected end of object");
+    }
+    levels.pop_back();
+    buffer += '}';
+    return *this;
+}
+
+JSONWriter& JSONWriter::beginArray() {
+    beginValue();
+    buffer += '[';
+    levels.push_back(Level{false, true, false, {}});
+    return *this;
+}
+
+JSONWriter& JSONWriter::endArray() {
+    if (levels.empty() || levels.back().isObject) {
+        throw std::logic_error("Unexpected end of array");
+    }
+    levels.pop_back();
+    buffer += ']';
+    return *this;
+}
+
+JSONWriter& JSONWriter::key(const std::string& key) {
+    if (levels.empty() || !levels.back().isObject || levels.back().expectValue) {
+        throw std::logic_error("Unexpected key");
+    }
+    auto& level = levels.back();
+    if (!level.empty) {
+        buffer += ',';
+    }
+    if (!level.empty && key <= level.lastKey) {
+        throw std::logic_error("Keys not in sorted order: " + key);
+    }
+    appendString(key);
+    buffer += ':';
+    level.empty = false;
+    level.expectValue = true;
+    level.lastKey = key;
+    return *this;
+}
+
+JSONWriter& JSONWriter::value(const std::string& value) {
+    beginValue();
+    appendString(value);
+    return *this;
+}
+
+JSONWriter& JSONWriter::value(bool value) {
+    beginValue();
+    buffer += value ? "true" : "false";
+    return *this;
+}
+
+JSONWriter& JSONWriter::null() {
+    beginValue();
+    buffer += "null";
+    return *this;
+}
+
+JSONWriter& JSONWriter::raw(const std::string& json) {
+    beginValue();
+    buffer += json;
+    return *this;
+}
+
+std::string JSONWriter::release() {
+    if (!levels.empty()) {
+        throw std::logic_error("Unclosed object or array");
+    }
+    std::string result;
+    result.swap(buffer);
+    return result;
+}
+
+void JSONWriter::beginValue() {
+    if (levels.empty()) {
+        if (!buffer.empty()) {
+            throw std::logic_error("Multiple top-level values");
+        }
+        return;
+    }
+    auto& level = levels.back();
+    if (level.isObject) {
+        if (!level.expectValue) {
+            throw std::logic_error("Missing key");
+        }
+        level.expectValue = false;
+        return;
+    }
+    if (!level.empty) {
+        buffer += ',';
+    }
+    level.empty = false;
+}
+
+void JSONWriter::appendString(const std::string& value) {
+    static const char* digits = "0123456789abcdef";
+    buffer += '"';
+    size_t plain = 0;
+    for (size_t i = 0; i < value.size();) {
+        const auto c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\' && c < 0x80) {
+            ++i;
+            continue;
+        }
+        if (c >= 0x80) {
+            const auto length = utf8SequenceLength(value, i);
+            if (length == 0) {
+                throw std::invalid_argument("Invalid UTF-8 string");
+            }
+            i += length;
+            continue;
+        }
+        buffer.append(value, plain, i - plain);
+        switch (c) {
+        case '"': buffer += "\\\""; break;
+        case '\\': buffer += "\\\\"; break;
+        case '\b': buffer += "\\b"; break;
+        case '\f': buffer += "\\f"; break;
+        case '\n': buffer += "\\n"; break;
+        case '\r': buffer += "\\r"; break;
+        case '\t': buffer += "\\t"; break;
+        default:
+            buffer += "\\u00";
+            buffer += digits[c >> 4];
+            buffer += digits[c & 0x0F];
+            break;
+        }
+        plain = ++i;
+    }
+    buffer.append(value, plain, std::string::npos);
+    buffer += '"';
+}
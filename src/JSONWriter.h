@@ -0,0 +1,80 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace TW {
+
+/// Streaming writer of compact JSON with sorted object keys, into a single buffer.
+/// The output is identical to `nlohmann::json::dump()` of the equivalent object tree, which makes
+/// it suitable for canonical signing documents, without building the tree.
+///
+/// Keys of an object must be added in sorted (byte-wise) order, and each key must be followed by
+/// its value; `std::logic_error` is thrown otherwise.  Strings must be valid UTF-8, otherwise
+/// `std::invalid_argument` is thrown.
+class JSONWriter {
+  public:
+    JSONWriter& beginObject();
+    JSONWriter& endObject();
+    JSONWriter& beginArray();
+    JSONWriter& endArray();
+
+    /// Adds the key of the next object member.
+    JSONWriter& key(const std::string& key);
+
+    JSONWriter& value(const std::string& value);
+    JSONWriter& value(const char* value) { return this->value(std::string(value)); }
+    JSONWriter& value(bool value);
+    JSONWriter& null();
+
+    /// Adds an integer value.
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+    JSONWriter& value(T value) {
+        beginValue();
+        buffer += std::to_string(value);
+        return *this;
+    }
+
+    /// Adds a value given in compact JSON with sorted keys (for example from `nlohmann::json::dump()`).
+    JSONWriter& raw(const std::string& json);
+
+    /// Adds an object member.
+    template <typename T>
+    JSONWriter& field(const std::string& key, const T& value) {
+        return this->key(key).value(value);
+    }
+
+    /// Reserves buffer space, to avoid reallocations.
+    void reserve(size_t size) { buffer.reserve(size); }
+
+    /// Returns the JSON written so far.
+    const std::string& string() const { return buffer; }
+
+    /// Returns the JSON, the writer is left empty.
+    std::string release();
+
+  private:
+    struct Level {
+        bool isObject;
+        bool empty;
+        bool expectValue;
+        /// Last key of an object, short keys fit in the string without allocation
+        std::string lastKey;
+    };
+
+    /// Writes a separator if needed, and checks that a value is allowed here.
+    void beginValue();
+    void appendString(const std::string& value);
+
+    std::string buffer;
+    std::vector<Level> levels;
+};
+
+} // namespace TW
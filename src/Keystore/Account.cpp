@@ -10,6 +10,8 @@
 #include "../Coin.h"
 #include "../HexCoding.h"
 
+#include <stdexcept>
+
 using namespace TW;
 using namespace TW::Keystore;
 
@@ -26,6 +28,9 @@ namespace CodingKeys {
 Account::Account(const nlohmann::json& json) {
     if (json[CodingKeys::derivationPath].is_object()) {
         const auto indices = json[CodingKeys::derivationPath][CodingKeys::indices];
+        if (indices.size() > DerivationPathIndices::maxSize) {
+            throw std::invalid_argument("Derivation path too deep");
+        }
         for (auto& indexJSON : indices) {
             derivationPath.indices.emplace_back(indexJSON[CodingKeys::value].get<uint32_t>(),
                                                 indexJSON[CodingKeys::hardened].get<bool>());
@@ -0,0 +1,250 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "KeyStoreDirectory.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_set>
+
+using namespace TW;
+using namespace TW::Keystore;
+
+namespace CodingKeys {
+    static const auto version = "version";
+    static const auto entries = "entries";
+    static const auto file = "file";
+    static const auto modified = "modified";
+    static const auto size = "size";
+    static const auto id = "id";
+    static const auto name = "name";
+    static const auto accounts = "accounts";
+    static const auto coin = "coin";
+    static const auto address = "address";
+} // namespace CodingKeys
+
+static const int indexVersion = 1;
+
+static std::string addressKey(TWCoinType coin, const std::string& address) {
+    return std::to_string(static_cast<uint32_t>(coin)) + ":" + address;
+}
+
+static int64_t modificationTime(const struct stat& st) {
+#if defined(__APPLE__)
+    const auto& time = st.st_mtimespec;
+#else
+    const auto& time = st.st_mtim;
+#endif
+    return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+KeyStoreDirectory::Entry::Entry(const nlohmann::json& json) {
+    fileName = json[CodingKeys::file].get<std::string>();
+    modified = json[CodingKeys::modified].get<int64_t>();
+    size = json[CodingKeys::size].get<uint64_t>();
+    id = json[CodingKeys::id].get<std::string>();
+    name = json[CodingKeys::name].get<std::string>();
+    for (auto& account : json[CodingKeys::accounts]) {
+        accounts.emplace_back(TWCoinType(account[CodingKeys::coin].get<uint32_t>()), account[CodingKeys::address].get<std::string>());
+    }
+}
+
+nlohmann::json KeyStoreDirectory::Entry::json() const {
+    nlohmann::json j;
+    j[CodingKeys::file] = fileName;
+    j[CodingKeys::modified] = modified;
+    j[CodingKeys::size] = size;
+    j[CodingKeys::id] = id;
+    j[CodingKeys::name] = name;
+    nlohmann::json accountsJSON = nlohmann::json::array();
+    for (const auto& account : accounts) {
+        accountsJSON.push_back({{CodingKeys::coin, static_cast<uint32_t>(account.first)}, {CodingKeys::address, account.second}});
+    }
+    j[CodingKeys::accounts] = accountsJSON;
+    return j;
+}
+
+KeyStoreDirectory::KeyStoreDirectory(std::string path, std::string indexFileName)
+    : path(std::move(path)), indexFileName(std::move(indexFileName)) {}
+
+std::string KeyStoreDirectory::filePath(const std::string& fileName) const {
+    if (!path.empty() && path.back() == '/') {
+        return path + fileName;
+    }
+    return path + "/" + fileName;
+}
+
+size_t KeyStoreDirectory::refresh() {
+    const bool firstRefresh = !indexLoaded;
+    if (firstRefresh) {
+        loadIndex();
+        indexLoaded = true;
+    }
+
+    DIR* dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        throw std::invalid_argument("Can't open directory");
+    }
+
+    size_t changes = 0;
+    std::unordered_set<std::string> present;
+    while (const auto* dirEntry = readdir(dir)) {
+        const auto fileName = std::string(dirEntry->d_name);
+        // skip hidden files, including the index itself
+        if (fileName.empty() || fileName[0] == '.' || fileName == indexFileName) {
+            continue;
+        }
+        struct stat st;
+        if (stat(filePath(fileName).c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+            continue;
+        }
+        present.insert(fileName);
+
+        const auto modified = modificationTime(st);
+        const auto size = static_cast<uint64_t>(st.st_size);
+        auto existing = entries.find(fileName);
+        if (existing != entries.end() && existing->second.modified == modified && existing->second.size == size) {
+            continue;
+        }
+
+        Entry entry;
+        try {
+            const auto key = StoredKey::load(filePath(fileName));
+            entry.id = key.id.value_or("");
+            entry.name = key.name;
+            for (const auto& account : key.accounts) {
+                entry.accounts.emplace_back(account.coin, account.address);
+            }
+        } catch (...) {
+            // not a stored key (anymore)
+            if (existing != entries.end()) {
+                entries.erase(existing);
+                ++changes;
+            }
+            continue;
+        }
+        entry.fileName = fileName;
+        entry.modified = modified;
+        entry.size = size;
+        entries[fileName] = std::move(entry);
+        ++changes;
+    }
+    closedir(dir);
+
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (present.count(it->first) == 0) {
+            it = entries.erase(it);
+            ++changes;
+        } else {
+            ++it;
+        }
+    }
+
+    if (changes > 0 || firstRefresh) {
+        updateLookup();
+    }
+    if (changes > 0) {
+        saveIndex();
+    }
+    return changes;
+}
+
+std::vector<const KeyStoreDirectory::Entry*> KeyStoreDirectory::all() const {
+    std::vector<const Entry*> result;
+    result.reserve(entries.size());
+    for (const auto& entry : entries) {
+        result.push_back(&entry.second);
+    }
+    return result;
+}
+
+const KeyStoreDirectory::Entry* KeyStoreDirectory::findById(const std::string& id) const {
+    const auto found = byId.find(id);
+    if (found == byId.end()) {
+        return nullptr;
+    }
+    return &entries.at(found->second);
+}
+
+const KeyStoreDirectory::Entry* KeyStoreDirectory::findByAddress(TWCoinType coin, const std::string& address) const {
+    const auto found = byAddress.find(addressKey(coin, address));
+    if (found == byAddress.end()) {
+        return nullptr;
+    }
+    return &entries.at(found->second);
+}
+
+StoredKey KeyStoreDirectory::load(const Entry& entry) const {
+    return StoredKey::load(filePath(entry.fileName));
+}
+
+void KeyStoreDirectory::loadIndex() {
+    std::ifstream stream(filePath(indexFileName));
+    if (!stream.is_open()) {
+        return;
+    }
+    try {
+        nlohmann::json j;
+        stream >> j;
+        if (j[CodingKeys::version].get<int>() != indexVersion) {
+            return;
+        }
+        std::unordered_map<std::string, Entry> loaded;
+        for (auto& entryJSON : j[CodingKeys::entries]) {
+            auto entry = Entry(entryJSON);
+            auto fileName = entry.fileName;
+            loaded.emplace(std::move(fileName), std::move(entry));
+        }
+        entries = std::move(loaded);
+    } catch (...) {
+        // unreadable index, the directory is scanned from scratch
+    }
+}
+
+bool KeyStoreDirectory::saveIndex() const {
+    nlohmann::json entriesJSON = nlohmann::json::array();
+    for (const auto& entry : entries) {
+        entriesJSON.push_back(entry.second.json());
+    }
+    nlohmann::json j;
+    j[CodingKeys::version] = indexVersion;
+    j[CodingKeys::entries] = entriesJSON;
+
+    // write to a temporary file first, so that a partially written index is never read
+    const auto indexPath = filePath(indexFileName);
+    const auto tempPath = indexPath + ".tmp";
+    {
+        auto stream = std::ofstream(tempPath);
+        if (!stream.is_open()) {
+            return false;
+        }
+        stream << j;
+        if (!stream.good()) {
+            return false;
+        }
+    }
+    return std::rename(tempPath.c_str(), indexPath.c_str()) == 0;
+}
+
+void KeyStoreDirectory::updateLookup() {
+    byId.clear();
+    byAddress.clear();
+    byId.reserve(entries.size());
+    for (const auto& entry : entries) {
+        if (!entry.second.id.empty()) {
+            byId[entry.second.id] = entry.first;
+        }
+        for (const auto& account : entry.second.accounts) {
+            if (!account.second.empty()) {
+                byAddress[addressKey(account.first, account.second)] = entry.first;
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "StoredKey.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TW::Keystore {
+
+/// A directory of stored key files, with an index of their ids, names and account addresses.
+///
+/// The index is kept in a file inside the directory, so that on startup only files that were added
+/// or modified since the index was written need to be parsed.  Keys are loaded from their files
+/// on demand; the index holds no encrypted or decrypted key material.
+class KeyStoreDirectory {
+public:
+    /// Default name of the index file inside the directory.
+    static constexpr const char* defaultIndexFileName = ".keystore-index.json";
+
+    /// Index entry of a single stored key file.
+    struct Entry {
+        /// File name, relative to the directory.
+        std::string fileName;
+
+        /// Modification time (nanoseconds) and size of the file when it was indexed.
+        int64_t modified = 0;
+        uint64_t size = 0;
+
+        /// Stored key identifier, may be empty.
+        std::string id;
+
+        /// Stored key name.
+        std::string name;
+
+        /// Coins and addresses of the stored key accounts.
+        std::vector<std::pair<TWCoinType, std::string>> accounts;
+
+        Entry() = default;
+
+        /// Initializes `Entry` with a JSON object.
+        Entry(const nlohmann::json& json);
+
+        /// Saves `this` as a JSON object.
+        nlohmann::json json() const;
+    };
+
+    /// Directory path.
+    const std::string path;
+
+    /// Creates an empty index for the directory; call `refresh` to scan it.
+    explicit KeyStoreDirectory(std::string path, std::string indexFileName = defaultIndexFileName);
+
+    /// Brings the index up to date with the directory contents, reading the index file first
+    /// if nothing is indexed yet.  Only added or modified files are parsed, and the index file is
+    /// rewritten if anything changed.  Files that are not valid stored keys are skipped.
+    ///
+    /// @returns the number of entries added, updated or removed.
+    /// @throws std::invalid_argument if the directory can't be opened.
+    size_t refresh();
+
+    /// Number of indexed stored keys.
+    size_t size() const { return entries.size(); }
+
+    /// Returns all index entries, in no particular order.
+    std::vector<const Entry*> all() const;
+
+    /// Finds the entry with the given stored key identifier.
+    const Entry* findById(const std::string& id) const;
+
+    /// Finds the entry that has an account with the given coin and address.
+    const Entry* findByAddress(TWCoinType coin, const std::string& address) const;
+
+    /// Loads the stored key of an entry from its file.
+    ///
+    /// @throws std::invalid_argument if the file can't be opened.
+    StoredKey load(const Entry& entry) const;
+
+    /// Writes the index file.
+    ///
+    /// @returns false if the file can't be written.
+    bool saveIndex() const;
+
+private:
+    /// Reads the index file, if it exists and is readable.
+    void loadIndex();
+
+    /// Rebuilds the id and address lookup tables.
+    void updateLookup();
+
+    std::string filePath(const std::string& fileName) const;
+
+    std::string indexFileName;
+    bool indexLoaded = false;
+
+    /// Entries by file name.
+    std::unordered_map<std::string, Entry> entries;
+
+    /// File names by stored key id, and by coin and address.
+    std::unordered_map<std::string, std::string> byId;
+    std::unordered_map<std::string, std::string> byAddress;
+};
+
+} // namespace TW::Keystore
@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "StoredKey.h"
+#include "StoredKeySession.h"
 
 #include "Coin.h"
 #include "HDWallet.h"
@@ -18,6 +19,7 @@
 #include <boost/uuid/uuid_io.hpp>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -127,6 +129,32 @@ std::optional<const Account> StoredKey::account(TWCoinType coin, const HDWallet*
     return accounts.back();
 }
 
+void StoredKey::addAccounts(const std::vector<TWCoinType>& coins, const HDWallet& wallet, size_t threadCount) {
+    std::vector<TWCoinType> missing;
+    for (auto coin : coins) {
+        const auto existing = std::find_if(accounts.begin(), accounts.end(), [coin](const Account& account) {
+            return account.coin == coin;
+        });
+        if ((existing == accounts.end() || existing->address.empty()) &&
+            std::find(missing.begin(), missing.end(), coin) == missing.end()) {
+            missing.push_back(coin);
+        }
+    }
+
+    const auto derived = wallet.deriveAccounts(missing, threadCount);
+    for (size_t i = 0; i < missing.size(); ++i) {
+        const auto coin = missing[i];
+        const auto existing = std::find_if(accounts.begin(), accounts.end(), [coin](const Account& account) {
+            return account.coin == coin;
+        });
+        if (existing != accounts.end()) {
+            existing->address = derived[i].address;
+        } else {
+            accounts.emplace_back(derived[i].address, coin, TW::derivationPath(coin), derived[i].extendedPublicKey);
+        }
+    }
+}
+
 void StoredKey::addAccount(const std::string& address, TWCoinType coin, const DerivationPath& derivationPath, const std::string& extetndedPublicKey) {
     accounts.emplace_back(address, coin, derivationPath, extetndedPublicKey);
 }
@@ -138,43 +166,11 @@ void StoredKey::removeAccount(TWCoinType coin) {
 }
 
 const PrivateKey StoredKey::privateKey(TWCoinType coin, const Data& password) {
-    switch (type) {
-    case StoredKeyType::mnemonicPhrase: {
-        const auto wallet = this->wallet(password);
-        const auto account = this->account(coin, &wallet);
-        return wallet.getKey(coin, account->derivationPath);
-    }
-    case StoredKeyType::privateKey:
-        return PrivateKey(payload.decrypt(password));
-    }
+    return StoredKeySession(*this, password).privateKey(coin);
 }
 
 void StoredKey::fixAddresses(const Data& password) {
-    switch (type) {
-        case StoredKeyType::mnemonicPhrase: {
-                const auto wallet = this->wallet(password);
-                for (auto& account : accounts) {
-                    if (!account.address.empty() && TW::validateAddress(account.coin, account.address)) {
-                        continue;
-                    }
-                    const auto& derivationPath = account.derivationPath;
-                    const auto key = wallet.getKey(account.coin, derivationPath);
-                    account.address = TW::deriveAddress(account.coin, key);
-                }
-            }
-            break;
-
-        case StoredKeyType::privateKey: {
-                auto key = PrivateKey(payload.decrypt(password));
-                for (auto& account : accounts) {
-                    if (!account.address.empty() && TW::validateAddress(account.coin, account.address)) {
-                        continue;
-                    }
-                    account.address = TW::deriveAddress(account.coin, key);
-                }
-            }
-            break;
-    }
+    StoredKeySession(*this, password).fixAddresses();
 }
 
 
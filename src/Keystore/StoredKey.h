@@ -75,6 +75,10 @@ public:
 
     /// Returns the account for a specific coin if it exists.
     std::optional<const Account> account(TWCoinType coin) const;
+
+    /// Adds the default accounts for several coins, deriving their addresses and extended public keys
+    /// concurrently.  Existing accounts are kept, and their missing addresses filled in.
+    void addAccounts(const std::vector<TWCoinType>& coins, const HDWallet& wallet, size_t threadCount = 0);
     
     /// Add an account
     void addAccount(const std::string& address, TWCoinType coin, const DerivationPath& derivationPath, const std::string& extetndedPublicKey);
@@ -86,6 +90,8 @@ public:
     ///
     /// @throws std::invalid_argument if this key is of a type other than
     /// `mnemonicPhrase` and a coin other than the default is requested.
+    ///
+    /// Decrypts the key on every call; use a `StoredKeySession` for consecutive operations.
     const PrivateKey privateKey(TWCoinType coin, const Data& password);
 
     /// Loads and decrypts a stored key from a file.
@@ -0,0 +1,147 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "StoredKeySession.h"
+
+#include "../Coin.h"
+#include "../Parallel.h"
+#include "../SecureAllocator.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <new>
+#include <stdexcept>
+#include <string>
+
+using namespace TW;
+using namespace TW::Keystore;
+
+void StoredKeySession::SecureWalletDeleter::operator()(HDWallet* wallet) const noexcept {
+    // seed and mnemonic are cleared by the wallet destructor
+    memzero(wallet->entropy.data(), wallet->entropy.size());
+    wallet->~HDWallet();
+    SecureAllocator<HDWallet>().deallocate(wallet, 1);
+}
+
+/// Creates a wallet in the secure pool, so that its seed is kept in locked memory.
+static std::unique_ptr<HDWallet, StoredKeySession::SecureWalletDeleter> makeSecureWallet(const std::string& mnemonic) {
+    SecureAllocator<HDWallet> allocator;
+    auto memory = allocator.allocate(1);
+    try {
+        return std::unique_ptr<HDWallet, StoredKeySession::SecureWalletDeleter>(new (memory) HDWallet(mnemonic, ""));
+    } catch (...) {
+        allocator.deallocate(memory, 1);
+        throw;
+    }
+}
+
+StoredKeySession::StoredKeySession(StoredKey& key, const Data& password, Clock::duration timeout)
+    : key(key), expiry(Clock::now() + timeout) {
+    auto data = key.payload.decrypt(password);
+    switch (key.type) {
+    case StoredKeyType::mnemonicPhrase: {
+        auto mnemonic = std::string(reinterpret_cast<const char*>(data.data()), data.size());
+        try {
+            hdWallet = makeSecureWallet(mnemonic);
+        } catch (...) {
+            memzero(mnemonic.data(), mnemonic.size());
+            memzero(data.data(), data.size());
+            throw;
+        }
+        memzero(mnemonic.data(), mnemonic.size());
+        break;
+    }
+    case StoredKeyType::privateKey:
+        try {
+            singleKey = std::make_unique<PrivateKey>(data);
+        } catch (...) {
+            memzero(data.data(), data.size());
+            throw;
+        }
+        // key bytes are allocated in locked memory
+        break;
+    }
+    memzero(data.data(), data.size());
+}
+
+bool StoredKeySession::isUnlocked() const {
+    return (hdWallet != nullptr || singleKey != nullptr) && Clock::now() < expiry;
+}
+
+void StoredKeySession::lock() {
+    hdWallet.reset();
+    // key bytes are cleared by the private key destructor
+    singleKey.reset();
+}
+
+bool StoredKeySession::purgeExpired() {
+    if ((hdWallet == nullptr && singleKey == nullptr) || Clock::now() < expiry) {
+        return false;
+    }
+    lock();
+    return true;
+}
+
+void StoredKeySession::checkUnlocked() {
+    if (!isUnlocked()) {
+        lock();
+        throw std::runtime_error("Stored key session is locked");
+    }
+}
+
+const HDWallet& StoredKeySession::wallet() {
+    checkUnlocked();
+    if (key.type != StoredKeyType::mnemonicPhrase) {
+        throw std::invalid_argument("Invalid account requested.");
+    }
+    return *hdWallet;
+}
+
+std::optional<const Account> StoredKeySession::account(TWCoinType coin) {
+    checkUnlocked();
+    return key.account(coin, hdWallet.get());
+}
+
+const PrivateKey StoredKeySession::privateKey(TWCoinType coin) {
+    checkUnlocked();
+    switch (key.type) {
+    case StoredKeyType::mnemonicPhrase: {
+        const auto account = key.account(coin, hdWallet.get());
+        return hdWallet->getKey(coin, account->derivationPath);
+    }
+    case StoredKeyType::privateKey:
+        return *singleKey;
+    }
+}
+
+void StoredKeySession::addAccounts(const std::vector<TWCoinType>& coins, size_t threadCount) {
+    key.addAccounts(coins, wallet(), threadCount);
+}
+
+void StoredKeySession::fixAddresses(size_t threadCount) {
+    checkUnlocked();
+    auto& accounts = key.accounts;
+    std::vector<std::string> addresses(accounts.size());
+    parallelFor(accounts.size(), [&](size_t i) {
+        const auto& account = accounts[i];
+        if (!account.address.empty() && TW::validateAddress(account.coin, account.address)) {
+            return;
+        }
+        switch (key.type) {
+        case StoredKeyType::mnemonicPhrase:
+            addresses[i] = TW::deriveAddress(account.coin, hdWallet->getKey(account.coin, account.derivationPath));
+            break;
+        case StoredKeyType::privateKey:
+            addresses[i] = TW::deriveAddress(account.coin, *singleKey);
+            break;
+        }
+    }, threadCount);
+    for (size_t i = 0; i < accounts.size(); ++i) {
+        if (!addresses[i].empty()) {
+            accounts[i].address = addresses[i];
+        }
+    }
+}
@@ -0,0 +1,111 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Account.h"
+#include "StoredKey.h"
+#include "../Data.h"
+#include "../HDWallet.h"
+#include "../PrivateKey.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace TW::Keystore {
+
+/// An unlocked `StoredKey`: the payload is decrypted once and the resulting wallet (or private key)
+/// is kept in memory, so that consecutive operations do not repeat the key derivation function and
+/// the mnemonic-to-seed derivation.
+///
+/// The wallet is allocated in the secure pool (see `SecurePool`), so its seed is kept in locked memory, as are
+/// private key bytes; the mnemonic and entropy buffers of the wallet are general heap memory.  All decrypted
+/// material is zeroized on lock.
+/// Expiry is checked lazily: an expired session refuses all operations, but the session has no timer,
+/// so its material is only zeroized by `lock`, `purgeExpired`, the next operation or destruction.
+/// Owners keeping a session around should call `purgeExpired` periodically.
+/// The session refers to the stored key, which must outlive it.  Not thread-safe.
+class StoredKeySession {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Default time after which an unlocked session locks itself.
+    static constexpr auto defaultTimeout = std::chrono::minutes(5);
+
+    /// Unlocks the stored key with the given password.
+    ///
+    /// @param timeout time after which the session locks itself, counted from unlocking.
+    /// @throws DecryptionError if the password is invalid.
+    StoredKeySession(StoredKey& key, const Data& password, Clock::duration timeout = defaultTimeout);
+
+    /// Destroys a wallet allocated in the secure pool.
+    struct SecureWalletDeleter {
+        void operator()(HDWallet* wallet) const noexcept;
+    };
+
+    StoredKeySession(const StoredKeySession& other) = delete;
+    StoredKeySession& operator=(const StoredKeySession& other) = delete;
+
+    ~StoredKeySession() { lock(); }
+
+    /// Whether decrypted material is available (not locked and not yet expired).
+    bool isUnlocked() const;
+
+    /// Discards the decrypted material.
+    void lock();
+
+    /// Discards the decrypted material if the session has expired.
+    ///
+    /// @returns whether material was discarded.
+    bool purgeExpired();
+
+    /// Returns the HD wallet of the stored key.
+    ///
+    /// @throws std::invalid_argument if the key is of a type other than `mnemonicPhrase`.
+    /// @throws std::runtime_error if the session is locked or expired.
+    const HDWallet& wallet();
+
+    /// Returns the account for a specific coin, creating it if necessary.
+    ///
+    /// @throws std::runtime_error if the session is locked or expired.
+    std::optional<const Account> account(TWCoinType coin);
+
+    /// Adds the default accounts for several coins, see `StoredKey::addAccounts`.
+    ///
+    /// @throws std::invalid_argument if the key is of a type other than `mnemonicPhrase`.
+    /// @throws std::runtime_error if the session is locked or expired.
+    void addAccounts(const std::vector<TWCoinType>& coins, size_t threadCount = 0);
+
+    /// Returns the private key for a specific coin, creating an account if necessary.
+    ///
+    /// @throws std::runtime_error if the session is locked or expired.
+    const PrivateKey privateKey(TWCoinType coin);
+
+    /// Fills in all empty and invalid addresses, see `StoredKey::fixAddresses`.  Accounts are
+    /// validated and derived concurrently.
+    ///
+    /// @throws std::runtime_error if the session is locked or expired.
+    void fixAddresses(size_t threadCount = 0);
+
+private:
+    /// Locks an expired session, and throws if it is not unlocked.
+    void checkUnlocked();
+
+    StoredKey& key;
+    Clock::time_point expiry;
+
+    /// Decrypted wallet, for `mnemonicPhrase` keys.
+    std::unique_ptr<HDWallet, SecureWalletDeleter> hdWallet;
+
+    /// Decrypted private key, for `privateKey` keys.
+    std::unique_ptr<PrivateKey> singleKey;
+};
+
+} // namespace TW::Keystore
@@ -9,15 +9,15 @@
 #include "../BinaryCoding.h"
 #include "../Hash.h"
 #include "../HexCoding.h"
-#include <nlohmann/json.hpp>
+#include "../JSONWriter.h"
 
+#include <algorithm>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <google/protobuf/util/json_util.h>
 
 using namespace TW;
 
 using uint128_t = boost::multiprecision::uint128_t;
-using json = nlohmann::json;
 
 namespace TW::Nano {
 
@@ -161,24 +161,35 @@ Proto::SigningOutput Signer::build() const {
     output.set_signature(signature.data(), signature.size());
     output.set_block_hash(blockHash.data(), blockHash.size());
 
-    // build json
-    json json = {
-        {"type", "state"},
-        {"account", Address(publicKey).string()},
-        {"previous", hex(previous)},
-        {"representative", Address(input.representative()).string()},
-        {"balance", input.balance()},
-        {"link", hex(link)},
-        {"link_as_account", Address(PublicKey(Data(link.begin(), link.end()), TWPublicKeyTypeED25519Blake2b)).string()},
-        {"signature", hex(signature)},
-    };
-
+    // build json, keys in sorted order
+    JSONWriter json;
+    json.reserve(512);
+    json.beginObject()
+        .field("account", Address(publicKey).string())
+        .field("balance", input.balance())
+        .field("link", hex(link))
+        .field("link_as_account", Address(PublicKey(Data(link.begin(), link.end()), TWPublicKeyTypeED25519Blake2b)).string())
+        .field("previous", hex(previous))
+        .field("representative", Address(input.representative()).string())
+        .field("signature", hex(signature))
+        .field("type", "state");
     if (input.work().size() > 0) {
-        json["work"] = input.work();
+        json.field("work", input.work());
     }
+    json.endObject();
 
-    output.set_json(json.dump());
+    output.set_json(json.release());
     return output;
 }
 
+std::array<byte, 32> Signer::workRoot() const {
+    const auto emptyPrevious = std::all_of(previous.begin(), previous.end(), [](byte b) { return b == 0; });
+    if (!emptyPrevious) {
+        return previous;
+    }
+    std::array<byte, 32> root = {0};
+    std::copy_n(publicKey.bytes.begin(), root.size(), root.begin());
+    return root;
+}
+
 } // namespace TW::Nano
@@ -34,6 +34,10 @@ class Signer {
 
     /// Builds signed transaction, incl. signature, and json format
     Proto::SigningOutput build() const;
+
+    /// Returns the root for the proof of work of the block (see `Work`): the previous block hash,
+    /// or the account public key for the first block of an account.
+    std::array<byte, 32> workRoot() const;
 };
 
 } // namespace TW::Nano
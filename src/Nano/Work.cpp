@@ -0,0 +1,175 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Work.h"
+
+#include "../BinaryCoding.h"
+#include "../Hash.h"
+#include "../HexCoding.h"
+#include "../Parallel.h"
+
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Nano;
+
+namespace {
+
+const uint64_t blake2bIV[8] = {
+    0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+    0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179,
+};
+
+const uint8_t blake2bSigma[12][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+};
+
+/// Number of nonces hashed together; the per-lane loops are laid out for the compiler to vectorize.
+constexpr size_t lanes = 4;
+
+/// Number of nonces a thread takes at a time.
+constexpr uint64_t batchSize = 1 << 14;
+
+using LaneWords = uint64_t[16][lanes];
+
+inline uint64_t rotr64(uint64_t x, int n) {
+    return (x >> n) | (x << (64 - n));
+}
+
+inline void mix(LaneWords& v, int a, int b, int c, int d, const uint64_t (&x)[lanes], const uint64_t (&y)[lanes]) {
+    for (size_t l = 0; l < lanes; ++l) {
+        v[a][l] = v[a][l] + v[b][l] + x[l];
+        v[d][l] = rotr64(v[d][l] ^ v[a][l], 32);
+        v[c][l] = v[c][l] + v[d][l];
+        v[b][l] = rotr64(v[b][l] ^ v[c][l], 24);
+        v[a][l] = v[a][l] + v[b][l] + y[l];
+        v[d][l] = rotr64(v[d][l] ^ v[a][l], 16);
+        v[c][l] = v[c][l] + v[d][l];
+        v[b][l] = rotr64(v[b][l] ^ v[c][l], 63);
+    }
+}
+
+/// Computes the work values of the nonces in m[0], with the root in m[1..4] (single 40-byte BLAKE2b block,
+/// 8-byte digest, no key).
+void hashLanes(const LaneWords& m, uint64_t (&result)[lanes]) {
+    // parameter block: digest length 8, fanout 1, depth 1
+    const uint64_t h0 = blake2bIV[0] ^ 0x01010008;
+
+    LaneWords v;
+    for (size_t l = 0; l < lanes; ++l) {
+        v[0][l] = h0;
+        for (size_t i = 1; i < 8; ++i) {
+            v[i][l] = blake2bIV[i];
+        }
+        for (size_t i = 0; i < 8; ++i) {
+            v[8 + i][l] = blake2bIV[i];
+        }
+        // message length 40, last block
+        v[12][l] ^= 40;
+        v[14][l] = ~v[14][l];
+    }
+
+    for (const auto& s : blake2bSigma) {
+        mix(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+        mix(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+        mix(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+        mix(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+        mix(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+        mix(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+        mix(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+        mix(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+
+    for (size_t l = 0; l < lanes; ++l) {
+        result[l] = h0 ^ v[0][l] ^ v[8][l];
+    }
+}
+
+} // namespace
+
+uint64_t Work::value(const std::array<byte, 32>& root, uint64_t work) {
+    Data data;
+    data.reserve(8 + root.size());
+    encode64LE(work, data);
+    data.insert(data.end(), root.begin(), root.end());
+    const auto hash = Hash::blake2b(data, 8);
+    return decode64LE(hash.data());
+}
+
+bool Work::isValid(const std::array<byte, 32>& root, uint64_t work, uint64_t threshold) {
+    return value(root, work) >= threshold;
+}
+
+std::optional<uint64_t> Work::generate(const std::array<byte, 32>& root, uint64_t threshold,
+                                       size_t threadCount, const std::atomic<bool>* cancel) {
+    // random start, so that concurrent searches for the same root do not overlap
+    std::random_device random;
+    const uint64_t start = (static_cast<uint64_t>(random()) << 32) ^ random();
+
+    const auto threads = workerCount(std::numeric_limits<size_t>::max(), threadCount);
+    std::atomic<uint64_t> nextBatch(0);
+    std::atomic<bool> found(false);
+    uint64_t work = 0;
+
+    parallelFor(threads, [&](size_t) {
+        LaneWords m = {};
+        for (size_t i = 0; i < 4; ++i) {
+            const auto word = decode64LE(root.data() + 8 * i);
+            for (size_t l = 0; l < lanes; ++l) {
+                m[1 + i][l] = word;
+            }
+        }
+        uint64_t result[lanes];
+        while (!found.load(std::memory_order_relaxed) && (cancel == nullptr || !cancel->load(std::memory_order_relaxed))) {
+            const uint64_t base = start + nextBatch.fetch_add(1) * batchSize;
+            for (uint64_t offset = 0; offset < batchSize; offset += lanes) {
+                for (size_t l = 0; l < lanes; ++l) {
+                    m[0][l] = base + offset + l;
+                }
+                hashLanes(m, result);
+                for (size_t l = 0; l < lanes; ++l) {
+                    if (result[l] >= threshold) {
+                        bool expected = false;
+                        if (found.compare_exchange_strong(expected, true)) {
+                            work = m[0][l];
+                        }
+                        return;
+                    }
+                }
+            }
+        }
+    }, threads);
+
+    if (!found) {
+        return std::nullopt;
+    }
+    return work;
+}
+
+std::string Work::string(uint64_t work) {
+    return hex(work);
+}
+
+uint64_t Work::parse(const std::string& string) {
+    const auto data = parse_hex(string);
+    if (string.size() != 16 || data.size() != 8) {
+        throw std::invalid_argument("Invalid work");
+    }
+    return decode64BE(data.data());
+}
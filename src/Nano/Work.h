@@ -0,0 +1,50 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Data.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace TW::Nano {
+
+/// Proof of work for Nano blocks: a 64-bit nonce whose 8-byte BLAKE2b hash, together with the
+/// block root, reaches a difficulty threshold.  The root is the previous block hash, or the account
+/// public key for the first block of an account.
+class Work {
+  public:
+    /// Threshold for send and change blocks.
+    static constexpr uint64_t sendThreshold = 0xfffffff800000000;
+    /// Threshold for receive blocks.
+    static constexpr uint64_t receiveThreshold = 0xfffffe0000000000;
+
+    /// Returns the difficulty value of a work nonce for a block root.
+    static uint64_t value(const std::array<byte, 32>& root, uint64_t work);
+
+    /// Checks that a work nonce reaches the threshold for a block root.
+    static bool isValid(const std::array<byte, 32>& root, uint64_t work, uint64_t threshold);
+
+    /// Searches for a work nonce reaching the threshold for a block root, on threadCount threads
+    /// (all cores if 0), several nonces per thread at a time.  The search ends early, without
+    /// result, once cancel is set.
+    static std::optional<uint64_t> generate(const std::array<byte, 32>& root, uint64_t threshold,
+                                            size_t threadCount = 0, const std::atomic<bool>* cancel = nullptr);
+
+    /// Formats a work nonce as in block JSON: 16 hexadecimal digits, most significant first.
+    static std::string string(uint64_t work);
+
+    /// Parses a work nonce from its block JSON format.
+    ///
+    /// @throws std::invalid_argument if the string is not 16 hexadecimal digits.
+    static uint64_t parse(const std::string& string);
+};
+
+} // namespace TW::Nano
@@ -0,0 +1,59 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Parallel.h"
+
+#include <system_error>
+
+using namespace TW;
+using namespace TW::internal;
+
+WorkerPool& WorkerPool::shared() {
+    static WorkerPool pool;
+    return pool;
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> task, size_t threadCount) {
+    std::lock_guard<std::mutex> lock(mutex);
+    tasks.push_back(std::move(task));
+    try {
+        while (threads.size() < std::min(threadCount, maxThreads)) {
+            threads.emplace_back([this] { run(); });
+        }
+    } catch (const std::system_error&) {
+        // out of threads: the task runs on the threads started so far, or is dropped with the pool
+    }
+    available.notify_one();
+}
+
+void WorkerPool::run() {
+    // pool threads only run parallelFor items, so calls from items run inline
+    ParallelForScope scope;
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
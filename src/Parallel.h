@@ -0,0 +1,166 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TW {
+
+/// Number of threads to use for processing count independent items: threadCount if non-zero,
+/// the hardware concurrency otherwise, but not more than count.
+inline size_t workerCount(size_t count, size_t threadCount = 0) {
+    size_t threads = threadCount > 0 ? threadCount : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    return std::max<size_t>(std::min(threads, count), 1);
+}
+
+namespace internal {
+
+/// Whether the current thread is running items of a parallelFor.
+inline bool& inParallelFor() {
+    static thread_local bool inside = false;
+    return inside;
+}
+
+/// Marks the current thread as running parallelFor items for its lifetime.
+class ParallelForScope {
+  public:
+    ParallelForScope() : previous(inParallelFor()) { inParallelFor() = true; }
+    ~ParallelForScope() { inParallelFor() = previous; }
+    ParallelForScope(const ParallelForScope&) = delete;
+    ParallelForScope& operator=(const ParallelForScope&) = delete;
+
+  private:
+    bool previous;
+};
+
+/// Persistent worker threads shared by all parallelFor calls, started on demand and reused, so that a call does
+/// not pay for creating and joining threads.  The number of threads is bounded by maxThreads.
+class WorkerPool {
+  public:
+    static constexpr size_t maxThreads = 64;
+
+    /// Returns the pool of the process.
+    static WorkerPool& shared();
+
+    ~WorkerPool();
+
+    /// Queues task to run on a pool thread, making sure at least threadCount threads are running (up to maxThreads).
+    /// Throws if the task cannot be queued; the task may run on fewer threads if threads cannot be started.
+    void submit(std::function<void()> task, size_t threadCount);
+
+  private:
+    WorkerPool() = default;
+    void run();
+
+    std::mutex mutex;
+    std::condition_variable available;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> threads;
+    bool stopping = false;
+};
+
+/// Helpers of one parallelFor call queued on the pool.  Helpers that start after the call has closed its batch do
+/// nothing, so the caller only waits for the helpers already running its items.
+class Batch {
+  public:
+    /// Runs worker unless the batch is closed.
+    template <typename Worker>
+    void help(Worker& worker) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (closed) {
+                return;
+            }
+            ++running;
+        }
+        worker();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0) {
+            done.notify_all();
+        }
+    }
+
+    /// Stops helpers from starting, and waits for the running ones.
+    void close() {
+        std::unique_lock<std::mutex> lock(mutex);
+        closed = true;
+        done.wait(lock, [this] { return running == 0; });
+    }
+
+  private:
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t running = 0;
+    bool closed = false;
+};
+
+} // namespace internal
+
+/// Call fn(index) for each index in [0, count), distributed over worker threads (the calling thread included).
+/// Items are handed out one by one, so uneven item costs are balanced.  Returns when all items are done;
+/// if fn throws, remaining items are skipped and the first exception is rethrown.
+///
+/// Items run on the calling thread and on threads of a shared pool (`internal::WorkerPool`), which are started on
+/// first use and reused across calls.  A parallelFor called from an item of another parallelFor runs its items on
+/// the calling thread, so nested calls never wait for pool threads.  If pool threads are busy or cannot be
+/// started, the items are processed by the threads already running.
+template <typename Fn>
+void parallelFor(size_t count, Fn&& fn, size_t threadCount = 0) {
+    const auto threads = internal::inParallelFor() ? 1 : workerCount(count, threadCount);
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        internal::ParallelForScope scope;
+        while (!failed) {
+            const size_t i = next++;
+            if (i >= count) {
+                return;
+            }
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+    auto batch = std::make_shared<internal::Batch>();
+    try {
+        for (size_t t = 1; t < threads; ++t) {
+            internal::WorkerPool::shared().submit([batch, &worker] { batch->help(worker); }, threads - 1);
+        }
+    } catch (const std::exception&) {
+        // out of threads or memory: continue with the helpers queued so far
+    }
+    worker();
+    batch->close();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace TW
@@ -70,9 +70,9 @@ Data Extrinsic::encodeEraNonceTip() const {
     // era
     append(data, era);
     // nonce
-    append(data, encodeCompact(nonce));
+    encodeCompact(nonce, data);
     // tip
-    append(data, encodeCompact(tip));
+    encodeCompact(tip, data);
     return data;
 }
 
@@ -89,16 +89,20 @@ Data Extrinsic::encodeCall(const Proto::SigningInput& input) {
 }
 
 Data Extrinsic::encodeBalanceCall(const Proto::Balance& balance, TWSS58AddressType network, uint32_t specVersion) {
-    Data data;
-    auto transfer = balance.transfer();
+    const auto& transfer = balance.transfer();
     auto address = SS58Address(transfer.to_address(), network);
     auto value = load(transfer.value());
+    return encodeTransferCall(address, value, network, specVersion);
+}
+
+Data Extrinsic::encodeTransferCall(const SS58Address& to, const uint256_t& value, TWSS58AddressType network, uint32_t specVersion) {
+    Data data;
     // call index
     append(data, getCallIndex(network, balanceTransfer));
     // destination
-    append(data, encodeAccountId(address.keyBytes(), encodeRawAccount(network, specVersion)));
+    append(data, encodeAccountId(to.keyBytes(), encodeRawAccount(network, specVersion)));
     // value
-    append(data, encodeCompact(value));
+    encodeCompact(value, data);
     return data;
 }
 
@@ -215,10 +219,14 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
 
 Data Extrinsic::encodePayload() const {
     Data data;
+    // era, nonce, tip and versions take at most 2 + 9 + 34 + 8 bytes
+    data.reserve(call.size() + 53 + genesisHash.size() + blockHash.size());
     // call
     append(data, call);
     // era / nonce / tip
-    append(data, encodeEraNonceTip());
+    append(data, era);
+    encodeCompact(nonce, data);
+    encodeCompact(tip, data);
     // specVersion
     encode32LE(specVersion, data);
     // transactionVersion
@@ -230,21 +238,33 @@ Data Extrinsic::encodePayload() const {
     return data;
 }
 
-Data Extrinsic::encodeSignature(const PublicKey& signer, const Data& signature) const {
+Data Extrinsic::encodeSigner(const PublicKey& signer) const {
     Data data;
     // version header
-    append(data, Data{extrinsicFormat | signedBit});
+    data.push_back(extrinsicFormat | signedBit);
     // signer public key
     append(data, encodeAccountId(signer.bytes, encodeRawAccount(network, specVersion)));
     // signature type
     append(data, sigTypeEd25519);
+    return data;
+}
+
+Data Extrinsic::encodeSignature(const PublicKey& signer, const Data& signature) const {
+    const auto encodedSigner = encodeSigner(signer);
+    const auto eraNonceTip = encodeEraNonceTip();
+    const auto size = encodedSigner.size() + signature.size() + eraNonceTip.size() + call.size();
+
+    Data data;
+    data.reserve(compactSize(size) + size);
+    // length
+    encodeCompact(size, data);
+    // version header, signer public key and signature type
+    append(data, encodedSigner);
     // signature
     append(data, signature);
     // era / nonce / tip
-    append(data, encodeEraNonceTip());
+    append(data, eraNonceTip);
     // call
     append(data, call);
-    // append length
-    encodeLengthPrefix(data);
     return data;
 }
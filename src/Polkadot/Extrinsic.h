@@ -51,17 +51,22 @@ class Extrinsic {
     }
 
     static Data encodeCall(const Proto::SigningInput& input);
+    // Balances.transfer call.
+    static Data encodeTransferCall(const SS58Address& to, const uint256_t& value, TWSS58AddressType network, uint32_t specVersion);
     // Payload to sign.
     Data encodePayload() const;
     // Encode final data with signer public key and signature.
     Data encodeSignature(const PublicKey& signer, const Data& signature) const;
+    // Version header, signer public key and signature type which precede the signature.
+    Data encodeSigner(const PublicKey& signer) const;
+    // Encoded era, nonce and tip.
+    Data encodeEraNonceTip() const;
 
   protected:
     static bool encodeRawAccount(TWSS58AddressType network, uint32_t specVersion);
     static Data encodeBalanceCall(const Proto::Balance& balance, TWSS58AddressType network, uint32_t specVersion);
     static Data encodeStakingCall(const Proto::Staking& staking, TWSS58AddressType network, uint32_t specVersion);
     static Data encodeBatchCall(const std::vector<Data>& calls, TWSS58AddressType network);
-    Data encodeEraNonceTip() const;
 };
 
 } // namespace TW::Polkadot
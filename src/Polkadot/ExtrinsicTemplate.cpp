@@ -0,0 +1,85 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ExtrinsicTemplate.h"
+#include "../Hash.h"
+
+#include <array>
+
+using namespace TW;
+using namespace TW::Polkadot;
+
+/// Payloads longer than this are signed by their hash.
+static constexpr size_t hashTreshold = 256;
+
+ExtrinsicTemplate::ExtrinsicTemplate(const Proto::SigningInput& input)
+    : key(PrivateKey(Data(input.private_key().begin(), input.private_key().end())), TWCurveED25519) {
+    const auto extrinsic = Extrinsic(input);
+    network = extrinsic.network;
+    specVersion = extrinsic.specVersion;
+    nonce = extrinsic.nonce;
+    era = extrinsic.era;
+    blockHash = extrinsic.blockHash;
+    call = extrinsic.call;
+    signer = extrinsic.encodeSigner(key.publicKey());
+    encodeCompact(extrinsic.tip, encodedTip);
+    encode32LE(extrinsic.specVersion, versionsAndGenesis);
+    encode32LE(extrinsic.version, versionsAndGenesis);
+    append(versionsAndGenesis, extrinsic.genesisHash);
+    genesisHash = extrinsic.genesisHash;
+}
+
+void ExtrinsicTemplate::setEra(uint64_t blockNumber, uint64_t period, const Data& blockHash) {
+    era = encodeEra(blockNumber, period);
+    this->blockHash = blockHash;
+}
+
+void ExtrinsicTemplate::setImmortalEra() {
+    era = encodeCompact(0);
+    blockHash = genesisHash;
+}
+
+void ExtrinsicTemplate::setTransfer(const SS58Address& to, const uint256_t& value) {
+    call = Extrinsic::encodeTransferCall(to, value, network, specVersion);
+}
+
+void ExtrinsicTemplate::sign(Data& encoded) const {
+    const auto eraNonceTipSize = era.size() + compactSize(nonce) + encodedTip.size();
+
+    // the payload is built in encoded, then replaced by the extrinsic
+    encoded.clear();
+    encoded.reserve(std::max(call.size() + eraNonceTipSize + versionsAndGenesis.size() + blockHash.size(),
+                             9 + signer.size() + 64 + eraNonceTipSize + call.size()));
+    append(encoded, call);
+    append(encoded, era);
+    encodeCompact(nonce, encoded);
+    append(encoded, encodedTip);
+    append(encoded, versionsAndGenesis);
+    append(encoded, blockHash);
+
+    std::array<byte, 64> signature;
+    if (encoded.size() > hashTreshold) {
+        const auto hash = Hash::blake2b(encoded, 32);
+        key.sign(hash.data(), hash.size(), signature.data());
+    } else {
+        key.sign(encoded.data(), encoded.size(), signature.data());
+    }
+
+    encoded.clear();
+    encodeCompact(static_cast<uint64_t>(signer.size() + signature.size() + eraNonceTipSize + call.size()), encoded);
+    append(encoded, signer);
+    encoded.insert(encoded.end(), signature.begin(), signature.end());
+    append(encoded, era);
+    encodeCompact(nonce, encoded);
+    append(encoded, encodedTip);
+    append(encoded, call);
+}
+
+Data ExtrinsicTemplate::sign() const {
+    Data encoded;
+    sign(encoded);
+    return encoded;
+}
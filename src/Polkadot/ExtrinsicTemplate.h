@@ -0,0 +1,65 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Extrinsic.h"
+#include "../Data.h"
+#include "../SigningKey.h"
+#include "../SS58Address.h"
+#include "../uint256.h"
+#include "../proto/Polkadot.pb.h"
+
+namespace TW::Polkadot {
+
+/// Signed extrinsics built repeatedly from one account, e.g. for payout batches.
+///
+/// The signing key is prepared once, and the signer, tip, spec and transaction versions and genesis hash are encoded
+/// once; per extrinsic only the nonce, era and call (for transfers, the destination and amount) are set before
+/// signing.  Encoding and signatures are the same as `Extrinsic` and `Signer`.
+class ExtrinsicTemplate {
+  public:
+    /// Takes the key, network, versions, genesis hash and tip from input, and the initial nonce, era, block hash and
+    /// call.
+    explicit ExtrinsicTemplate(const Proto::SigningInput& input);
+
+    void setNonce(uint64_t nonce) { this->nonce = nonce; }
+
+    /// Sets a mortal era, with the hash of the block it is checked against.
+    void setEra(uint64_t blockNumber, uint64_t period, const Data& blockHash);
+
+    /// Sets the immortal era, checked against the genesis block.
+    void setImmortalEra();
+
+    /// Sets the encoded call.
+    void setCall(const Data& call) { this->call = call; }
+
+    /// Sets the call to a balance transfer.
+    void setTransfer(const SS58Address& to, const uint256_t& value);
+
+    /// Signs, and writes the length-prefixed signed extrinsic into encoded, reusing its storage.
+    void sign(Data& encoded) const;
+
+    /// Signs, and returns the length-prefixed signed extrinsic.
+    Data sign() const;
+
+  private:
+    SigningKey key;
+    TWSS58AddressType network;
+    uint32_t specVersion;
+    uint64_t nonce;
+    Data era;
+    Data blockHash;
+    Data call;
+    /// Version header, signer public key and signature type.
+    Data signer;
+    Data encodedTip;
+    /// Spec and transaction versions, and genesis hash.
+    Data versionsAndGenesis;
+    Data genesisHash;
+};
+
+} // namespace TW::Polkadot
@@ -14,6 +14,7 @@
 #include <cmath>
 #include <algorithm>
 #include <bitset>
+#include <limits>
 
 
 /// Reference https://github.com/soramitsu/kagome/blob/master/core/scale/scale_encoder_stream.cpp
@@ -39,33 +40,68 @@ inline size_t countBytes(CompactInteger value) {
     return size;
 }
 
-inline Data encodeCompact(CompactInteger value) {
-    auto data = Data{};
+inline size_t countBytes(uint64_t value) {
+    size_t size = 1;
+    while (value > 0xff) {
+        ++size;
+        value >>= 8;
+    }
+    return size;
+}
+
+/// Size of the compact encoding of value.
+inline size_t compactSize(uint64_t value) {
+    if (value < kMinUint16) {
+        return 1;
+    } else if (value < kMinUint32) {
+        return 2;
+    } else if (value < kMinBigInteger) {
+        return 4;
+    }
+    return 1 + countBytes(value);
+}
 
+/// Appends the compact encoding of value, without big integer arithmetic.
+inline void encodeCompact(uint64_t value, Data& data) {
     if (value < kMinUint16) {
-        auto v = value.convert_to<uint8_t>() << 2u;
-        data.push_back(static_cast<uint8_t>(v));
-        return data;
+        data.push_back(static_cast<uint8_t>(value << 2u));
+        return;
     } else if (value < kMinUint32) {
-        auto v = (value.convert_to<uint16_t>() << 2u);
-        v += 0x01; // set 0b01 flag
-        auto minor_byte = static_cast<uint8_t>(v & 0xffu);
-        data.push_back(minor_byte);
-        v >>= 8u;
-        auto major_byte = static_cast<uint8_t>(v & 0xffu);
-        data.push_back(major_byte);
-        return data;
+        auto v = static_cast<uint16_t>((value << 2u) + 0x01); // set 0b01 flag
+        data.push_back(static_cast<uint8_t>(v & 0xffu));
+        data.push_back(static_cast<uint8_t>(v >> 8u));
+        return;
     } else if (value < kMinBigInteger) {
-        uint32_t v = (value.convert_to<uint32_t>() << 2u);
-        v += 0x02; // set 0b10 flag
-        encode32LE(v, data);
-        return data;
+        encode32LE(static_cast<uint32_t>((value << 2u) + 0x02), data); // set 0b10 flag
+        return;
+    }
+
+    // a header with the length in bytes (at least 4), then the little-endian bytes
+    auto length = countBytes(value);
+    data.push_back(static_cast<uint8_t>((length - 4) * 4 + 0x03)); // set 0b11 flag
+    for (size_t i = 0; i < length; ++i) {
+        data.push_back(static_cast<uint8_t>(value & 0xff));
+        value >>= 8;
+    }
+}
+
+inline Data encodeCompact(uint64_t value) {
+    auto data = Data{};
+    encodeCompact(value, data);
+    return data;
+}
+
+/// Appends the compact encoding of value; big integers of more than 67 bytes are not encoded.
+inline void encodeCompact(const CompactInteger& value, Data& data) {
+    if (value <= std::numeric_limits<uint64_t>::max()) {
+        encodeCompact(value.convert_to<uint64_t>(), data);
+        return;
     }
 
     auto length = countBytes(value);
     if (length > 67) {
         // too big
-        return data;
+        return;
     }
     uint8_t header = (static_cast<uint8_t>(length) - 4) * 4;
     header += 0x03; // set 0b11 flag;
@@ -76,6 +112,11 @@ inline Data encodeCompact(CompactInteger value) {
         data.push_back(static_cast<uint8_t>(v & 0xff)); // push back least significant byte
         v >>= 8;
     }
+}
+
+inline Data encodeCompact(const CompactInteger& value) {
+    auto data = Data{};
+    encodeCompact(value, data);
     return data;
 }
 
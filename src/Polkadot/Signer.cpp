@@ -5,26 +5,13 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Signer.h"
-#include "Extrinsic.h"
-#include "../Hash.h"
-#include "../PrivateKey.h"
+#include "ExtrinsicTemplate.h"
 
 using namespace TW;
 using namespace TW::Polkadot;
 
-static constexpr size_t hashTreshold = 256;
-
 Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
-    auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
-    auto extrinsic = Extrinsic(input);
-    auto payload = extrinsic.encodePayload();
-    // check if need to hash
-    if (payload.size() > hashTreshold) {
-        payload = Hash::blake2b(payload, 32);
-    }
-    auto signature = privateKey.sign(payload, TWCurveED25519);
-    auto encoded = extrinsic.encodeSignature(publicKey, signature);
+    auto encoded = ExtrinsicTemplate(input).sign();
 
     auto protoOutput = Proto::SigningOutput();
     protoOutput.set_encoded(encoded.data(), encoded.size());
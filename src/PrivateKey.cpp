@@ -18,6 +18,9 @@
 #include <TrezorCrypto/secp256k1.h>
 #include <TrezorCrypto/sodium/keypair.h>
 
+#include <algorithm>
+#include <array>
+
 using namespace TW;
 
 bool PrivateKey::isValid(const Data& data) {
@@ -86,7 +89,7 @@ PrivateKey::PrivateKey(const Data& data) {
             TW::data(data.data() + 64, 32));
     } else {
         // default case
-        bytes = data;
+        bytes.assign(data.begin(), data.end());
     }
 }
 
@@ -94,9 +97,9 @@ PrivateKey::PrivateKey(const Data& data, const Data& ext, const Data& chainCode)
     if (!isValid(data) || !isValid(ext) || !isValid(chainCode)) {
         throw std::invalid_argument("Invalid private key or extended key data");
     }
-    bytes = data;
-    extensionBytes = ext;
-    chainCodeBytes = chainCode;
+    bytes.assign(data.begin(), data.end());
+    extensionBytes.assign(ext.begin(), ext.end());
+    chainCodeBytes.assign(chainCode.begin(), chainCode.end());
 }
 
 PublicKey PrivateKey::getPublicKey(TWPublicKeyType type) const {
@@ -153,6 +156,37 @@ int ecdsa_sign_digest_checked(const ecdsa_curve *curve, const uint8_t *priv_key,
     return ecdsa_sign_digest(curve, priv_key, digest, sig, pby, is_canonical);
 }
 
+std::vector<PublicKey> PrivateKey::getPublicKeys(const std::vector<PrivateKey>& privateKeys,
+                                                 enum TWPublicKeyType type) {
+    std::vector<PublicKey> result;
+    result.reserve(privateKeys.size());
+    if (type != TWPublicKeyTypeED25519 && type != TWPublicKeyTypeED25519Blake2b) {
+        for (const auto& privateKey : privateKeys) {
+            result.push_back(privateKey.getPublicKey(type));
+        }
+        return result;
+    }
+
+    std::array<ed25519_secret_key, ED25519_PUBLICKEY_BATCH_SIZE> secretKeys;
+    std::array<ed25519_public_key, ED25519_PUBLICKEY_BATCH_SIZE> publicKeys;
+    for (size_t begin = 0; begin < privateKeys.size(); begin += secretKeys.size()) {
+        const auto count = std::min(secretKeys.size(), privateKeys.size() - begin);
+        for (size_t i = 0; i < count; ++i) {
+            std::copy(privateKeys[begin + i].bytes.begin(), privateKeys[begin + i].bytes.end(), secretKeys[i]);
+        }
+        if (type == TWPublicKeyTypeED25519) {
+            ed25519_publickey_batch(secretKeys.data(), publicKeys.data(), count);
+        } else {
+            ed25519_publickey_batch_blake2b(secretKeys.data(), publicKeys.data(), count);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            result.emplace_back(Data(publicKeys[i], publicKeys[i] + PublicKey::ed25519Size), type);
+        }
+    }
+    memzero(secretKeys.data(), sizeof(secretKeys));
+    return result;
+}
+
 Data PrivateKey::sign(const Data& digest, TWCurve curve) const {
     Data result;
     bool success = false;
@@ -8,6 +8,7 @@
 
 #include "Data.h"
 #include "PublicKey.h"
+#include "SecureAllocator.h"
 
 #include <TrustWalletCore/TWCurve.h>
 
@@ -20,12 +21,12 @@ class PrivateKey {
     /// The number of bytes in an extended private key.
     static const size_t extendedSize = 3 * 32;
 
-    /// The private key bytes.
-    Data bytes;
+    /// The private key bytes, in locked memory (see `SecurePool`).
+    SecureData bytes;
     /// Optional extended part of the key (additional 32 bytes)
-    Data extensionBytes;
+    SecureData extensionBytes;
     /// Optional chain code (additional 32 bytes)
-    Data chainCodeBytes;
+    SecureData chainCodeBytes;
 
     /// Determines if a collection of bytes makes a valid private key.
     static bool isValid(const Data& data);
@@ -53,6 +54,11 @@ class PrivateKey {
     /// Returns the public key for this private key.
     PublicKey getPublicKey(enum TWPublicKeyType type) const;
 
+    /// Returns the public keys for privateKeys, same as `getPublicKey` of each.  Ed25519 keys (plain and Blake2b)
+    /// are derived in batches that share one field inversion.
+    static std::vector<PublicKey> getPublicKeys(const std::vector<PrivateKey>& privateKeys,
+                                                enum TWPublicKeyType type);
+
     /// Signs a digest using the given ECDSA curve.
     Data sign(const Data& digest, TWCurve curve) const;
 
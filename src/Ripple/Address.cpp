@@ -32,6 +32,14 @@ Address::Address(const PublicKey& publicKey) {
     ecdsa_get_pubkeyhash(publicKey.bytes.data(), HASHER_SHA2_RIPEMD, bytes.data() + 1);
 }
 
+Address::Address(const Data& keyHash) {
+    if (keyHash.size() != Address::size - 1) {
+        throw std::invalid_argument("Invalid public key hash");
+    }
+    bytes[0] = 0x00;
+    std::copy(keyHash.begin(), keyHash.end(), bytes.begin() + 1);
+}
+
 std::string Address::string() const {
     return Base58::ripple.encodeCheck(bytes);
 }
@@ -30,6 +30,9 @@ class Address {
     /// Initializes a Ripple address with a public key.
     explicit Address(const PublicKey& publicKey);
 
+    /// Initializes a Ripple address with a 20-byte public key hash, as serialized in transactions.
+    explicit Address(const Data& keyHash);
+
     /// Returns a string representation of the address.
     std::string string() const;
 };
@@ -0,0 +1,226 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BinaryCoding.h"
+#include "Transaction.h"
+
+#include <stdexcept>
+#include <utility>
+
+using namespace TW;
+using namespace TW::Ripple;
+
+namespace {
+
+/// Object end marker: an object field with key 1.
+constexpr byte objectEndMarker = 0xe1;
+/// Array end marker: an array field with key 1.
+constexpr byte arrayEndMarker = 0xf1;
+
+// Path set markers and path step flags
+constexpr byte pathSetEnd = 0x00;
+constexpr byte pathSeparator = 0xff;
+constexpr byte pathStepAccount = 0x01;
+constexpr byte pathStepCurrency = 0x10;
+constexpr byte pathStepIssuer = 0x20;
+
+/// Number of bytes of a step account, currency or issuer.
+constexpr size_t pathStepFieldSize = 20;
+
+byte readByte(const Data& data, size_t& offset) {
+    if (offset >= data.size()) {
+        throw std::invalid_argument("Field data too short");
+    }
+    return data[offset++];
+}
+
+/// Advances offset past size bytes.
+void skip(const Data& data, size_t& offset, size_t size) {
+    if (size > data.size() - offset) {
+        throw std::invalid_argument("Field data too short");
+    }
+    offset += size;
+}
+
+/// Size of fixed size values, or 0.
+size_t fixedSize(FieldType type) {
+    switch (type) {
+    case FieldType::int8:
+        return 1;
+    case FieldType::int16:
+        return 2;
+    case FieldType::int32:
+        return 4;
+    case FieldType::int64:
+        return 8;
+    case FieldType::hash128:
+        return 16;
+    case FieldType::hash160:
+        return 20;
+    case FieldType::hash256:
+        return 32;
+    default:
+        return 0;
+    }
+}
+
+/// Advances offset past a path set, up to and including its end marker.
+void skipPathSet(const Data& data, size_t& offset) {
+    while (true) {
+        const auto flags = readByte(data, offset);
+        if (flags == pathSetEnd) {
+            return;
+        }
+        if (flags == pathSeparator) {
+            continue;
+        }
+        if ((flags & ~(pathStepAccount | pathStepCurrency | pathStepIssuer)) != 0) {
+            throw std::invalid_argument("Invalid path step");
+        }
+        for (const auto flag : {pathStepAccount, pathStepCurrency, pathStepIssuer}) {
+            if ((flags & flag) != 0) {
+                skip(data, offset, pathStepFieldSize);
+            }
+        }
+    }
+}
+
+/// Checks that field follows the previous field of its object (type and key) in canonical order: sorted by type,
+/// then key, without duplicates.  Updates previous.
+void checkCanonicalOrder(std::pair<FieldType, int>& previous, const Field& field) {
+    const auto current = std::make_pair(field.type, field.key);
+    if (previous >= current) {
+        throw std::invalid_argument("Fields not in canonical order");
+    }
+    previous = current;
+}
+
+/// Type and key preceding those of all fields, for `checkCanonicalOrder`.
+const auto firstField = std::make_pair(FieldType(0), 0);
+
+} // namespace
+
+size_t TW::Ripple::decodeVariableLength(const Data& data, size_t& offset) {
+    const size_t byte0 = readByte(data, offset);
+    if (byte0 <= 192) {
+        return byte0;
+    }
+    if (byte0 <= 240) {
+        const size_t byte1 = readByte(data, offset);
+        return 193 + ((byte0 - 193) << 8) + byte1;
+    }
+    if (byte0 <= 254) {
+        const size_t byte1 = readByte(data, offset);
+        const size_t byte2 = readByte(data, offset);
+        return 12481 + ((byte0 - 241) << 16) + (byte1 << 8) + byte2;
+    }
+    throw std::invalid_argument("Invalid variable length");
+}
+
+namespace {
+
+/// Decodes a field within depth enclosing objects and arrays.
+Field decodeNestedField(const Data& data, size_t& offset, size_t depth) {
+    // type and key codes of 16 and more follow the header byte, type first
+    const auto header = readByte(data, offset);
+    int type = header >> 4;
+    int key = header & 0xf;
+    if (type == 0) {
+        type = readByte(data, offset);
+        if (type < 16) {
+            throw std::invalid_argument("Non-canonical field type");
+        }
+    }
+    if (key == 0) {
+        key = readByte(data, offset);
+        if (key < 16) {
+            throw std::invalid_argument("Non-canonical field key");
+        }
+    }
+
+    auto field = Field{static_cast<FieldType>(type), key, {}};
+    auto begin = offset;
+    auto end = offset;
+    if (const auto size = fixedSize(field.type); size != 0) {
+        skip(data, offset, size);
+        end = offset;
+    } else {
+        switch (field.type) {
+        case FieldType::amount:
+            // XRP amounts have the first bit clear, issued currency amounts add currency and issuer
+            skip(data, offset, (readByte(data, offset) & 0x80) == 0 ? 7 : 47);
+            end = offset;
+            break;
+        case FieldType::vl:
+        case FieldType::account:
+        case FieldType::vector256: {
+            const auto length = decodeVariableLength(data, offset);
+            if ((field.type == FieldType::account && length != Address::size - 1) ||
+                (field.type == FieldType::vector256 && length % 32 != 0)) {
+                throw std::invalid_argument("Invalid field length");
+            }
+            begin = offset;
+            skip(data, offset, length);
+            end = offset;
+            break;
+        }
+        case FieldType::object: {
+            if (key == 1) {
+                throw std::invalid_argument("Unexpected object end marker");
+            }
+            if (depth >= maxFieldDepth) {
+                throw std::invalid_argument("Fields nested too deeply");
+            }
+            auto previous = firstField;
+            while (readByte(data, offset) != objectEndMarker) {
+                checkCanonicalOrder(previous, decodeNestedField(data, --offset, depth + 1));
+            }
+            end = offset - 1;
+            break;
+        }
+        case FieldType::array:
+            if (key == 1) {
+                throw std::invalid_argument("Unexpected array end marker");
+            }
+            if (depth >= maxFieldDepth) {
+                throw std::invalid_argument("Fields nested too deeply");
+            }
+            while (readByte(data, offset) != arrayEndMarker) {
+                if (decodeNestedField(data, --offset, depth + 1).type != FieldType::object) {
+                    throw std::invalid_argument("Array element is not an object");
+                }
+            }
+            end = offset - 1;
+            break;
+        case FieldType::pathset:
+            skipPathSet(data, offset);
+            end = offset - 1;
+            break;
+        default:
+            throw std::invalid_argument("Unknown field type");
+        }
+    }
+    field.value.assign(data.begin() + begin, data.begin() + end);
+    return field;
+}
+
+} // namespace
+
+Field TW::Ripple::decodeField(const Data& data, size_t& offset) {
+    return decodeNestedField(data, offset, 0);
+}
+
+std::vector<Field> TW::Ripple::decodeFields(const Data& data) {
+    std::vector<Field> fields;
+    size_t offset = 0;
+    auto previous = firstField;
+    while (offset < data.size()) {
+        auto field = decodeField(data, offset);
+        checkCanonicalOrder(previous, field);
+        fields.push_back(std::move(field));
+    }
+    return fields;
+}
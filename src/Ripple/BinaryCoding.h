@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "../Data.h"
+
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -41,10 +43,50 @@ inline void encodeVariableLength(size_t length, std::vector<uint8_t>& data) {
     }
 }
 
+/// Size of the encoding of a variable length.
+inline size_t variableLengthSize(size_t length) {
+    if (length <= 192) {
+        return 1;
+    } else if (length <= 12480) {
+        return 2;
+    }
+    return 3;
+}
+
 /// Encodes a variable length bytes.
-inline void encodeBytes(std::vector<uint8_t> bytes, std::vector<uint8_t>& data) {
+inline void encodeBytes(const std::vector<uint8_t>& bytes, std::vector<uint8_t>& data) {
     encodeVariableLength(bytes.size(), data);
     data.insert(data.end(), bytes.begin(), bytes.end());
 }
 
+/// A field decoded from the binary format.
+struct Field {
+    FieldType type;
+    int key;
+    /// The value, without the length prefix of variable length fields.  Objects and arrays hold their encoded
+    /// fields or objects, without the end marker.
+    Data value;
+};
+
+/// Decodes a variable length at offset, and advances offset past it.
+///
+/// @throws std::invalid_argument if the data is truncated.
+size_t decodeVariableLength(const Data& data, size_t& offset);
+
+/// Maximum nesting depth of objects and arrays accepted by `decodeField`.
+static const size_t maxFieldDepth = 10;
+
+/// Decodes the field at offset, and advances offset past it.  Nested objects and arrays are checked as well,
+/// including the canonical order of the fields of each object.
+///
+/// @throws std::invalid_argument if the field is malformed, truncated, of an unknown type, nested more than
+/// `maxFieldDepth` deep, or has object fields out of canonical order.
+Field decodeField(const Data& data, size_t& offset);
+
+/// Decodes all fields of a serialized object, such as a transaction.
+///
+/// @throws std::invalid_argument if a field is malformed, or the fields are not in canonical order (sorted by type,
+/// then key, without duplicates).
+std::vector<Field> decodeFields(const Data& data);
+
 } // namespace TW::Ripple
@@ -13,6 +13,21 @@ using namespace TW::Ripple;
 
 static const int64_t fullyCanonical = 0x80000000;
 
+/// Sets the flags and public key of transaction for signing with key, serializes its pre-image (network prefix and
+/// unsigned transaction) into preImage, and returns its signature.  signatureOffset receives the offset of the
+/// signature field in preImage.
+static Data signPreImage(const PrivateKey& key, Transaction& transaction, Data& preImage, size_t& signatureOffset) {
+    // See https://github.com/trezor/trezor-core/blob/master/src/apps/ripple/sign_tx.py#L59
+    transaction.flags |= fullyCanonical;
+    transaction.pub_key = key.getPublicKey(TWPublicKeyTypeSECP256k1).bytes;
+
+    encode32BE(Transaction::networkPrefix, preImage);
+    signatureOffset = transaction.serializeUnsigned(preImage);
+    auto hash = Hash::sha512(preImage);
+    auto half = Data(hash.begin(), hash.begin() + 32);
+    return key.signAsDER(half, TWCurveSECP256k1);
+}
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
     auto transaction = Transaction(
@@ -26,23 +41,20 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
         /* destination_tag*/input.destination_tag()
     );
 
-    auto signer = Signer();
-    signer.sign(key, transaction);
+    // Serialize once: the signed transaction is the pre-image without its prefix, with the signature inserted
+    auto encoded = Data();
+    size_t signatureOffset = 0;
+    const auto signature = signPreImage(key, transaction, encoded, signatureOffset);
+    encoded.erase(encoded.begin(), encoded.begin() + 4);
+    Transaction::insertSignature(encoded, signatureOffset - 4, signature);
 
     auto output = Proto::SigningOutput();
-    auto encoded = transaction.serialize();
     output.set_encoded(encoded.data(), encoded.size());
     return output;
 }
 
 void Signer::sign(const PrivateKey& privateKey, Transaction& transaction) const noexcept {
-    /// See https://github.com/trezor/trezor-core/blob/master/src/apps/ripple/sign_tx.py#L59
-    transaction.flags |= fullyCanonical;
-    transaction.pub_key = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes;
-
-    auto unsignedTx = transaction.getPreImage();
-    auto hash = Hash::sha512(unsignedTx);
-    auto half = Data(hash.begin(), hash.begin() + 32);
-
-    transaction.signature = privateKey.signAsDER(half, TWCurveSECP256k1);
+    auto preImage = Data();
+    size_t signatureOffset = 0;
+    transaction.signature = signPreImage(privateKey, transaction, preImage, signatureOffset);
 }
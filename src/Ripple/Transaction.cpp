@@ -9,13 +9,55 @@
 #include "../BinaryCoding.h"
 #include "../HexCoding.h"
 
+#include <stdexcept>
+
 using namespace TW;
 using namespace TW::Ripple;
 
-const int NETWORK_PREFIX = 0x53545800;
+namespace {
+
+/// Size of all fields but the public key, signature and destination, with the tags.
+constexpr size_t fixedFieldsSize = 3 + 5 + 5 + 5 + 6 + 9 + 9 + 22 + 2;
+
+/// XRP amount bits: clear first bit to indicate XRP, set second bit to indicate positive number.
+constexpr uint64_t amountNotXRPBit = 0x8000000000000000;
+constexpr uint64_t amountPositiveBit = 0x4000000000000000;
+
+void encodeAmount(int64_t amount, Data& data) {
+    if (amount < 0) {
+        return;
+    }
+    encode64BE((uint64_t(amount) & ~amountNotXRPBit) | amountPositiveBit, data);
+}
+
+int64_t decodeAmount(const Data& value) {
+    if (value.size() != 8 || (value[0] & 0x80) != 0) {
+        throw std::invalid_argument("Only XRP amounts are supported");
+    }
+    const auto amount = decode64BE(value.data());
+    if ((amount & amountPositiveBit) == 0) {
+        throw std::invalid_argument("Negative amounts are not supported");
+    }
+    return static_cast<int64_t>(amount & ~amountPositiveBit);
+}
+
+uint32_t decodeInt32(const Field& field) {
+    return decode32BE(field.value.data());
+}
+
+} // namespace
 
 Data Transaction::serialize() const {
     auto data = Data();
+    data.reserve(fixedFieldsSize + pub_key.size() + signature.size() + destination.size() + 6);
+    const auto signatureOffset = serializeUnsigned(data);
+    if (!signature.empty()) {
+        insertSignature(data, signatureOffset, signature);
+    }
+    return data;
+}
+
+size_t Transaction::serializeUnsigned(Data& data) const {
     /// field must be sorted by field type then by field name
     /// "type"
     encodeType(FieldType::int16, 2, data);
@@ -38,36 +80,134 @@ Data Transaction::serialize() const {
     }
     /// "amount"
     encodeType(FieldType::amount, 1, data);
-    append(data, serializeAmount(amount));
+    encodeAmount(amount, data);
     /// "fee"
     encodeType(FieldType::amount, 8, data);
-    append(data, serializeAmount(fee));
+    encodeAmount(fee, data);
     /// "signingPubKey"
     if (!pub_key.empty()) {
         encodeType(FieldType::vl, 3, data);
         encodeBytes(pub_key, data);
     }
-    /// "txnSignature"
-    if (!signature.empty()) {
-        encodeType(FieldType::vl, 4, data);
-        encodeBytes(signature, data);
-    }
+    /// "txnSignature" goes here
+    const auto signatureOffset = data.size();
     /// "account"
     encodeType(FieldType::account, 1, data);
-    encodeBytes(serializeAddress(account), data);
+    encodeVariableLength(Address::size - 1, data);
+    data.insert(data.end(), account.bytes.begin() + 1, account.bytes.end());
     /// "destination"
     encodeType(FieldType::account, 3, data);
     encodeBytes(destination, data);
-    return data;
+    return signatureOffset;
+}
+
+void Transaction::insertSignature(Data& data, size_t offset, const Data& signature) {
+    Data field;
+    field.reserve(1 + variableLengthSize(signature.size()) + signature.size());
+    encodeType(FieldType::vl, 4, field);
+    encodeBytes(signature, field);
+    data.insert(data.begin() + offset, field.begin(), field.end());
 }
 
 Data Transaction::getPreImage() const {
     auto preImage = Data();
-    encode32BE(NETWORK_PREFIX, preImage);
-    append(preImage, serialize());
+    preImage.reserve(4 + fixedFieldsSize + pub_key.size() + destination.size() + 2);
+    encode32BE(networkPrefix, preImage);
+    serializeUnsigned(preImage);
     return preImage;
 }
 
+Transaction Transaction::deserialize(const Data& data) {
+    const auto fields = decodeFields(data);
+    const Field* account = nullptr;
+    const Field* destination = nullptr;
+    bool hasType = false, hasFlags = false, hasSequence = false, hasAmount = false, hasFee = false;
+    int64_t amount = 0, fee = 0, flags = 0, destinationTag = 0;
+    int32_t sequence = 0, lastLedgerSequence = 0;
+    bool encodeTag = false;
+    Data pubKey, signature;
+
+    for (const auto& field : fields) {
+        switch (field.type) {
+        case FieldType::int16:
+            if (field.key != 2) {
+                break;
+            }
+            if (decode16BE(field.value.data()) != uint16_t(TransactionType::payment)) {
+                throw std::invalid_argument("Only Payment transactions are supported");
+            }
+            hasType = true;
+            continue;
+        case FieldType::int32:
+            switch (field.key) {
+            case 2:
+                flags = decodeInt32(field);
+                hasFlags = true;
+                continue;
+            case 4:
+                sequence = static_cast<int32_t>(decodeInt32(field));
+                hasSequence = true;
+                continue;
+            case 14:
+                destinationTag = decodeInt32(field);
+                encodeTag = true;
+                continue;
+            case 27:
+                lastLedgerSequence = static_cast<int32_t>(decodeInt32(field));
+                if (lastLedgerSequence <= 0) {
+                    break;
+                }
+                continue;
+            }
+            break;
+        case FieldType::amount:
+            if (field.key == 1) {
+                amount = decodeAmount(field.value);
+                hasAmount = true;
+                continue;
+            } else if (field.key == 8) {
+                fee = decodeAmount(field.value);
+                hasFee = true;
+                continue;
+            }
+            break;
+        case FieldType::vl:
+            if (field.key == 3 && !field.value.empty()) {
+                pubKey = field.value;
+                continue;
+            } else if (field.key == 4 && !field.value.empty()) {
+                signature = field.value;
+                continue;
+            }
+            break;
+        case FieldType::account:
+            if (field.key == 1) {
+                account = &field;
+                continue;
+            } else if (field.key == 3) {
+                destination = &field;
+                continue;
+            }
+            break;
+        default:
+            break;
+        }
+        throw std::invalid_argument("Unsupported field in transaction");
+    }
+    if (!hasType || !hasFlags || !hasSequence || !hasAmount || !hasFee || account == nullptr ||
+        destination == nullptr) {
+        throw std::invalid_argument("Missing field in transaction");
+    }
+
+    auto transaction = Transaction(amount, fee, flags, sequence, lastLedgerSequence, Address(account->value),
+                                   Address(destination->value).string(), 0);
+    transaction.encode_tag = encodeTag;
+    transaction.destination_tag = destinationTag;
+    transaction.pub_key = std::move(pubKey);
+    transaction.signature = std::move(signature);
+    return transaction;
+}
+
 Data Transaction::serializeAmount(int64_t amount) {
     if (amount < 0) {
         return Data();
@@ -14,11 +14,20 @@
 namespace TW::Ripple {
 
 enum class FieldType: int {
-    int16   = 1,
-    int32   = 2,
-    amount  = 6,
-    vl      = 7,
-    account = 8
+    int16     = 1,
+    int32     = 2,
+    int64     = 3,
+    hash128   = 4,
+    hash256   = 5,
+    amount    = 6,
+    vl        = 7,
+    account   = 8,
+    object    = 14,
+    array     = 15,
+    int8      = 16,
+    hash160   = 17,
+    pathset   = 18,
+    vector256 = 19
 };
 
 enum class TransactionType { payment = 0 };
@@ -28,6 +37,9 @@ class Transaction {
     /// Non-XRP currencies are not supported. Float and negative amounts are not supported.
     /// See https://github.com/trezor/trezor-core/tree/master/src/apps/ripple#transactions
   public:
+    /// Prefix of signing pre-images.
+    static const uint32_t networkPrefix = 0x53545800;
+
     int64_t amount;
     int64_t fee;
     int64_t flags;
@@ -66,8 +78,23 @@ class Transaction {
     /// simplified serialization format tailored for Payment transaction type
     /// exclusively.
     Data serialize() const;
+
+    /// Returns the signing pre-image: the network prefix followed by the fields, without the signature.
     Data getPreImage() const;
 
+    /// Appends the fields without the signature to data, and returns the offset of the signature, which comes
+    /// between the signing public key and the account.
+    size_t serializeUnsigned(Data& data) const;
+
+    /// Inserts the signature field at offset, as returned by `serializeUnsigned`.
+    static void insertSignature(Data& data, size_t offset, const Data& signature);
+
+    /// Parses a serialized Payment, e.g. to check a transaction returned by a node or a signing service.
+    ///
+    /// @throws std::invalid_argument if the transaction is malformed, is not a Payment, has non-XRP amounts, or has
+    /// fields `serialize` does not produce.
+    static Transaction deserialize(const Data& data);
+
     static Data serializeAmount(int64_t amount);
     static Data serializeAddress(Address address);
 };
@@ -0,0 +1,142 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SecureAllocator.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <atomic>
+#include <mutex>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define TW_HAVE_MMAP 1
+#endif
+
+using namespace TW;
+
+namespace {
+
+/// Smallest block size; blocks are powers of two up to `SecurePool::maxBlockSize`.
+constexpr size_t minBlockSize = 32;
+constexpr size_t sizeClassCount = 6;
+static_assert(minBlockSize << (sizeClassCount - 1) == SecurePool::maxBlockSize, "Size classes must cover the block sizes");
+
+/// Pages of blocks per slab, kept small as locked memory is limited per process.
+constexpr size_t slabPages = 4;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+/// Blocks of one size: a free list, and the unused rest of the current slab.
+struct SizeClass {
+    std::mutex mutex;
+    FreeBlock* freeList = nullptr;
+    char* cursor = nullptr;
+    char* limit = nullptr;
+};
+
+SizeClass sizeClasses[sizeClassCount];
+std::atomic<size_t> slabs(0);
+
+size_t sizeClassIndex(size_t size) {
+    size_t index = 0;
+    for (size_t blockSize = minBlockSize; blockSize < size; blockSize <<= 1) {
+        ++index;
+    }
+    return index;
+}
+
+#ifdef TW_HAVE_MMAP
+
+/// Maps a slab with a guard page on each side, and returns the usable part, or nullptr.
+char* mapSlab(size_t& usableSize) {
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    usableSize = slabPages * pageSize;
+    const auto total = usableSize + 2 * pageSize;
+    void* region = mmap(nullptr, total, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        return nullptr;
+    }
+    auto usable = static_cast<char*>(region) + pageSize;
+    if (mprotect(usable, usableSize, PROT_READ | PROT_WRITE) != 0) {
+        munmap(region, total);
+        return nullptr;
+    }
+    // best effort, as it may exceed the process limit
+    mlock(usable, usableSize);
+#ifdef MADV_DONTDUMP
+    madvise(usable, usableSize, MADV_DONTDUMP);
+#endif
+    ++slabs;
+    return usable;
+}
+
+#endif
+
+} // namespace
+
+SecurePool& SecurePool::shared() {
+    static SecurePool pool;
+    return pool;
+}
+
+void* SecurePool::allocate(size_t size) {
+#ifdef TW_HAVE_MMAP
+    if (size <= maxBlockSize) {
+        const auto index = sizeClassIndex(size);
+        const auto blockSize = minBlockSize << index;
+        auto& sizeClass = sizeClasses[index];
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        if (sizeClass.freeList != nullptr) {
+            auto block = sizeClass.freeList;
+            sizeClass.freeList = block->next;
+            block->next = nullptr;
+            return block;
+        }
+        if (sizeClass.cursor == sizeClass.limit) {
+            size_t usableSize = 0;
+            auto slab = mapSlab(usableSize);
+            if (slab == nullptr) {
+                throw std::bad_alloc();
+            }
+            // slabs live as long as the process
+            sizeClass.cursor = slab;
+            sizeClass.limit = slab + usableSize;
+        }
+        auto block = sizeClass.cursor;
+        sizeClass.cursor += blockSize;
+        return block;
+    }
+#endif
+    return ::operator new(size);
+}
+
+void SecurePool::deallocate(void* pointer, size_t size) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+#ifdef TW_HAVE_MMAP
+    if (size <= maxBlockSize) {
+        const auto index = sizeClassIndex(size);
+        memzero(pointer, minBlockSize << index);
+        auto& sizeClass = sizeClasses[index];
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        auto block = static_cast<FreeBlock*>(pointer);
+        block->next = sizeClass.freeList;
+        sizeClass.freeList = block;
+        return;
+    }
+#endif
+    memzero(pointer, size);
+    ::operator delete(pointer);
+}
+
+size_t SecurePool::slabCount() const noexcept {
+    return slabs;
+}
@@ -0,0 +1,90 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace TW {
+
+/// Pool of memory for key material.
+///
+/// Small allocations are served from fixed-size blocks carved out of slabs which are locked in memory (not swapped
+/// out) once when mapped, surrounded by inaccessible guard pages, and excluded from core dumps where supported.  Freed
+/// blocks are zeroized and kept on a per-size free list.  Larger allocations, and platforms without memory mapping,
+/// fall back to the general heap, still zeroized on release.  Thread-safe.
+class SecurePool {
+public:
+    /// Largest allocation served from slabs.
+    static constexpr size_t maxBlockSize = 1024;
+
+    /// The process-wide pool.
+    static SecurePool& shared();
+
+    /// @throws std::bad_alloc if memory is exhausted.
+    void* allocate(size_t size);
+
+    /// Zeroizes and releases memory obtained from `allocate` with the same size.
+    void deallocate(void* pointer, size_t size) noexcept;
+
+    /// Number of slabs mapped so far, for diagnostics.
+    size_t slabCount() const noexcept;
+
+    SecurePool(const SecurePool&) = delete;
+    SecurePool& operator=(const SecurePool&) = delete;
+
+private:
+    SecurePool() = default;
+};
+
+/// Standard allocator using the secure pool, for containers holding key material.
+template <typename T>
+struct SecureAllocator {
+    using value_type = T;
+
+    SecureAllocator() noexcept = default;
+    template <typename U>
+    SecureAllocator(const SecureAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if (count > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(SecurePool::shared().allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        SecurePool::shared().deallocate(pointer, count * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const SecureAllocator<T>&, const SecureAllocator<U>&) noexcept { return true; }
+
+template <typename T, typename U>
+bool operator!=(const SecureAllocator<T>&, const SecureAllocator<U>&) noexcept { return false; }
+
+/// Byte vector for key material, in the secure pool.
+using SecureData = std::vector<byte, SecureAllocator<byte>>;
+
+inline SecureData secureData(const byte* data, size_t size) {
+    return SecureData(data, data + size);
+}
+
+inline SecureData secureData(const Data& data) {
+    return SecureData(data.begin(), data.end());
+}
+
+/// Copies key material out of the secure pool, for interfaces taking `Data`; the copy is not protected.
+inline Data data(const SecureData& data) {
+    return Data(data.begin(), data.end());
+}
+
+} // namespace TW
@@ -0,0 +1,204 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SigningKey.h"
+#include "Parallel.h"
+
+#include <TrezorCrypto/bignum.h>
+#include <TrezorCrypto/blake2b.h>
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/ed25519-donna/ed25519-blake2b.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/nist256p1.h>
+#include <TrezorCrypto/secp256k1.h>
+#include <TrezorCrypto/sha2.h>
+
+#include <optional>
+#include <stdexcept>
+
+using namespace TW;
+
+namespace {
+
+TWPublicKeyType publicKeyType(TWCurve curve) {
+    switch (curve) {
+    case TWCurveSECP256k1:
+        return TWPublicKeyTypeSECP256k1;
+    case TWCurveNIST256p1:
+        return TWPublicKeyTypeNIST256p1;
+    case TWCurveED25519:
+    case TWCurveED25519HD:
+        return TWPublicKeyTypeED25519;
+    case TWCurveED25519Blake2bNano:
+        return TWPublicKeyTypeED25519Blake2b;
+    case TWCurveED25519Extended:
+        return TWPublicKeyTypeED25519Extended;
+    case TWCurveCurve25519:
+        return TWPublicKeyTypeCURVE25519;
+    case TWCurveNone:
+    default:
+        throw std::invalid_argument("Unsupported curve");
+    }
+}
+
+/// Clamps a hashed Ed25519 seed into a scalar.
+void clamp(SecureData& expanded) {
+    expanded[0] &= 248;
+    expanded[31] &= 127;
+    expanded[31] |= 64;
+}
+
+const ecdsa_curve* ecdsaCurve(TWCurve curve) {
+    switch (curve) {
+    case TWCurveSECP256k1:
+        return &secp256k1;
+    case TWCurveNIST256p1:
+        return &nist256p1;
+    default:
+        return nullptr;
+    }
+}
+
+/// Checks the key for the curve like `PrivateKey::isValid`, without copying it out of secure memory.
+const PrivateKey& validated(const PrivateKey& privateKey, TWCurve curve) {
+    const auto& bytes = privateKey.bytes;
+    if (bytes.size() != PrivateKey::size) {
+        throw std::invalid_argument("Invalid private key for curve");
+    }
+    if (const auto ec = ecdsaCurve(curve)) {
+        bignum256 k;
+        bn_read_be(bytes.data(), &k);
+        const auto valid = bn_is_less(&k, &ec->order);
+        memzero(&k, sizeof(k));
+        if (!valid) {
+            throw std::invalid_argument("Invalid private key for curve");
+        }
+    }
+    return privateKey;
+}
+
+} // namespace
+
+SigningKey::SigningKey(const PrivateKey& privateKey, TWCurve curve)
+    : signingCurve(curve), verifyingKey(validated(privateKey, curve).getPublicKey(publicKeyType(curve))) {
+    const auto& bytes = privateKey.bytes;
+    switch (curve) {
+    case TWCurveSECP256k1:
+    case TWCurveNIST256p1:
+        secret = bytes;
+        break;
+    case TWCurveED25519:
+    case TWCurveED25519HD:
+    case TWCurveCurve25519:
+        secret.resize(SHA512_DIGEST_LENGTH);
+        sha512_Raw(bytes.data(), bytes.size(), secret.data());
+        clamp(secret);
+        break;
+    case TWCurveED25519Blake2bNano:
+        secret.resize(64);
+        blake2b(bytes.data(), static_cast<uint32_t>(bytes.size()), secret.data(), secret.size());
+        clamp(secret);
+        break;
+    case TWCurveED25519Extended:
+        // already expanded, and not clamped, as in `ed25519_sign_ext`
+        secret.reserve(2 * PrivateKey::size);
+        secret.assign(bytes.begin(), bytes.end());
+        secret.insert(secret.end(), privateKey.extensionBytes.begin(), privateKey.extensionBytes.end());
+        break;
+    default:
+        break;
+    }
+
+    switch (curve) {
+    case TWCurveED25519Extended:
+        // the extended public key is followed by the chain code
+        std::copy(verifyingKey.bytes.begin(), verifyingKey.bytes.begin() + PublicKey::ed25519Size,
+                  ed25519PublicKey.begin());
+        break;
+    case TWCurveCurve25519: {
+        const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+        std::copy(publicKey.bytes.begin(), publicKey.bytes.end(), ed25519PublicKey.begin());
+    } break;
+    case TWCurveED25519:
+    case TWCurveED25519HD:
+    case TWCurveED25519Blake2bNano:
+        std::copy(verifyingKey.bytes.begin(), verifyingKey.bytes.end(), ed25519PublicKey.begin());
+        break;
+    default:
+        break;
+    }
+}
+
+size_t SigningKey::signatureSize() const {
+    switch (signingCurve) {
+    case TWCurveSECP256k1:
+    case TWCurveNIST256p1:
+        return 65;
+    default:
+        return 64;
+    }
+}
+
+bool SigningKey::sign(const byte* digest, size_t size, byte* signature) const {
+    switch (signingCurve) {
+    case TWCurveSECP256k1:
+    case TWCurveNIST256p1:
+        if (size < 32) {
+            return false;
+        }
+        return ecdsa_sign_digest(ecdsaCurve(signingCurve), secret.data(), digest, signature, signature + 64,
+                                 nullptr) == 0;
+    case TWCurveED25519:
+    case TWCurveED25519HD:
+    case TWCurveED25519Extended:
+        ed25519_sign_ext(digest, size, secret.data(), secret.data() + 32, ed25519PublicKey.data(), signature);
+        return true;
+    case TWCurveED25519Blake2bNano:
+        ed25519_sign_ext_blake2b(digest, size, secret.data(), secret.data() + 32, ed25519PublicKey.data(),
+                                 signature);
+        return true;
+    case TWCurveCurve25519:
+        ed25519_sign_ext(digest, size, secret.data(), secret.data() + 32, ed25519PublicKey.data(), signature);
+        signature[63] = (signature[63] & 127) | (ed25519PublicKey[31] & 0x80);
+        return true;
+    default:
+        return false;
+    }
+}
+
+Data SigningKey::sign(const Data& digest) const {
+    Data result(signatureSize());
+    if (!sign(digest.data(), digest.size(), result.data())) {
+        return {};
+    }
+    return result;
+}
+
+std::vector<SigningKey> SigningKey::prepareAll(const std::vector<PrivateKey>& privateKeys, TWCurve curve,
+                                               size_t threadCount) {
+    const auto count = privateKeys.size();
+    std::vector<std::optional<SigningKey>> prepared(count);
+    parallelFor(count, [&](size_t i) {
+        prepared[i].emplace(privateKeys[i], curve);
+    }, threadCount == 0 && count < parallelMinCount ? 1 : threadCount);
+
+    std::vector<SigningKey> keys;
+    keys.reserve(count);
+    for (auto& key : prepared) {
+        keys.push_back(std::move(*key));
+    }
+    return keys;
+}
+
+void SigningKey::signAll(const std::vector<SigningRequest>& requests, size_t threadCount) {
+    const auto count = requests.size();
+    parallelFor(count, [&](size_t i) {
+        const auto& request = requests[i];
+        if (!request.key->sign(request.message, request.size, request.signature)) {
+            throw std::invalid_argument("Signing failed");
+        }
+    }, threadCount == 0 && count < parallelMinCount ? 1 : threadCount);
+}
@@ -0,0 +1,86 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+#include "SecureAllocator.h"
+
+#include <TrustWalletCore/TWCurve.h>
+
+#include <array>
+#include <vector>
+
+namespace TW {
+
+class SigningKey;
+
+/// A message to sign with a key, and where to write the signature, for `SigningKey::signAll`.
+struct SigningRequest {
+    const SigningKey* key;
+    const byte* message;
+    size_t size;
+    /// Room for `key->signatureSize()` bytes.
+    byte* signature;
+};
+
+/// A private key prepared for signing many digests on one curve.
+///
+/// The key is validated and the public key computed once.  For the Ed25519 curves the expanded secret (the clamped
+/// scalar and the nonce prefix, hashed from the seed) is kept as well, so that a signature costs a single base point
+/// multiplication instead of three hashes and two multiplications.  Signatures are identical to those of
+/// `PrivateKey::sign`.
+class SigningKey {
+  public:
+    /// Prepares the key for signing on the given curve.
+    ///
+    /// @throws std::invalid_argument if the key is not valid for the curve, or the curve is not supported.
+    SigningKey(const PrivateKey& privateKey, TWCurve curve);
+
+    /// The curve signatures are made on.
+    TWCurve curve() const { return signingCurve; }
+
+    /// The public key signatures are verified with.
+    const PublicKey& publicKey() const { return verifyingKey; }
+
+    /// Signs a digest, same as `PrivateKey::sign(digest, curve)`.
+    Data sign(const Data& digest) const;
+
+    /// Signs size bytes of digest into signature, which must have room for `signatureSize()` bytes.
+    ///
+    /// @returns false if the digest could not be signed.
+    bool sign(const byte* digest, size_t size, byte* signature) const;
+
+    /// Size of the signatures on the curve.
+    size_t signatureSize() const;
+
+    /// Minimum number of keys or requests worth distributing over threads.
+    static constexpr size_t parallelMinCount = 4;
+
+    /// Prepares keys for signing on the given curve, over worker threads (see `parallelFor`).
+    ///
+    /// @throws std::invalid_argument if a key is not valid for the curve.
+    static std::vector<SigningKey> prepareAll(const std::vector<PrivateKey>& privateKeys, TWCurve curve,
+                                              size_t threadCount = 0);
+
+    /// Signs all requests, over worker threads.  Requests must not share signature buffers.  Unless threadCount is
+    /// given, fewer than `parallelMinCount` requests are signed on the calling thread.
+    ///
+    /// @throws std::invalid_argument if a request could not be signed.
+    static void signAll(const std::vector<SigningRequest>& requests, size_t threadCount = 0);
+
+  private:
+    TWCurve signingCurve;
+    /// The private key for ECDSA curves; the scalar and nonce prefix for Ed25519 curves.
+    SecureData secret;
+    /// Ed25519 public key used in the signature hash.
+    std::array<byte, PublicKey::ed25519Size> ed25519PublicKey{};
+    PublicKey verifyingKey;
+};
+
+} // namespace TW
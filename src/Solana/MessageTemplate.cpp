@@ -0,0 +1,162 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "MessageTemplate.h"
+
+#include "../BinaryCoding.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Solana;
+
+namespace {
+
+/// Header bytes: required signatures, read-only signed and read-only unsigned account counts.
+constexpr size_t headerSize = 3;
+
+/// Reads a compact-u16 length at offset, and advances offset past it.
+size_t readShortVecLength(const Data& data, size_t& offset) {
+    size_t length = 0;
+    for (size_t shift = 0; shift < 21; shift += 7) {
+        if (offset >= data.size()) {
+            throw std::invalid_argument("Message data too short");
+        }
+        const auto byte = data[offset++];
+        length |= static_cast<size_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return length;
+        }
+    }
+    throw std::invalid_argument("Invalid length in message data");
+}
+
+/// Advances offset past size bytes.
+void skip(const Data& data, size_t& offset, size_t size) {
+    if (size > data.size() - offset) {
+        throw std::invalid_argument("Message data too short");
+    }
+    offset += size;
+}
+
+} // namespace
+
+MessageTemplate::MessageTemplate(const Message& message)
+    : MessageTemplate(Transaction(message).messageData()) {}
+
+MessageTemplate::MessageTemplate(Data messageData) : messageData(std::move(messageData)) {
+    const auto& data = this->messageData;
+    size_t offset = 0;
+    skip(data, offset, headerSize);
+    accountKeyCount = readShortVecLength(data, offset);
+    if (numRequiredSignatures() > accountKeyCount) {
+        throw std::invalid_argument("More required signatures than accounts");
+    }
+    accountKeysOffset = offset;
+    skip(data, offset, accountKeyCount * Address::size);
+    blockhashOffset = offset;
+    skip(data, offset, Hash::size);
+
+    const auto instructionCount = readShortVecLength(data, offset);
+    instructionData.reserve(instructionCount);
+    for (size_t i = 0; i < instructionCount; ++i) {
+        // program id index, then account indices
+        skip(data, offset, 1);
+        skip(data, offset, readShortVecLength(data, offset));
+        const auto size = readShortVecLength(data, offset);
+        instructionData.emplace_back(offset, size);
+        skip(data, offset, size);
+    }
+    if (offset != data.size()) {
+        throw std::invalid_argument("Extra bytes after message");
+    }
+}
+
+Address MessageTemplate::accountKey(size_t index) const {
+    if (index >= accountKeyCount) {
+        throw std::out_of_range("Account index out of range");
+    }
+    const auto begin = messageData.begin() + accountKeysOffset + index * Address::size;
+    return Address(Data(begin, begin + Address::size));
+}
+
+size_t MessageTemplate::accountIndex(const Address& address) const {
+    auto key = messageData.data() + accountKeysOffset;
+    for (size_t index = 0; index < accountKeyCount; ++index, key += Address::size) {
+        if (std::equal(address.bytes.begin(), address.bytes.end(), key)) {
+            return index;
+        }
+    }
+    return accountKeyCount;
+}
+
+void MessageTemplate::setAccountKey(size_t index, const Address& address) {
+    if (index >= accountKeyCount) {
+        throw std::out_of_range("Account index out of range");
+    }
+    const auto existing = accountIndex(address);
+    if (existing == index) {
+        return;
+    }
+    if (existing != accountKeyCount) {
+        throw std::invalid_argument("Address is already an account of the message");
+    }
+    std::copy(address.bytes.begin(), address.bytes.end(), messageData.begin() + accountKeysOffset + index * Address::size);
+}
+
+void MessageTemplate::setRecentBlockhash(const Hash& blockhash) {
+    std::copy(blockhash.bytes.begin(), blockhash.bytes.end(), messageData.begin() + blockhashOffset);
+}
+
+void MessageTemplate::setInstructionValue(size_t instruction, size_t offset, uint64_t value) {
+    if (instruction >= instructionData.size()) {
+        throw std::out_of_range("Instruction index out of range");
+    }
+    const auto& [dataOffset, dataSize] = instructionData[instruction];
+    if (offset > dataSize || dataSize - offset < sizeof(uint64_t)) {
+        throw std::out_of_range("Value outside of instruction data");
+    }
+    auto destination = messageData.data() + dataOffset + offset;
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+        destination[i] = static_cast<byte>(value >> (8 * i));
+    }
+}
+
+void MessageTemplate::sign(const std::vector<SigningKey>& keys, Data& transaction) const {
+    const auto signatureCount = numRequiredSignatures();
+    transaction.clear();
+    appendShortVecLength(transaction, signatureCount);
+    const auto signaturesOffset = transaction.size();
+    transaction.resize(signaturesOffset + signatureCount * Signature::size);
+    append(transaction, messageData);
+
+    std::vector<SigningRequest> requests;
+    requests.reserve(keys.size());
+    std::vector<bool> signing(signatureCount);
+    for (const auto& key : keys) {
+        if (key.curve() != TWCurveED25519) {
+            throw std::invalid_argument("Solana keys sign on Ed25519");
+        }
+        const auto index = accountIndex(Address(key.publicKey()));
+        if (index >= signatureCount) {
+            throw std::invalid_argument("Key is not a signer of the message");
+        }
+        if (signing[index]) {
+            continue;
+        }
+        signing[index] = true;
+        auto signature = transaction.data() + signaturesOffset + index * Signature::size;
+        requests.push_back({&key, messageData.data(), messageData.size(), signature});
+    }
+    SigningKey::signAll(requests);
+}
+
+Data MessageTemplate::sign(const std::vector<SigningKey>& keys) const {
+    Data transaction;
+    sign(keys, transaction);
+    return transaction;
+}
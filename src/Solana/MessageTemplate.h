@@ -0,0 +1,83 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Address.h"
+#include "Transaction.h"
+#include "../Data.h"
+#include "../SigningKey.h"
+
+#include <utility>
+#include <vector>
+
+namespace TW::Solana {
+
+/// A compiled, serialized message whose variable fields are patched in place.
+///
+/// The message is compiled once (accounts sorted into buckets, instructions indexed); after that the recent blockhash
+/// (or durable nonce), account keys, and 64-bit values inside instruction data such as amounts can be changed without
+/// recompiling or reserializing it.  Signing signs the serialized bytes once per key.  Meant for sending many similar
+/// transactions.
+class MessageTemplate {
+  public:
+    /// Compiles and serializes a message.
+    explicit MessageTemplate(const Message& message);
+
+    /// Uses an already serialized message.
+    ///
+    /// @throws std::invalid_argument if the data is not a well-formed message.
+    explicit MessageTemplate(Data messageData);
+
+    /// The serialized message, as signed.
+    const Data& data() const { return messageData; }
+
+    /// Number of signatures the message requires, made by the first account keys.
+    size_t numRequiredSignatures() const { return messageData[0]; }
+
+    size_t accountCount() const { return accountKeyCount; }
+
+    Address accountKey(size_t index) const;
+
+    /// @returns the index of an account key, or `accountCount()` if it is not in the message.
+    size_t accountIndex(const Address& address) const;
+
+    /// Replaces the account key at index, e.g. the recipient of a transfer.
+    ///
+    /// @throws std::out_of_range if there is no such key.
+    /// @throws std::invalid_argument if the address is already another account key of the message.
+    void setAccountKey(size_t index, const Address& address);
+
+    /// Sets the recent blockhash, which is the nonce value for durable nonce transactions.
+    void setRecentBlockhash(const Hash& blockhash);
+
+    size_t instructionCount() const { return instructionData.size(); }
+
+    /// Sets the little-endian 64-bit value at offset within the data of an instruction, e.g. the amount of a system
+    /// transfer at offset 4, or of a token transfer at offset 1.
+    ///
+    /// @throws std::out_of_range if the instruction data does not hold the value.
+    void setInstructionValue(size_t instruction, size_t offset, uint64_t value);
+
+    /// Signs the message once with each key, and writes the signed transaction (signatures followed by the
+    /// message) into transaction, reusing its storage.  Keys may be in any order; missing signatures are zero.
+    ///
+    /// @throws std::invalid_argument if a key is not on Ed25519 or not a required signer of the message.
+    void sign(const std::vector<SigningKey>& keys, Data& transaction) const;
+
+    /// Signs the message with each key, see `sign(keys, transaction)`.
+    Data sign(const std::vector<SigningKey>& keys) const;
+
+  private:
+    Data messageData;
+    size_t accountKeyCount = 0;
+    size_t accountKeysOffset = 0;
+    size_t blockhashOffset = 0;
+    /// Offset and size of the data of each instruction.
+    std::vector<std::pair<size_t, size_t>> instructionData;
+};
+
+} // namespace TW::Solana
@@ -6,23 +6,36 @@
 
 #include "Signer.h"
 #include "Address.h"
+#include "MessageTemplate.h"
 #include "Program.h"
 #include "../Base58.h"
 #include <TrezorCrypto/ed25519.h>
 
 #include <algorithm>
+#include <stdexcept>
 
 using namespace TW;
 using namespace TW::Solana;
 
 void Signer::sign(const std::vector<PrivateKey>& privateKeys, Transaction& transaction) {
-    for (auto privateKey : privateKeys) {
-        auto address = Address(privateKey.getPublicKey(TWPublicKeyTypeED25519));
-        auto index = transaction.getAccountIndex(address);
-        auto message = transaction.messageData();
-        auto signature = Signature(privateKey.sign(message, TWCurveED25519));
-        transaction.signatures[index] = signature;
+    // all keys sign the same message
+    const auto message = transaction.messageData();
+    const auto keys = SigningKey::prepareAll(privateKeys, TWCurveED25519);
+    std::vector<SigningRequest> requests;
+    requests.reserve(keys.size());
+    std::vector<bool> signing(transaction.signatures.size());
+    for (const auto& key : keys) {
+        auto index = transaction.getAccountIndex(Address(key.publicKey()));
+        if (index >= signing.size()) {
+            throw std::invalid_argument("publicKey is not a signer of the transaction");
+        }
+        if (signing[index]) {
+            continue;
+        }
+        signing[index] = true;
+        requests.push_back({&key, message.data(), message.size(), transaction.signatures[index].bytes.data()});
     }
+    SigningKey::signAll(requests);
 }
 
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
@@ -139,12 +152,14 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
         default:
             assert(input.transaction_type_case() != Proto::SigningInput::TransactionTypeCase::TRANSACTION_TYPE_NOT_SET);
     }
-    auto transaction = Transaction(message);
-
-    sign(signerKeys, transaction);
+    std::vector<SigningKey> signingKeys;
+    for (const auto& signerKey : signerKeys) {
+        signingKeys.emplace_back(signerKey, TWCurveED25519);
+    }
+    const auto transaction = MessageTemplate(message).sign(signingKeys);
 
     auto protoOutput = Proto::SigningOutput();
-    auto encoded = transaction.serialize();
+    auto encoded = Base58::bitcoin.encode(transaction);
     protoOutput.set_encoded(encoded);
 
     return protoOutput;
@@ -159,18 +174,19 @@ void Signer::signUpdateBlockhash(const std::vector<PrivateKey>& privateKeys,
 // This method does not confirm that PrivateKey order matches that encoded in the messageData
 // That order must be correct for the Transaction to succeed on Solana
 Data Signer::signRawMessage(const std::vector<PrivateKey>& privateKeys, const Data messageData) {
-    std::vector<Signature> signatures;
-    for (auto privateKey : privateKeys) {
-        auto signature = Signature(privateKey.sign(messageData, TWCurveED25519));
-        signatures.push_back(signature);
-    }
+    const auto keys = SigningKey::prepareAll(privateKeys, TWCurveED25519);
     Data buffer;
-    append(buffer, shortVecLength<Signature>(signatures));
-    for (auto signature : signatures) {
-        Data signature_vec(signature.bytes.begin(), signature.bytes.end());
-        append(buffer, signature_vec);
-    }
+    appendShortVecLength(buffer, keys.size());
+    const auto signaturesOffset = buffer.size();
+    buffer.resize(signaturesOffset + keys.size() * Signature::size);
     append(buffer, messageData);
 
+    std::vector<SigningRequest> requests;
+    requests.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto signature = buffer.data() + signaturesOffset + i * Signature::size;
+        requests.push_back({&keys[i], messageData.data(), messageData.size(), signature});
+    }
+    SigningKey::signAll(requests);
     return buffer;
 }
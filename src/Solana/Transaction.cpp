@@ -87,40 +87,43 @@ void Message::compileInstructions() {
 }
 
 std::string Transaction::serialize() const {
+    const auto message = messageData();
     Data buffer;
+    buffer.reserve(3 + signatures.size() * Signature::size + message.size());
 
-    append(buffer, shortVecLength<Signature>(this->signatures));
-    for (auto signature : this->signatures) {
-        Data signature_vec(signature.bytes.begin(), signature.bytes.end());
-        append(buffer, signature_vec);
+    appendShortVecLength(buffer, signatures.size());
+    for (const auto& signature : signatures) {
+        buffer.insert(buffer.end(), signature.bytes.begin(), signature.bytes.end());
     }
-    append(buffer, this->messageData());
+    append(buffer, message);
 
     return Base58::bitcoin.encode(buffer);
 }
 
 Data Transaction::messageData() const {
+    size_t size = 3 + 3 + message.accountKeys.size() * Address::size + Hash::size + 3;
+    for (const auto& instruction : message.compiledInstructions) {
+        size += 1 + 3 + instruction.accounts.size() + 3 + instruction.data.size();
+    }
     Data buffer;
+    buffer.reserve(size);
 
     buffer.push_back(this->message.header.numRequiredSignatures);
     buffer.push_back(this->message.header.numCreditOnlySignedAccounts);
     buffer.push_back(this->message.header.numCreditOnlyUnsignedAccounts);
-    append(buffer, shortVecLength<Address>(this->message.accountKeys));
-    for (auto account_key : this->message.accountKeys) {
-        Data account_key_vec(account_key.bytes.begin(), account_key.bytes.end());
-        append(buffer, account_key_vec);
+    appendShortVecLength(buffer, message.accountKeys.size());
+    for (const auto& account_key : this->message.accountKeys) {
+        buffer.insert(buffer.end(), account_key.bytes.begin(), account_key.bytes.end());
     }
-    Data recentBlockhash(this->message.recentBlockhash.bytes.begin(),
-                         this->message.recentBlockhash.bytes.end());
-    append(buffer, recentBlockhash);
+    buffer.insert(buffer.end(), this->message.recentBlockhash.bytes.begin(), this->message.recentBlockhash.bytes.end());
 
     // apppend compiled instructions
-    append(buffer, shortVecLength<CompiledInstruction>(message.compiledInstructions));
-    for (auto instruction : message.compiledInstructions) {
+    appendShortVecLength(buffer, message.compiledInstructions.size());
+    for (const auto& instruction : message.compiledInstructions) {
         buffer.push_back(instruction.programIdIndex);
-        append(buffer, shortVecLength<uint8_t>(instruction.accounts));
+        appendShortVecLength(buffer, instruction.accounts.size());
         append(buffer, instruction.accounts);
-        append(buffer, shortVecLength<uint8_t>(instruction.data));
+        appendShortVecLength(buffer, instruction.data.size());
         append(buffer, instruction.data);
     }
 
@@ -29,21 +29,19 @@ const std::string STAKE_CONFIG_ID_ADDRESS = "StakeConfig111111111111111111111111
 const std::string NULL_ID_ADDRESS = "11111111111111111111111111111111";
 const std::string SYSVAR_STAKE_HISTORY_ID_ADDRESS = "SysvarStakeHistory1111111111111111111111111";
 
+/// Appends a length in the compact-u16 encoding: 7 bits per byte, high bit set on all but the last byte.
+inline void appendShortVecLength(Data& data, size_t length) {
+    while (length >= 0x80) {
+        data.push_back(static_cast<uint8_t>(length & 0x7f) | 0x80);
+        length >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(length));
+}
+
 template <typename T>
-Data shortVecLength(std::vector<T> vec) {
+Data shortVecLength(const std::vector<T>& vec) {
     auto bytes = Data();
-    auto remLen = vec.size();
-    while (true) {
-        uint8_t elem = remLen & 0x7f;
-        remLen >>= 7;
-        if (remLen == 0) {
-            bytes.push_back(elem);
-            break;
-        } else {
-            elem |= 0x80;
-            bytes.push_back(elem);
-        }
-    }
+    appendShortVecLength(bytes, vec.size());
     return bytes;
 }
 
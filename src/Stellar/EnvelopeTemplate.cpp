@@ -0,0 +1,66 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "EnvelopeTemplate.h"
+#include "Address.h"
+#include "Signer.h"
+#include "../Base64.h"
+#include "../BinaryCoding.h"
+#include "../Hash.h"
+
+using namespace TW;
+using namespace TW::Stellar;
+
+/// Envelope type of transactions.
+static const uint32_t envelopeTypeTx = 2;
+
+/// Size of the network ID and envelope type preceding the transaction in the payload.
+static const size_t headerSize = 32 + 4;
+
+static const size_t signatureSize = 64;
+
+EnvelopeTemplate::EnvelopeTemplate(const Proto::SigningInput& input)
+    : key(PrivateKey(Data(input.private_key().begin(), input.private_key().end())), TWCurveED25519) {
+    const auto transaction = Signer(input).encode(input);
+    payload.reserve(headerSize + transaction.size());
+    append(payload, Signer::networkId(input.passphrase()));
+    encode32BE(envelopeTypeTx, payload);
+    append(payload, transaction);
+
+    const auto account = Address(input.account());
+    std::copy(account.bytes.end() - hint.size(), account.bytes.end(), hint.begin());
+}
+
+Data EnvelopeTemplate::transaction() const {
+    return Data(payload.begin() + headerSize, payload.end());
+}
+
+void EnvelopeTemplate::setSequence(uint64_t sequence) {
+    auto destination = payload.data() + headerSize + sequenceOffset;
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+        destination[i] = static_cast<byte>(sequence >> (8 * (7 - i)));
+    }
+}
+
+void EnvelopeTemplate::sign(Data& envelope) const {
+    const auto hash = Hash::sha256(payload);
+
+    envelope.clear();
+    envelope.reserve(payload.size() - headerSize + 12 + signatureSize);
+    envelope.insert(envelope.end(), payload.begin() + headerSize, payload.end());
+    encode32BE(1, envelope); // signature count
+    envelope.insert(envelope.end(), hint.begin(), hint.end());
+    encode32BE(static_cast<uint32_t>(signatureSize), envelope);
+    const auto signatureOffset = envelope.size();
+    envelope.resize(signatureOffset + signatureSize);
+    key.sign(hash.data(), hash.size(), envelope.data() + signatureOffset);
+}
+
+std::string EnvelopeTemplate::sign() const {
+    Data envelope;
+    sign(envelope);
+    return Base64::encode(envelope);
+}
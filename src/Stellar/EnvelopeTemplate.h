@@ -0,0 +1,51 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Data.h"
+#include "../SigningKey.h"
+#include "../proto/Stellar.pb.h"
+
+#include <array>
+#include <string>
+
+namespace TW::Stellar {
+
+/// Signed transaction envelopes built repeatedly from one transaction, e.g. for payments that differ only by
+/// sequence number.
+///
+/// The transaction is encoded once, after the network ID and envelope type it is signed with, and the signing key
+/// and signature hint are prepared once; the sequence number is patched in place before each signature.  Envelopes
+/// are the same as `Signer`'s.
+class EnvelopeTemplate {
+  public:
+    /// Offset of the sequence number in an encoded transaction: after the account and fee.
+    static const size_t sequenceOffset = 40;
+
+    /// Encodes the transaction of input, for the network of its passphrase.
+    explicit EnvelopeTemplate(const Proto::SigningInput& input);
+
+    /// Returns the encoded transaction.
+    Data transaction() const;
+
+    void setSequence(uint64_t sequence);
+
+    /// Signs, and writes the XDR envelope into envelope, reusing its storage.
+    void sign(Data& envelope) const;
+
+    /// Signs, and returns the base64 XDR envelope.
+    std::string sign() const;
+
+  private:
+    SigningKey key;
+    /// Network ID, envelope type and transaction: the data hashed for signing.
+    Data payload;
+    /// Last bytes of the account public key.
+    std::array<byte, 4> hint;
+};
+
+} // namespace TW::Stellar
@@ -6,6 +6,7 @@
 
 #include "Base64.h"
 #include "Signer.h"
+#include "EnvelopeTemplate.h"
 #include "../BinaryCoding.h"
 #include "../Hash.h"
 #include "../HexCoding.h"
@@ -13,9 +14,17 @@
 
 #include <TrustWalletCore/TWStellarMemoType.h>
 
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
 using namespace TW;
 using namespace TW::Stellar;
 
+static const size_t memoTextMaxSize = 28;
+static const size_t memoHashSize = 32;
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto signer = Signer(input);
     auto output = Proto::SigningOutput();
@@ -24,38 +33,27 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 }
 
 std::string Signer::sign() const noexcept {
+    return EnvelopeTemplate(input).sign();
+}
 
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    auto account = Address(input.account());
-    auto encoded = encode(input);
-
-    auto encodedWithHeaders = Data();
-    auto publicNetwork = input.passphrase(); // Header
-    auto passphrase = Hash::sha256(publicNetwork);
-    encodedWithHeaders.insert(encodedWithHeaders.end(), passphrase.begin(), passphrase.end());
-    auto transactionType = Data{0, 0, 0, 2}; // Header
-    encodedWithHeaders.insert(encodedWithHeaders.end(), transactionType.begin(),
-                              transactionType.end());
-    encodedWithHeaders.insert(encodedWithHeaders.end(), encoded.begin(), encoded.end());
-
-    auto hash = Hash::sha256(encodedWithHeaders);
-    auto data = Data(hash.begin(), hash.end());
-
-    auto sign = key.sign(data, TWCurveED25519);
-
-    auto signature = Data();
-    signature.insert(signature.end(), encoded.begin(), encoded.end());
-    encode32BE(1, signature);
-    signature.insert(signature.end(), account.bytes.end() - 4, account.bytes.end());
-    encode32BE(static_cast<uint32_t>(sign.size()), signature);
-    signature.insert(signature.end(), sign.begin(), sign.end());
-    return Base64::encode(signature);
+const Data& Signer::networkId(const std::string& passphrase) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, Data> networkIds;
+
+    const auto lock = std::lock_guard<std::mutex>(mutex);
+    auto it = networkIds.find(passphrase);
+    if (it == networkIds.end()) {
+        it = networkIds.emplace(passphrase, Hash::sha256(passphrase)).first;
+    }
+    // references to unordered_map elements stay valid as it grows
+    return it->second;
 }
 
 Data Signer::encode(const Proto::SigningInput& input) const {
     //    Address account, uint32_t fee, uint64_t sequence, uint32_t memoType,
     //    Data memoData, Address destination, uint64_t amount;
     auto data = Data();
+    data.reserve(256);
 
     encodeAddress(Address(input.account()), data);
     encode32BE(input.fee(), data);
@@ -76,9 +74,8 @@ Data Signer::encode(const Proto::SigningInput& input) const {
         encode64BE(input.memo_id().id(), data);
     } else if (input.has_memo_text()) {
         encode32BE(TWStellarMemoTypeText, data);
-        encode32BE(static_cast<uint32_t>(input.memo_text().text().size()), data);
-        data.insert(data.end(), input.memo_text().text().begin(), input.memo_text().text().end());
-        pad(data);
+        const auto& text = input.memo_text().text();
+        encodeVariableOpaque(reinterpret_cast<const byte*>(text.data()), text.size(), data);
     } else if (input.has_memo_hash()) {
         encode32BE(TWStellarMemoTypeHash, data);
         data.insert(data.end(), input.memo_hash().hash().begin(), input.memo_hash().hash().end());
@@ -155,13 +152,111 @@ void Signer::encodeAsset(const Proto::Asset& asset, Data& data) {
     }
 }
 
-void Signer::pad(Data& data) const {
-    int pad = 0;
-    int mod = static_cast<int>(data.size() % 4);
-    if (mod > 0) {
-        pad = 4 - mod;
+Proto::SigningInput Signer::decode(const Data& transaction) {
+    auto input = Proto::SigningInput();
+    auto reader = XDRReader(transaction);
+
+    input.set_account(decodeAddress(reader));
+    input.set_fee(static_cast<int32_t>(reader.readUInt32()));
+    input.set_sequence(static_cast<int64_t>(reader.readUInt64()));
+
+    // Time bounds
+    uint64_t validBefore = 0;
+    if (reader.readBool()) {
+        if (reader.readUInt64() != 0) {
+            throw std::invalid_argument("Unsupported time bounds");
+        }
+        validBefore = reader.readUInt64();
+    }
+
+    // Memo
+    switch (reader.readUInt32()) {
+        case TWStellarMemoTypeNone:
+            break;
+        case TWStellarMemoTypeText:
+            input.mutable_memo_text()->set_text(reader.readString(memoTextMaxSize));
+            break;
+        case TWStellarMemoTypeId:
+            input.mutable_memo_id()->set_id(static_cast<int64_t>(reader.readUInt64()));
+            break;
+        case TWStellarMemoTypeHash: {
+            const auto hash = reader.readFixedOpaque(memoHashSize);
+            input.mutable_memo_hash()->set_hash(hash.data(), hash.size());
+            break;
+        }
+        case TWStellarMemoTypeReturn: {
+            const auto hash = reader.readFixedOpaque(memoHashSize);
+            input.mutable_memo_return_hash()->set_hash(hash.data(), hash.size());
+            break;
+        }
+        default:
+            throw std::invalid_argument("Invalid memo type");
+    }
+
+    // Operations
+    if (reader.readUInt32() != 1) {
+        throw std::invalid_argument("Only transactions with one operation are supported");
     }
-    while (pad-- > 0) {
-        data.insert(data.end(), 0);
+    if (reader.readBool()) {
+        throw std::invalid_argument("Operation source accounts are not supported");
+    }
+    switch (reader.readUInt32()) {
+        case 0: {
+            auto operation = input.mutable_op_create_account();
+            operation->set_destination(decodeAddress(reader));
+            operation->set_amount(static_cast<int64_t>(reader.readUInt64()));
+            break;
+        }
+        case 1: {
+            auto operation = input.mutable_op_payment();
+            operation->set_destination(decodeAddress(reader));
+            decodeAsset(reader, *operation->mutable_asset());
+            operation->set_amount(static_cast<int64_t>(reader.readUInt64()));
+            break;
+        }
+        case 6: {
+            auto operation = input.mutable_op_change_trust();
+            decodeAsset(reader, *operation->mutable_asset());
+            if (reader.readUInt64() != 0x7fffffffffffffff) {
+                throw std::invalid_argument("Only the maximum trust limit is supported");
+            }
+            operation->set_valid_before(static_cast<int64_t>(validBefore));
+            break;
+        }
+        default:
+            throw std::invalid_argument("Unsupported operation type");
+    }
+    if (validBefore != 0 && !input.has_op_change_trust()) {
+        throw std::invalid_argument("Time bounds are only supported for change trust operations");
+    }
+
+    // Ext
+    if (reader.readUInt32() != 0 || !reader.atEnd()) {
+        throw std::invalid_argument("Extra data after transaction");
+    }
+    return input;
+}
+
+std::string Signer::decodeAddress(XDRReader& reader) {
+    if (reader.readUInt32() != 0) {
+        throw std::invalid_argument("Only Ed25519 account keys are supported");
+    }
+    const auto key = reader.readFixedOpaque(PublicKey::ed25519Size);
+    return Address(PublicKey(key, TWPublicKeyTypeED25519)).string();
+}
+
+void Signer::decodeAsset(XDRReader& reader, Proto::Asset& asset) {
+    switch (reader.readUInt32()) {
+        case 0: // native
+            break;
+        case 1: { // alphanum4
+            auto code = reader.readFixedOpaque(4);
+            code.erase(std::find(code.begin(), code.end(), 0), code.end());
+            asset.set_alphanum4(std::string(code.begin(), code.end()));
+            asset.set_issuer(decodeAddress(reader));
+            break;
+        }
+        default:
+            throw std::invalid_argument("Unsupported asset type");
     }
 }
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "Address.h"
+#include "XDR.h"
 #include "../Data.h"
 #include "../Hash.h"
 #include "../PrivateKey.h"
@@ -14,7 +15,7 @@
 #include <string>
 
 namespace TW::Stellar {
-/// Helper class that performs Ripple transaction signing.
+/// Helper class that performs Stellar transaction signing.
 class Signer {
   public:
     /// Signs a Proto::SigningInput transaction
@@ -29,11 +30,21 @@ class Signer {
 
     Data encode(const Proto::SigningInput& input) const;
 
+    /// Decodes a transaction as encoded by `encode`, e.g. to check a transaction returned by a server before
+    /// signing it.  The private key and passphrase are left empty.
+    ///
+    /// @throws std::invalid_argument if the transaction is malformed or uses features `encode` does not produce.
+    static Proto::SigningInput decode(const Data& transaction);
+
+    /// Returns the network ID, the hash of passphrase.  Hashes are cached, as each signature needs one.
+    static const Data& networkId(const std::string& passphrase);
+
   private:
     static uint32_t operationType(const Proto::SigningInput& input);
     static void encodeAddress(const Address& address, Data& data);
     static void encodeAsset(const Proto::Asset& asset, Data& data);
-    void pad(Data& data) const;
+    static std::string decodeAddress(XDRReader& reader);
+    static void decodeAsset(XDRReader& reader, Proto::Asset& asset);
 };
 
 } // namespace TW::Stellar
@@ -0,0 +1,68 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "XDR.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Stellar;
+
+uint32_t XDRReader::readUInt32() {
+    if (data.size() - offset < 4) {
+        throw std::invalid_argument("XDR data too short");
+    }
+    const auto value = decode32BE(data.data() + offset);
+    offset += 4;
+    return value;
+}
+
+uint64_t XDRReader::readUInt64() {
+    if (data.size() - offset < 8) {
+        throw std::invalid_argument("XDR data too short");
+    }
+    const auto value = decode64BE(data.data() + offset);
+    offset += 8;
+    return value;
+}
+
+bool XDRReader::readBool() {
+    switch (readUInt32()) {
+    case 0:
+        return false;
+    case 1:
+        return true;
+    default:
+        throw std::invalid_argument("Invalid XDR boolean");
+    }
+}
+
+Data XDRReader::readFixedOpaque(size_t size) {
+    const auto padded = (size + 3) & ~size_t(3);
+    if (data.size() - offset < padded) {
+        throw std::invalid_argument("XDR data too short");
+    }
+    const auto begin = data.begin() + offset;
+    if (std::any_of(begin + size, begin + padded, [](byte b) { return b != 0; })) {
+        throw std::invalid_argument("Invalid XDR padding");
+    }
+    offset += padded;
+    return Data(begin, begin + size);
+}
+
+Data XDRReader::readVariableOpaque(size_t maxSize) {
+    const auto size = readUInt32();
+    if (size > maxSize) {
+        throw std::invalid_argument("XDR opaque data too long");
+    }
+    return readFixedOpaque(size);
+}
+
+std::string XDRReader::readString(size_t maxSize) {
+    const auto bytes = readVariableOpaque(maxSize);
+    return std::string(bytes.begin(), bytes.end());
+}
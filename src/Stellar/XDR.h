@@ -0,0 +1,63 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../BinaryCoding.h"
+#include "../Data.h"
+
+#include <string>
+
+namespace TW::Stellar {
+
+// XDR (RFC 4506) encoding, as used by Stellar transactions: big endian 32 and 64-bit integers, and opaque data
+// padded to a multiple of 4 bytes.
+
+/// Appends zeros until the size of data is a multiple of 4.
+inline void encodePadding(Data& data) {
+    data.resize((data.size() + 3) & ~size_t(3));
+}
+
+/// Encodes fixed length opaque data.
+inline void encodeFixedOpaque(const byte* bytes, size_t size, Data& data) {
+    data.insert(data.end(), bytes, bytes + size);
+    encodePadding(data);
+}
+
+/// Encodes variable length opaque data, or a string.
+inline void encodeVariableOpaque(const byte* bytes, size_t size, Data& data) {
+    encode32BE(static_cast<uint32_t>(size), data);
+    encodeFixedOpaque(bytes, size, data);
+}
+
+/// Reads XDR values from encoded data.  Each read advances the offset, and throws std::invalid_argument if the data
+/// is too short or a value is invalid.
+class XDRReader {
+  public:
+    explicit XDRReader(const Data& data, size_t offset = 0) : data(data), offset(offset) {}
+
+    size_t position() const { return offset; }
+    bool atEnd() const { return offset == data.size(); }
+
+    uint32_t readUInt32();
+    uint64_t readUInt64();
+    bool readBool();
+
+    /// Reads fixed length opaque data, and its padding.
+    Data readFixedOpaque(size_t size);
+
+    /// Reads variable length opaque data of up to maxSize bytes, and its padding.
+    Data readVariableOpaque(size_t maxSize);
+
+    /// Reads a string of up to maxSize bytes.
+    std::string readString(size_t maxSize);
+
+  private:
+    const Data& data;
+    size_t offset;
+};
+
+} // namespace TW::Stellar
@@ -10,6 +10,7 @@
 
 #include <boost/crc.hpp>  // for boost::crc_32_type
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <memory>
@@ -166,10 +167,86 @@ Data Slice::hash() const {
 }
 
 
-Cell::Cell(const Cell& from) : _cells(from._cells), _slice(from._slice) {}
+/// Compute the representation hash of an ordinary cell from its data and the depths and hashes of its children
+static Data reprHash(const byte* data, size_t dataSize, size_t sizeBits, size_t refCount, const uint16_t* childDepths, const byte* const* childHashes) {
+    // Need to copy data together into a contiguous area
+    Data hashData;
+    hashData.reserve(2 + dataSize + refCount * (2 + 32));
+    // number of children
+    hashData.push_back(static_cast<byte>(refCount));
+    // number of hex digits
+    hashData.push_back(Cell::d2(sizeBits));
+    // data
+    hashData.insert(hashData.end(), data, data + dataSize);
+    // children: depths, then hashes
+    for (size_t i = 0; i < refCount; ++i) {
+        hashData.push_back(static_cast<byte>(childDepths[i] >> 8));
+        hashData.push_back(static_cast<byte>(childDepths[i] & 0xFF));
+    }
+    for (size_t i = 0; i < refCount; ++i) {
+        hashData.insert(hashData.end(), childHashes[i], childHashes[i] + 32);
+    }
+    // compute hash
+    return Hash::sha256(hashData);
+}
+
+/// Append an unsigned value as big-endian, on the given number of bytes
+static void appendBE(Data& data_inout, uint64_t value, size_t bytes) {
+    for (size_t i = bytes; i > 0; --i) {
+        data_inout.push_back(static_cast<byte>(value >> ((i - 1) * 8)));
+    }
+}
+
+Cell::Cell(const Cell& from) : _cells(from._cells), _slice(from._slice), _hash(from._hash), _depth(from._depth) {
+    attachChildren();
+}
+
+Cell& Cell::operator=(const Cell& from) {
+    if (this == &from) {
+        return *this;
+    }
+    detachChildren();
+    _cells = from._cells;
+    _slice = from._slice;
+    attachChildren();
+    invalidate();
+    _hash = from._hash;
+    _depth = from._depth;
+    return *this;
+}
+
+Cell::~Cell() {
+    detachChildren();
+}
+
+void Cell::attachChildren() {
+    for (auto& c: _cells) {
+        c->_parents.push_back(this);
+    }
+}
+
+void Cell::detachChildren() {
+    for (auto& c: _cells) {
+        auto& parents = c->_parents;
+        parents.erase(std::remove(parents.begin(), parents.end(), this), parents.end());
+    }
+}
+
+void Cell::invalidate() {
+    if (_hash.empty()) {
+        // not cached; then no cell referring to it can be cached either
+        return;
+    }
+    _hash.clear();
+    _depth = 0;
+    for (auto p: _parents) {
+        p->invalidate();
+    }
+}
 
 void Cell::setSlice(Slice const& slice) {
     _slice = slice;
+    invalidate();
 }
 
 void Cell::setSliceBytes(const Data& data) {
@@ -192,6 +269,8 @@ void Cell::addCell(std::shared_ptr<Cell> const& cell) {
         throw std::runtime_error("too many cells");
     }
     _cells.push_back(cell);
+    cell->_parents.push_back(this);
+    invalidate();
 }
 
 std::string Cell::toString() const {
@@ -214,68 +293,26 @@ std::string Cell::toString() const {
     return s.str();
 }
 
-Data Cell::hash() const {
-    // Need to copy data together into a contiguous area
-    Data hashData;
-    // number of children
-    hashData.push_back(static_cast<byte>(cellCount()));
-    // number of hex digits
-    size_t bits = _slice.sizeBits(); // may be 0
-    hashData.push_back(d2(bits));
-    // data
-    if (_slice.size() > 0) {
-        append(hashData, _slice.data());
-    }
-    // children
-    if (cellCount() > 0) {
-        for (auto i = _cells.begin(), n = _cells.end(); i != n; ++i) {
-            hashData.push_back(0);
-            hashData.push_back(0);
-        }
-        for (auto i = _cells.begin(), n = _cells.end(); i != n; ++i) {
-            auto childHash = i->get()->hash();
-            append(hashData, childHash);
-        }
+const Data& Cell::hash() const {
+    if (!_hash.empty()) {
+        return _hash;
     }
-    // compute hash
-    return Hash::sha256(hashData);
-}
-
-Cell::SerializationInfo Cell::getSerializationInfo(SerializationMode mode) const {
-    SerializationInfo info = SerializationInfo();
-    size_t rawDataSize = serializedOwnSize();
-    for (auto c: _cells) {
-        rawDataSize += c->serializedOwnSize();
+    uint16_t childDepths[max_cells];
+    const byte* childHashes[max_cells];
+    uint16_t depth = 0;
+    for (size_t i = 0; i < cellCount(); ++i) {
+        childHashes[i] = _cells[i]->hash().data();
+        childDepths[i] = _cells[i]->_depth;
+        depth = std::max(depth, static_cast<uint16_t>(childDepths[i] + 1));
     }
-    int intRefs = (int)cellCount();
-    uint8_t refSize = 1;
-    while (cellCount() >= ((size_t)1 << (refSize * 8))) { ++refSize; }
-    assert(refSize >= 1 && refSize <= 8);
-    size_t hashes = 0;
-    size_t dataBytesAdj = rawDataSize + (size_t)intRefs * refSize + hashes;
-    size_t maxOffset = (mode & SerializationMode::WithCacheBits) ? dataBytesAdj * 2 : dataBytesAdj;
-    int offsetSize = 0;
-    while (maxOffset >= (1ULL << (offsetSize * 8))) { ++offsetSize; }
-    if (refSize > 4 || offsetSize > 8) { return info; }
+    _hash = reprHash(_slice.data().data(), _slice.size(), _slice.sizeBits(), cellCount(), childDepths, childHashes);
+    _depth = depth;
+    return _hash;
+}
 
-    info.refByteSize = refSize;
-    info.offsetByteSize = 1;
-    info.rootCount = 1;
-    info.cellCount = info.rootCount + (int)cellCount();  // including self/roots
-    info.hasCrc32c = mode & SerializationMode::WithCRC32C;
-    int crcSize = info.hasCrc32c ? 4 : 0;
-    int rootCount = 0;
-    unsigned long rootsOffset = 4 + 1 + 1 + 3 * info.refByteSize + info.offsetByteSize;
-    unsigned long indexOffset = rootsOffset + rootCount * info.refByteSize;
-    unsigned long dataOffset = indexOffset;
-    //if (info.has_index) {
-        //info.data_offset += (long long)cell_count * info.offset_byte_size;
-    //}
-    // Magic num idx 68ff65f3  idxCrc32c acc3a728  generic b5ee9c72
-    info.magic = parse_hex("b5ee9c72");
-    info.dataSize = dataBytesAdj;
-    info.totalSize = dataOffset + dataBytesAdj + crcSize;
-    return info;
+uint16_t Cell::depth() const {
+    hash();
+    return _depth;
 }
 
 size_t Cell::serializedOwnSize(bool withHashes) const {
@@ -284,30 +321,13 @@ size_t Cell::serializedOwnSize(bool withHashes) const {
 }
 
 size_t Cell::serializedSize(SerializationMode mode) const {
-    auto info = getSerializationInfo(mode);
-    size_t ss = 0;
-    ss += 4; // magic
-    ss += 5; // byte1, offsetByteSize, cellCount, rootCount, 
-    ss += info.offsetByteSize; // dataSize
-    ss += info.rootCount; // roots
-
-    ss += serializedOwnSize(false);
-    ss += cellCount(); // cell refs
-
-    // child cells
-    for(auto c: _cells) {
-        ss += c->serializedOwnSize(false);
-    }
-
-    if (mode & SerializationMode::WithCRC32C) {
-        ss += 4;
-    }
-    return ss;
+    CellArena arena;
+    auto root = arena.add(*this);
+    return arena.serializedSize(root, mode);
 }
 
 void Cell::serializeOwn(TW::Data& data_inout, bool withHashes) {
     if (withHashes) { throw std::invalid_argument("Cell::serializedOwnSize: WithHashes not supported"); }
-    //auto info = getSerializationInfo(mode);
     // slice
     data_inout.push_back((byte)cellCount());
     data_inout.push_back(d2(_slice.sizeBits()));
@@ -315,12 +335,159 @@ void Cell::serializeOwn(TW::Data& data_inout, bool withHashes) {
 }
 
 void Cell::serialize(TW::Data& data_inout, SerializationMode mode) {
-    if (mode != SerializationMode::None && mode != SerializationMode::WithCRC32C) {
+    CellArena arena;
+    auto root = arena.add(*this);
+    arena.serialize(root, data_inout, mode);
+}
+
+CellArena::Index CellArena::add(const Slice& slice, const std::vector<Index>& refs) {
+    if (refs.size() > Cell::max_cells) {
+        throw std::runtime_error("too many cells");
+    }
+    uint16_t childDepths[Cell::max_cells];
+    const byte* childHashes[Cell::max_cells];
+    for (size_t i = 0; i < refs.size(); ++i) {
+        if (refs[i] >= size()) {
+            throw std::invalid_argument("invalid cell reference");
+        }
+        childDepths[i] = _cells[refs[i]].depth;
+        childHashes[i] = _hashes.data() + refs[i] * 32;
+    }
+    auto hash = reprHash(slice.data().data(), slice.size(), slice.sizeBits(), refs.size(), childDepths, childHashes);
+    return insert(slice, refs, hash);
+}
+
+CellArena::Index CellArena::add(const Cell& cell) {
+    // hash is cached in the cell, identical (shared) subtrees are imported only once
+    const auto& hash = cell.hash();
+    auto existing = _byHash.find(hash);
+    if (existing != _byHash.end()) {
+        return existing->second;
+    }
+    const auto& cells = cell.getCells();
+    std::vector<Index> refs(cells.size());
+    // children in reverse order, so that they end up in the original order after serialization
+    for (size_t i = cells.size(); i > 0; --i) {
+        refs[i - 1] = add(*cells[i - 1]);
+    }
+    return insert(cell.getSlice(), refs, hash);
+}
+
+CellArena::Index CellArena::insert(const Slice& slice, const std::vector<Index>& refs, const Data& hash) {
+    auto existing = _byHash.find(hash);
+    if (existing != _byHash.end()) {
+        return existing->second;
+    }
+    assert(refs.size() <= Cell::max_cells);
+    assert(hash.size() == 32);
+    Entry entry;
+    entry.dataOffset = static_cast<uint32_t>(_data.size());
+    entry.dataSize = static_cast<uint16_t>(slice.size());
+    entry.sizeBits = static_cast<uint16_t>(slice.sizeBits());
+    entry.refCount = static_cast<uint8_t>(refs.size());
+    entry.depth = 0;
+    for (size_t i = 0; i < refs.size(); ++i) {
+        entry.refs[i] = refs[i];
+        entry.depth = std::max(entry.depth, static_cast<uint16_t>(_cells[refs[i]].depth + 1));
+    }
+    append(_data, slice.data());
+    append(_hashes, hash);
+    auto index = static_cast<Index>(_cells.size());
+    _cells.push_back(entry);
+    _byHash.emplace(hash, index);
+    return index;
+}
+
+Data CellArena::hash(Index index) const {
+    if (index >= size()) {
+        throw std::invalid_argument("invalid cell index");
+    }
+    return TW::data(_hashes.data() + index * 32, 32);
+}
+
+CellArena::Index CellArena::ref(Index index, size_t i) const {
+    const auto& entry = _cells.at(index);
+    if (i >= entry.refCount) {
+        throw std::invalid_argument("invalid cell reference");
+    }
+    return entry.refs[i];
+}
+
+std::vector<CellArena::Index> CellArena::collect(Index root) const {
+    if (root >= size()) {
+        throw std::invalid_argument("invalid cell index");
+    }
+    // references always point to lower indices, so a single descending pass visits
+    // every reachable cell after all cells referring to it
+    std::vector<bool> reachable(root + 1, false);
+    reachable[root] = true;
+    std::vector<Index> order;
+    for (size_t i = root + 1; i > 0; --i) {
+        auto index = static_cast<Index>(i - 1);
+        if (!reachable[index]) {
+            continue;
+        }
+        order.push_back(index);
+        const auto& entry = _cells[index];
+        for (size_t r = 0; r < entry.refCount; ++r) {
+            reachable[entry.refs[r]] = true;
+        }
+    }
+    return order;
+}
+
+Cell::SerializationInfo CellArena::getSerializationInfo(Index root, Cell::SerializationMode mode) const {
+    Cell::SerializationInfo info = Cell::SerializationInfo();
+    auto order = collect(root);
+    size_t cellCount = order.size();
+    int refSize = 1;
+    while (cellCount >= ((size_t)1 << (refSize * 8))) { ++refSize; }
+    size_t dataSize = 0;
+    for (auto index: order) {
+        dataSize += ownSize(index) + _cells[index].refCount * refSize;
+    }
+    size_t maxOffset = (mode & Cell::SerializationMode::WithCacheBits) ? dataSize * 2 : dataSize;
+    int offsetSize = 0;
+    while (maxOffset >= (1ULL << (offsetSize * 8))) { ++offsetSize; }
+    if (refSize > 4 || offsetSize > 8) { return info; }
+
+    info.refByteSize = refSize;
+    info.offsetByteSize = offsetSize;
+    info.rootCount = 1;
+    info.cellCount = (int)cellCount;  // including roots
+    info.hasCrc32c = mode & Cell::SerializationMode::WithCRC32C;
+    int crcSize = info.hasCrc32c ? 4 : 0;
+    // magic, flags/refSize, offsetSize, cell/root/absent counts, total cells size, root list
+    unsigned long dataOffset = 4 + 1 + 1 + 3 * info.refByteSize + info.offsetByteSize + info.rootCount * info.refByteSize;
+    // Magic num idx 68ff65f3  idxCrc32c acc3a728  generic b5ee9c72
+    info.magic = parse_hex("b5ee9c72");
+    info.dataSize = dataSize;
+    info.totalSize = dataOffset + dataSize + crcSize;
+    return info;
+}
+
+size_t CellArena::serializedSize(Index root, Cell::SerializationMode mode) const {
+    return getSerializationInfo(root, mode).totalSize;
+}
+
+void CellArena::serialize(Index root, TW::Data& data_inout, Cell::SerializationMode mode) const {
+    if (mode != Cell::SerializationMode::None && mode != Cell::SerializationMode::WithCRC32C) {
         throw std::invalid_argument("Cell::serialize: Mode " + std::to_string((int)mode) + " not supported");
     }
+    auto info = getSerializationInfo(root, mode);
+    if (info.refByteSize < 1 || info.refByteSize > 4) {
+        throw std::invalid_argument("Cell::serialize: too many cells");
+    }
+    auto order = collect(root);
+    // position of each cell in the serialized bag
+    std::vector<Index> position(root + 1, 0);
+    for (size_t i = 0; i < order.size(); ++i) {
+        position[order[i]] = static_cast<Index>(i);
+    }
+
     // save current start position
     size_t startIdx = data_inout.size();
-    auto info = getSerializationInfo(mode);
+    data_inout.reserve(startIdx + info.totalSize);
 
     // magic
     append(data_inout, info.magic);
@@ -330,36 +497,29 @@ void Cell::serialize(TW::Data& data_inout, SerializationMode mode) {
     if (info.hasCrc32c) { byte1 |= 1 << 6; }
     //if (info.has_cache_bits) { byte |= 1 << 5; }
     // 3, 4 - flags
-    if (info.refByteSize < 1 || info.refByteSize > 7) {
-        //cerr << info.refByteSize << endl;
-        return;
-    }
     byte1 |= static_cast<byte>(info.refByteSize);
     data_inout.push_back(byte1);
     data_inout.push_back((byte)info.offsetByteSize);
-    data_inout.push_back((byte)info.cellCount);
-    data_inout.push_back((byte)info.rootCount);
-    data_inout.push_back(0);
-    data_inout.push_back((byte)info.dataSize); // offset
-    data_inout.push_back(0); // roots
-
-    // own cell (slice)
-    serializeOwn(data_inout, false);
-    // cell refs?
-    uint8_t cidx = 0;
-    for(auto c: _cells) {
-        ++cidx;
-        data_inout.push_back(cidx);
-    }
-
-    // child cells
-    for(auto c: _cells) {
-        c->serializeOwn(data_inout, false);
+    appendBE(data_inout, info.cellCount, info.refByteSize);
+    appendBE(data_inout, info.rootCount, info.refByteSize);
+    appendBE(data_inout, 0, info.refByteSize); // absent
+    appendBE(data_inout, info.dataSize, info.offsetByteSize);
+    appendBE(data_inout, 0, info.refByteSize); // root index
+
+    // cells, each distinct cell once
+    for (auto index: order) {
+        const auto& entry = _cells[index];
+        data_inout.push_back(entry.refCount);
+        data_inout.push_back(Cell::d2(entry.sizeBits));
+        data_inout.insert(data_inout.end(), _data.begin() + entry.dataOffset, _data.begin() + entry.dataOffset + entry.dataSize);
+        for (size_t r = 0; r < entry.refCount; ++r) {
+            appendBE(data_inout, position[entry.refs[r]], info.refByteSize);
+        }
     }
 
-    if (mode & SerializationMode::WithCRC32C) {
+    if (mode & Cell::SerializationMode::WithCRC32C) {
         // CRC32-C, of the serialized data so far
-        uint32_t crc = computeCrc(data_inout.data() + startIdx, data_inout.size() - startIdx);
+        uint32_t crc = Cell::computeCrc(data_inout.data() + startIdx, data_inout.size() - startIdx);
         data_inout.push_back(crc & 0x000000FF);
         data_inout.push_back((crc & 0x0000FF00) >> 8);
         data_inout.push_back((crc & 0x00FF0000) >> 16);
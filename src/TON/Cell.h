@@ -8,6 +8,7 @@
 
 #include "../Data.h"
 
+#include <map>
 #include <memory>
 
 namespace TW::TON {
@@ -31,7 +32,7 @@ public:
     void appendBytes(const Data& data_in);
     /// Append bytes, possible incomplete bytes at the end.  SizeBits should be equal to data.size() * 8, or less by at most 7.
     void appendBits(const TW::Data& data_in, size_t sizeBits);
-    Data data() const { return _data; }
+    const Data& data() const { return _data; }
     inline size_t size() const { return _data.size(); }
     size_t sizeBits() const { return _sizeBits; }
     std::string asBytesStr() const;
@@ -48,6 +49,8 @@ private:
 };
 
 /// Represents a Cell, with references to other cells.
+/// The hash and depth are computed on demand and cached; the cache is invalidated when the cell
+/// or any of its descendants is modified.  Not thread-safe.
 class Cell {
 public:
     enum SerializationMode: uint8_t {
@@ -80,6 +83,8 @@ public:
 public:
     Cell() {}
     Cell(const Cell& from);
+    Cell& operator=(const Cell& from);
+    ~Cell();
     void setSlice(Slice const& slice);
     /// Convenience method for setting slice directly from bytes.  May throw.
     void setSliceBytes(const Data& data);
@@ -92,7 +97,10 @@ public:
     Slice const& getSlice() const { return _slice; }
     const std::vector<std::shared_ptr<Cell>>& getCells() const { return _cells; }
     std::string toString() const;
-    Data hash() const;
+    /// Representation hash of the cell (SHA256), cached.  The returned reference is valid until the next modification.
+    const Data& hash() const;
+    /// Depth of the cell: 0 for a cell without children, otherwise 1 + maximum depth of the children.  Cached.
+    uint16_t depth() const;
     /// Serialized size of this cell only, without children
     size_t serializedOwnSize(bool withHashes = false) const;
     /// Serialized size, including children
@@ -104,15 +112,69 @@ public:
     static const size_t max_cells = 4;
     /// second byte in length
     static byte d2(size_t bits);
-private:
     /// Compute 4-byte CRC32-C checksum, used in serialization
     static uint32_t computeCrc(const byte* data, size_t len);
-    // Prepare serialization properties
-    SerializationInfo getSerializationInfo(SerializationMode mode = SerializationMode::None) const;
+
+private:
+    /// Drop cached hash/depth of this cell and of all cells referring to it
+    void invalidate();
+    void attachChildren();
+    void detachChildren();
 
 private:
     std::vector<std::shared_ptr<Cell>> _cells;
     Slice _slice;
+    /// Cells which have this cell as a child (non-owning), for cache invalidation
+    std::vector<Cell*> _parents;
+    mutable Data _hash;
+    mutable uint16_t _depth = 0;
+};
+
+/// Flat, index-based representation of a cell DAG.  Cell data is kept in a single contiguous buffer,
+/// and hash and depth of each cell are computed once, when it is added.  Identical cells (same hash)
+/// are stored only once, so shared subtrees are deduplicated.
+/// A cell may only refer to cells added before it, therefore indices are in reverse topological order.
+class CellArena {
+public:
+    using Index = uint32_t;
+
+    /// Add a cell with the given slice and references to existing cells.  Returns the index of the cell,
+    /// which is the index of an existing identical cell if there is one.  May throw.
+    Index add(const Slice& slice, const std::vector<Index>& refs = {});
+    /// Add a cell tree recursively, returns the index of the root cell.
+    Index add(const Cell& cell);
+    size_t size() const { return _cells.size(); }
+    Data hash(Index index) const;
+    uint16_t depth(Index index) const { return _cells.at(index).depth; }
+    size_t refCount(Index index) const { return _cells.at(index).refCount; }
+    Index ref(Index index, size_t i) const;
+    /// Serialized size of a bag-of-cells with the given root, including all cells reachable from it
+    size_t serializedSize(Index root, Cell::SerializationMode mode = Cell::SerializationMode::None) const;
+    /// Serialize a bag-of-cells with the given root.  Each distinct cell is serialized only once.
+    void serialize(Index root, TW::Data& data_inout, Cell::SerializationMode mode = Cell::SerializationMode::None) const;
+    /// Prepare serialization properties
+    Cell::SerializationInfo getSerializationInfo(Index root, Cell::SerializationMode mode = Cell::SerializationMode::None) const;
+
+private:
+    struct Entry {
+        uint32_t dataOffset;
+        uint16_t dataSize;
+        uint16_t sizeBits;
+        uint16_t depth;
+        uint8_t refCount;
+        Index refs[Cell::max_cells];
+    };
+    Index insert(const Slice& slice, const std::vector<Index>& refs, const Data& hash);
+    /// Cells reachable from root, in serialization order (root first)
+    std::vector<Index> collect(Index root) const;
+    size_t ownSize(Index index) const { return _cells[index].dataSize + 2; }
+
+    std::vector<Entry> _cells;
+    /// Concatenated slice data of all cells
+    Data _data;
+    /// Concatenated 32-byte hashes of all cells
+    Data _hashes;
+    std::map<Data, Index> _byHash;
 };
 
 } // namespace TW::TON
@@ -64,6 +64,7 @@ std::string Address::deriveOriginatedAddress(const std::string& operationHash, i
 }
 
 Data Address::forge() const {
-    std::string s = string();
-    return forgePublicKeyHash(s);
+    Data forged;
+    forgePublicKeyHash(*this, forged);
+    return forged;
 }
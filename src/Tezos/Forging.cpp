@@ -4,6 +4,7 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include "Forging.h"
 #include "Address.h"
 #include "BinaryCoding.h"
 #include "../Base58.h"
@@ -11,125 +12,311 @@
 #include "../HexCoding.h"
 #include "../proto/Tezos.pb.h"
 
+#include <algorithm>
+#include <climits>
 #include <sstream>
 
 using namespace TW;
 using namespace TW::Tezos;
 using namespace TW::Tezos::Proto;
 
-// Forge the given boolean into a hex encoded string.
-Data forgeBool(bool input) {
-    unsigned char result = input ? 0xff : 0x00;
-    return Data{result};
+namespace {
+
+/// Base58 prefixes of tz1, tz2 and tz3 addresses, by forged tag.
+const std::array<std::array<byte, 3>, 3> publicKeyHashPrefixes = {{
+    {6, 161, 159},
+    {6, 161, 161},
+    {6, 161, 164},
+}};
+
+/// Forges a decoded tz1, tz2 or tz3 address: the prefix is replaced by the tag.
+///
+/// @returns false if the prefix is none of these.
+bool forgeDecodedPublicKeyHash(const byte* decoded, byte* forged) {
+    for (size_t tag = 0; tag < publicKeyHashPrefixes.size(); ++tag) {
+        const auto& prefix = publicKeyHashPrefixes[tag];
+        if (std::equal(prefix.begin(), prefix.end(), decoded)) {
+            forged[0] = static_cast<byte>(tag);
+            std::copy(decoded + prefix.size(), decoded + TW::Tezos::Address::size, forged + 1);
+            return true;
+        }
+    }
+    return false;
 }
 
-// Forge the given public key hash into a hex encoded string.
-// Note: This function supports tz1, tz2 and tz3 addresses.
-Data forgePublicKeyHash(const std::string& publicKeyHash) {
-    Data forged = Data();
+ForgedPublicKeyHash forgeDecodedPublicKeyHash(const std::string& publicKeyHash) {
+    ForgedPublicKeyHash forged;
     // Adjust prefix based on tz1, tz2 or tz3.
-    switch ((char)publicKeyHash[2]) {
+    switch (publicKeyHash.size() > 2 ? publicKeyHash[2] : 0) {
     case '1':
-        forged.push_back(0x00);
+        forged[0] = 0x00;
         break;
     case '2':
-        forged.push_back(0x01);
+        forged[0] = 0x01;
         break;
     case '3':
-        forged.push_back(0x02);
+        forged[0] = 0x02;
         break;
     default:
         throw std::invalid_argument("Invalid Prefix");
     }
     const auto decoded = Base58::bitcoin.decodeCheck(publicKeyHash);
+    if (decoded.size() != Address::size) {
+        throw std::invalid_argument("Invalid address string");
+    }
     const auto prefixSize = 3;
-    forged.insert(forged.end(), decoded.begin() + prefixSize, decoded.end());
+    std::copy(decoded.begin() + prefixSize, decoded.end(), forged.begin() + 1);
     return forged;
 }
 
+/// Reads size bytes at offset.
+const byte* unforgeBytes(const Data& forged, size_t& offset, size_t size) {
+    if (offset > forged.size() || forged.size() - offset < size) {
+        throw std::invalid_argument("Forged data too short");
+    }
+    const auto bytes = forged.data() + offset;
+    offset += size;
+    return bytes;
+}
+
+int64_t unforgeInt64(const Data& forged, size_t& offset) {
+    const auto value = unforgeZarith(forged, offset);
+    if (value > static_cast<uint64_t>(INT64_MAX)) {
+        throw std::invalid_argument("Forged value out of range");
+    }
+    return static_cast<int64_t>(value);
+}
+
+} // namespace
+
+// Forge the given boolean into a hex encoded string.
+Data forgeBool(bool input) {
+    Data forged;
+    forgeBool(input, forged);
+    return forged;
+}
+
+void forgeBool(bool input, Data& forged) {
+    forged.push_back(input ? 0xff : 0x00);
+}
+
+// Forge the given public key hash into a hex encoded string.
+// Note: This function supports tz1, tz2 and tz3 addresses.
+Data forgePublicKeyHash(const std::string& publicKeyHash) {
+    Data forged;
+    forgePublicKeyHash(publicKeyHash, forged);
+    return forged;
+}
+
+void forgePublicKeyHash(const std::string& publicKeyHash, Data& forged, ForgedPublicKeyHashCache* cache) {
+    if (cache == nullptr) {
+        const auto hash = forgeDecodedPublicKeyHash(publicKeyHash);
+        forged.insert(forged.end(), hash.begin(), hash.end());
+        return;
+    }
+    auto it = cache->find(publicKeyHash);
+    if (it == cache->end()) {
+        it = cache->emplace(publicKeyHash, forgeDecodedPublicKeyHash(publicKeyHash)).first;
+    }
+    forged.insert(forged.end(), it->second.begin(), it->second.end());
+}
+
+void forgePublicKeyHash(const Address& address, Data& forged) {
+    const auto offset = forged.size();
+    forged.resize(offset + std::tuple_size<ForgedPublicKeyHash>::value);
+    if (!forgeDecodedPublicKeyHash(address.bytes.data(), forged.data() + offset)) {
+        // other prefixes are forged by their string
+        forged.resize(offset);
+        forgePublicKeyHash(address.string(), forged);
+    }
+}
+
 // Forge the given public key into a hex encoded string.
 Data forgePublicKey(PublicKey publicKey) {
-    std::array<uint8_t, 4> prefix = {13, 15, 37, 217};
-    auto data = Data(prefix.begin(), prefix.end());
-    auto bytes = Data(publicKey.bytes.begin(), publicKey.bytes.end());
-    append(data, bytes);
+    Data forged;
+    forgePublicKey(publicKey, forged);
+    return forged;
+}
 
-    auto pk = Base58::bitcoin.encodeCheck(data);
-    auto decoded = "00" + base58ToHex(pk, 4, prefix.data());
-    return parse_hex(decoded);
+void forgePublicKey(const PublicKey& publicKey, Data& forged) {
+    // Ed25519 tag
+    forged.push_back(0x00);
+    append(forged, publicKey.bytes);
 }
 
 // Forge the given zarith hash into a hex encoded string.
 Data forgeZarith(uint64_t input) {
-    Data forged = Data();
+    Data forged;
+    forgeZarith(input, forged);
+    return forged;
+}
+
+void forgeZarith(uint64_t input, Data& forged) {
     while (input >= 0x80) {
         forged.push_back(static_cast<byte>((input & 0xff) | 0x80));
         input >>= 7;
     }
     forged.push_back(static_cast<byte>(input));
-    return forged;
+}
+
+size_t forgedZarithSize(uint64_t input) {
+    size_t size = 1;
+    while (input >= 0x80) {
+        ++size;
+        input >>= 7;
+    }
+    return size;
 }
 
 // Forge the given operation.
 Data forgeOperation(const Operation& operation) {
-    auto forged = Data();
-    auto source = Address(operation.source());
-    auto forgedSource = source.forge();
-    auto forgedFee = forgeZarith(operation.fee());
-    auto forgedCounter = forgeZarith(operation.counter());
-    auto forgedGasLimit = forgeZarith(operation.gas_limit());
-    auto forgedStorageLimit = forgeZarith(operation.storage_limit());
-
-    if (operation.kind() == Operation_OperationKind_REVEAL) {
-        auto publicKey = PublicKey(data(operation.reveal_operation_data().public_key()), TWPublicKeyTypeED25519);
-        auto forgedPublicKey = forgePublicKey(publicKey);
-        
-        forged.push_back(Operation_OperationKind_REVEAL);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
-        append(forged, forgedPublicKey);
-        return forged;
-    }
-
-    if (operation.kind() == Operation_OperationKind_DELEGATION) {
-        auto delegate = operation.delegation_operation_data().delegate();
-
-        forged.push_back(Operation_OperationKind_DELEGATION);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
-        if (!delegate.empty()) {
-            auto forgedPublicKeyHash = forgePublicKeyHash(delegate);
-
-            append(forged, forgeBool(true));
-            append(forged, forgedPublicKeyHash);
+    Data forged;
+    forged.reserve(forgedOperationSize(operation));
+    forgeOperation(operation, forged);
+    return forged;
+}
+
+void forgeOperation(const Operation& operation, Data& forged, ForgedPublicKeyHashCache* cache) {
+    const auto kind = operation.kind();
+    if (kind != Operation_OperationKind_REVEAL && kind != Operation_OperationKind_DELEGATION &&
+        kind != Operation_OperationKind_TRANSACTION) {
+        throw std::invalid_argument("Invalid operation kind");
+    }
+    // fields are appended in place; nothing is written if a field is invalid
+    const auto offset = forged.size();
+    try {
+        forged.push_back(static_cast<byte>(kind));
+        forgePublicKeyHash(operation.source(), forged, cache);
+        forgeZarith(operation.fee(), forged);
+        forgeZarith(operation.counter(), forged);
+        forgeZarith(operation.gas_limit(), forged);
+        forgeZarith(operation.storage_limit(), forged);
+
+        if (kind == Operation_OperationKind_REVEAL) {
+            auto publicKey = PublicKey(data(operation.reveal_operation_data().public_key()), TWPublicKeyTypeED25519);
+            forgePublicKey(publicKey, forged);
+        } else if (kind == Operation_OperationKind_DELEGATION) {
+            const auto& delegate = operation.delegation_operation_data().delegate();
+            if (!delegate.empty()) {
+                forgeBool(true, forged);
+                forgePublicKeyHash(delegate, forged, cache);
+            } else {
+                forgeBool(false, forged);
+            }
         } else {
-            append(forged, forgeBool(false));
+            const auto& transaction = operation.transaction_operation_data();
+            forgeZarith(transaction.amount(), forged);
+            // implicit account destination
+            forgeBool(false, forged);
+            forgePublicKeyHash(transaction.destination(), forged, cache);
+            // no parameters
+            forgeBool(false, forged);
+        }
+    } catch (...) {
+        forged.resize(offset);
+        throw;
+    }
+}
+
+size_t forgedOperationSize(const Operation& operation) {
+    const auto publicKeyHashSize = std::tuple_size<ForgedPublicKeyHash>::value;
+    auto size = 1 + publicKeyHashSize + forgedZarithSize(operation.fee()) + forgedZarithSize(operation.counter()) +
+                forgedZarithSize(operation.gas_limit()) + forgedZarithSize(operation.storage_limit());
+    switch (operation.kind()) {
+    case Operation_OperationKind_REVEAL:
+        return size + 1 + PublicKey::ed25519Size;
+    case Operation_OperationKind_DELEGATION:
+        return size + 1 + (operation.delegation_operation_data().delegate().empty() ? 0 : publicKeyHashSize);
+    case Operation_OperationKind_TRANSACTION:
+        return size + forgedZarithSize(operation.transaction_operation_data().amount()) + 1 + publicKeyHashSize + 1;
+    default:
+        return size;
+    }
+}
+
+bool unforgeBool(const Data& forged, size_t& offset) {
+    switch (*unforgeBytes(forged, offset, 1)) {
+    case 0x00:
+        return false;
+    case 0xff:
+        return true;
+    default:
+        throw std::invalid_argument("Invalid forged boolean");
+    }
+}
+
+uint64_t unforgeZarith(const Data& forged, size_t& offset) {
+    uint64_t value = 0;
+    for (size_t shift = 0; shift < 64; shift += 7) {
+        const auto next = *unforgeBytes(forged, offset, 1);
+        const uint64_t bits = next & 0x7f;
+        if ((bits << shift) >> shift != bits) {
+            throw std::invalid_argument("Forged value out of range");
+        }
+        value |= bits << shift;
+        if ((next & 0x80) == 0) {
+            // a trailing zero group would encode the same value as the shorter encoding
+            if (next == 0 && shift > 0) {
+                throw std::invalid_argument("Non-canonical forged value");
+            }
+            return value;
         }
-        return forged;
     }
+    throw std::invalid_argument("Forged value out of range");
+}
 
-    if (operation.kind() == Operation_OperationKind_TRANSACTION) {
-        auto forgedAmount = forgeZarith(operation.transaction_operation_data().amount());
-        auto forgedDestination = Address(operation.transaction_operation_data().destination()).forge();
+std::string unforgePublicKeyHash(const Data& forged, size_t& offset) {
+    const auto tag = *unforgeBytes(forged, offset, 1);
+    if (tag >= publicKeyHashPrefixes.size()) {
+        throw std::invalid_argument("Invalid Prefix");
+    }
+    const auto& prefix = publicKeyHashPrefixes[tag];
+    const auto hash = unforgeBytes(forged, offset, Address::size - prefix.size());
+    Data decoded(prefix.begin(), prefix.end());
+    decoded.insert(decoded.end(), hash, hash + Address::size - prefix.size());
+    return Base58::bitcoin.encodeCheck(decoded);
+}
+
+PublicKey unforgePublicKey(const Data& forged, size_t& offset) {
+    if (*unforgeBytes(forged, offset, 1) != 0x00) {
+        throw std::invalid_argument("Unsupported public key type");
+    }
+    const auto bytes = unforgeBytes(forged, offset, PublicKey::ed25519Size);
+    return PublicKey(Data(bytes, bytes + PublicKey::ed25519Size), TWPublicKeyTypeED25519);
+}
 
-        forged.push_back(Operation_OperationKind_TRANSACTION);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
-        append(forged, forgedAmount);
-        append(forged, forgeBool(false));
-        append(forged, forgedDestination);
-        append(forged, forgeBool(false));
-        return forged;
+Operation unforgeOperation(const Data& forged, size_t& offset) {
+    Operation operation;
+    const auto kind = *unforgeBytes(forged, offset, 1);
+    if (kind != Operation_OperationKind_REVEAL && kind != Operation_OperationKind_DELEGATION &&
+        kind != Operation_OperationKind_TRANSACTION) {
+        throw std::invalid_argument("Invalid operation kind");
     }
+    operation.set_kind(static_cast<Operation_OperationKind>(kind));
+    operation.set_source(unforgePublicKeyHash(forged, offset));
+    operation.set_fee(unforgeInt64(forged, offset));
+    operation.set_counter(unforgeInt64(forged, offset));
+    operation.set_gas_limit(unforgeInt64(forged, offset));
+    operation.set_storage_limit(unforgeInt64(forged, offset));
 
-    throw std::invalid_argument("Invalid operation kind");
+    if (kind == Operation_OperationKind_REVEAL) {
+        const auto publicKey = unforgePublicKey(forged, offset);
+        operation.mutable_reveal_operation_data()->set_public_key(publicKey.bytes.data(), publicKey.bytes.size());
+    } else if (kind == Operation_OperationKind_DELEGATION) {
+        auto delegation = operation.mutable_delegation_operation_data();
+        if (unforgeBool(forged, offset)) {
+            delegation->set_delegate(unforgePublicKeyHash(forged, offset));
+        }
+    } else {
+        auto transaction = operation.mutable_transaction_operation_data();
+        transaction->set_amount(unforgeInt64(forged, offset));
+        if (unforgeBool(forged, offset)) {
+            throw std::invalid_argument("Unsupported originated account destination");
+        }
+        transaction->set_destination(unforgePublicKeyHash(forged, offset));
+        if (unforgeBool(forged, offset)) {
+            throw std::invalid_argument("Unsupported transaction parameters");
+        }
+    }
+    return operation;
 }
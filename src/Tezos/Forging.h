@@ -4,10 +4,15 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#pragma once
+
+#include "Address.h"
 #include "../PublicKey.h"
 #include "../proto/Tezos.pb.h"
 
+#include <array>
 #include <string>
+#include <unordered_map>
 
 using namespace TW;
 using namespace TW::Tezos::Proto;
@@ -17,3 +22,41 @@ Data forgeOperation(const Operation& operation);
 Data forgePublicKeyHash(const std::string& publicKeyHash);
 Data forgePublicKey(PublicKey publicKey);
 Data forgeZarith(uint64_t input);
+
+/// A forged public key hash: the curve tag (0 for tz1, 1 for tz2, 2 for tz3) followed by the 20-byte hash.
+using ForgedPublicKeyHash = std::array<byte, 21>;
+
+/// Forged public key hashes by address string, so that each address of an operation group is decoded once.
+using ForgedPublicKeyHashCache = std::unordered_map<std::string, ForgedPublicKeyHash>;
+
+// Forging into a buffer: each function appends to forged.
+
+void forgeBool(bool input, Data& forged);
+void forgeZarith(uint64_t input, Data& forged);
+void forgePublicKey(const PublicKey& publicKey, Data& forged);
+void forgePublicKeyHash(const TW::Tezos::Address& address, Data& forged);
+
+/// Forges an address string, decoded through cache if given.
+///
+/// @throws std::invalid_argument if the string is not a tz1, tz2 or tz3 address.
+void forgePublicKeyHash(const std::string& publicKeyHash, Data& forged, ForgedPublicKeyHashCache* cache = nullptr);
+
+/// Forges an operation, with its address strings decoded through cache if given.
+void forgeOperation(const Operation& operation, Data& forged, ForgedPublicKeyHashCache* cache = nullptr);
+
+size_t forgedZarithSize(uint64_t input);
+
+/// Number of bytes `forgeOperation` appends for operation.
+size_t forgedOperationSize(const Operation& operation);
+
+// Unforging, to check forged bytes (e.g. returned by a node) before signing them.  Each function reads at offset,
+// advances offset past what it read, and throws std::invalid_argument if the bytes are malformed or truncated.
+
+bool unforgeBool(const Data& forged, size_t& offset);
+uint64_t unforgeZarith(const Data& forged, size_t& offset);
+/// @returns the tz1, tz2 or tz3 address string.
+std::string unforgePublicKeyHash(const Data& forged, size_t& offset);
+/// Supports Ed25519 keys only, as forged by `forgePublicKey`.
+PublicKey unforgePublicKey(const Data& forged, size_t& offset);
+/// Supports the reveal, transaction and delegation operations produced by `forgeOperation`.
+Operation unforgeOperation(const Data& forged, size_t& offset);
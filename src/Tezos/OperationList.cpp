@@ -23,33 +23,62 @@ void Tezos::OperationList::addOperation(const Operation& operation) {
     operation_list.push_back(operation);
 }
 
+namespace {
+
+const std::array<byte, 2> branchPrefix = {1, 52};
+constexpr size_t branchSize = 32;
+
+} // namespace
+
 // Forge the given branch to a hex encoded string.
 Data Tezos::OperationList::forgeBranch() const {
-    std::array<byte, 2> prefix = {1, 52};
     const auto decoded = Base58::bitcoin.decodeCheck(branch);
-    if (decoded.size() != 34 || !std::equal(prefix.begin(), prefix.end(), decoded.begin())) {
+    if (decoded.size() != branchPrefix.size() + branchSize || !std::equal(branchPrefix.begin(), branchPrefix.end(), decoded.begin())) {
         throw std::invalid_argument("Invalid branch for forge");
     }
     auto forged = Data();
-    forged.insert(forged.end(), decoded.begin() + prefix.size(), decoded.end());
+    forged.insert(forged.end(), decoded.begin() + branchPrefix.size(), decoded.end());
     return forged;
 }
 
 Data Tezos::OperationList::forge(const PrivateKey& privateKey) const {
+    auto size = branchSize;
+    for (const auto& operation : operation_list) {
+        size += forgedOperationSize(operation);
+    }
     auto forged = forgeBranch();
+    forged.reserve(size);
 
-    for (auto operation : operation_list) {
+    // operations of a group mostly share their source
+    ForgedPublicKeyHashCache cache;
+    for (const auto& operation : operation_list) {
         // If it's REVEAL operation, inject the public key if not specified
-        if (operation.kind() == Operation::REVEAL && operation.has_reveal_operation_data()) {
-            auto revealOperationData = operation.mutable_reveal_operation_data();
-            if (revealOperationData->public_key().empty()) {
-                auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
-                revealOperationData->set_public_key(publicKey.bytes.data(), publicKey.bytes.size());
-            }
+        if (operation.kind() == Operation::REVEAL && operation.has_reveal_operation_data() &&
+            operation.reveal_operation_data().public_key().empty()) {
+            auto revealOperation = operation;
+            auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+            revealOperation.mutable_reveal_operation_data()->set_public_key(publicKey.bytes.data(), publicKey.bytes.size());
+            forgeOperation(revealOperation, forged, &cache);
+            continue;
         }
 
-        append(forged, forgeOperation(operation));
+        forgeOperation(operation, forged, &cache);
     }
 
     return forged;
 }
+
+Tezos::OperationList Tezos::OperationList::unforge(const Data& forged) {
+    if (forged.size() < branchSize) {
+        throw std::invalid_argument("Forged data too short");
+    }
+    Data decodedBranch(branchPrefix.begin(), branchPrefix.end());
+    decodedBranch.insert(decodedBranch.end(), forged.begin(), forged.begin() + branchSize);
+    auto operationList = OperationList(Base58::bitcoin.encodeCheck(decodedBranch));
+
+    size_t offset = branchSize;
+    while (offset < forged.size()) {
+        operationList.addOperation(unforgeOperation(forged, offset));
+    }
+    return operationList;
+}
@@ -19,6 +19,12 @@ class OperationList {
     /// Returns a data representation of the operations.
     Data forge(const PrivateKey& privateKey) const;
     Data forgeBranch() const;
+
+    /// Parses forged operations, e.g. to check bytes forged by a node against the intended operations before
+    /// signing them.
+    ///
+    /// @throws std::invalid_argument if the data is malformed, or holds operations `forge` does not produce.
+    static OperationList unforge(const Data& forged);
 };
 
 } // namespace TW::Tezos
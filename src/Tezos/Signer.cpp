@@ -19,7 +19,8 @@ using namespace TW::Tezos;
 
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto operationList = Tezos::OperationList(input.operation_list().branch());
-    for (Proto::Operation operation : input.operation_list().operations()) {
+    operationList.operation_list.reserve(input.operation_list().operations_size());
+    for (const auto& operation : input.operation_list().operations()) {
       operationList.addOperation(operation);
     }
 
@@ -47,6 +48,7 @@ Data Signer::signOperationList(const PrivateKey& privateKey, const OperationList
 
 Data Signer::signData(const PrivateKey& privateKey, const Data& data) {
     Data watermarkedData = Data();
+    watermarkedData.reserve(1 + data.size());
     watermarkedData.push_back(0x03);
     append(watermarkedData, data);
 
@@ -54,6 +56,7 @@ Data Signer::signData(const PrivateKey& privateKey, const Data& data) {
     Data signature = privateKey.sign(hash, TWCurve::TWCurveED25519);
 
     Data signedData = Data();
+    signedData.reserve(data.size() + signature.size());
     append(signedData, data);
     append(signedData, signature);
     return signedData;
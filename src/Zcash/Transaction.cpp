@@ -11,15 +11,44 @@
 #include "../Hash.h"
 #include  "../HexCoding.h"
 
+#include <TrezorCrypto/blake2b.h>
+
 #include <cassert>
 
 using namespace TW;
 using namespace TW::Zcash;
 
+namespace {
+
+/// BLAKE2b-256 with a fixed personalization; the initialized state is computed once and copied for each hash.
+class PersonalizedHasher {
+  public:
+    explicit PersonalizedHasher(const char (&personal)[BLAKE2B_PERSONALBYTES + 1]) {
+        blake2b_InitPersonal(&initial, hashSize, personal, BLAKE2B_PERSONALBYTES);
+    }
+
+    Data hash(const Data& data) const {
+        auto state = initial;
+        blake2b_Update(&state, data.data(), data.size());
+        Data result(hashSize);
+        blake2b_Final(&state, result.data(), result.size());
+        return result;
+    }
+
+  private:
+    static constexpr size_t hashSize = 32;
+    blake2b_state initial;
+};
+
+/// Size of the preimage without the script code.
+constexpr size_t preImageFixedSize = 4 + 4 + 6 * 32 + 4 + 4 + 8 + 4 + 36 + 8 + 4;
+
+} // namespace
+
 const auto sigHashPersonalization = Data({'Z','c','a','s','h','S','i','g','H','a','s','h'});
-const auto prevoutsHashPersonalization = Data({'Z','c','a','s','h','P','r','e','v','o','u','t','H','a','s','h'});
-const auto sequenceHashPersonalization = Data({'Z','c','a','s','h','S','e','q','u','e','n','c','H','a','s','h'});
-const auto outputsHashPersonalization = Data({'Z','c','a','s','h','O','u','t','p','u','t','s','H','a','s','h'});
+const PersonalizedHasher prevoutsHasher("ZcashPrevoutHash");
+const PersonalizedHasher sequenceHasher("ZcashSequencHash");
+const PersonalizedHasher outputsHasher("ZcashOutputsHash");
 const auto joinsplitsHashPersonalization = Data({'Z','c','a','s','h','J','S','p','l','i','t','s','H','a','s','h'});
 const auto shieldedSpendHashPersonalization = Data({'Z','c','a','s','h','S','S','p','e','n','d','s','H','a','s','h'});
 const auto shieldedOutputsHashPersonalization = Data({'Z','c','a','s','h','S','O','u','t','p','u','t','H','a','s','h'});
@@ -30,10 +59,11 @@ const std::array<byte, 4> Zcash::SaplingBranchID = {0xbb, 0x09, 0xb8, 0x76};
 const std::array<byte, 4> Zcash::BlossomBranchID = {0x60, 0x0e, 0xb4, 0x2b};
 
 Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType,
-                              uint64_t amount) const {
+                              uint64_t amount, const Bitcoin::SignatureHashCache* cache) const {
     assert(index < inputs.size());
 
     auto data = Data{};
+    data.reserve(preImageFixedSize + 9 + scriptCode.bytes.size());
 
     // header
     encode32LE(version, data);
@@ -43,7 +73,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
 
     // Input prevouts (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0) {
-        auto hashPrevouts = getPrevoutHash();
+        auto hashPrevouts = cache != nullptr ? cache->prevoutHash : getPrevoutHash();
         std::copy(std::begin(hashPrevouts), std::end(hashPrevouts), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -52,7 +82,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
     // Input nSequence (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 &&
         !Bitcoin::hashTypeIsSingle(hashType) && !Bitcoin::hashTypeIsNone(hashType)) {
-        auto hashSequence = getSequenceHash();
+        auto hashSequence = cache != nullptr ? cache->sequenceHash : getSequenceHash();
         std::copy(std::begin(hashSequence), std::end(hashSequence), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -60,13 +90,12 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
 
     // Outputs (none/one/all, depending on flags)
     if (!Bitcoin::hashTypeIsSingle(hashType) && !Bitcoin::hashTypeIsNone(hashType)) {
-        auto hashOutputs = getOutputsHash();
+        auto hashOutputs = cache != nullptr ? cache->outputsHash : getOutputsHash();
         copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
     } else if (Bitcoin::hashTypeIsSingle(hashType) && index < outputs.size()) {
         auto outputData = Data{};
         outputs[index].encode(outputData);
-        auto hashOutputs =
-            TW::Hash::blake2b(outputData, outputData.size(), outputsHashPersonalization);
+        auto hashOutputs = outputsHasher.hash(outputData);
         copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
     } else {
         fill_n(back_inserter(data), 32, 0);
@@ -110,20 +139,22 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
 
 Data Transaction::getPrevoutHash() const {
     auto data = Data{};
+    data.reserve(36 * inputs.size());
     for (auto& input : inputs) {
         auto& outpoint = input.previousOutput;
         outpoint.encode(data);
     }
-    auto hash = TW::Hash::blake2b(data, 32, prevoutsHashPersonalization);
+    auto hash = prevoutsHasher.hash(data);
     return hash;
 }
 
 Data Transaction::getSequenceHash() const {
     auto data = Data{};
+    data.reserve(4 * inputs.size());
     for (auto& input : inputs) {
         encode32LE(input.sequence, data);
     }
-    auto hash = TW::Hash::blake2b(data, 32, sequenceHashPersonalization);
+    auto hash = sequenceHasher.hash(data);
     return hash;
 }
 
@@ -132,10 +163,14 @@ Data Transaction::getOutputsHash() const {
     for (auto& output : outputs) {
         output.encode(data);
     }
-    auto hash = TW::Hash::blake2b(data, 32, outputsHashPersonalization);
+    auto hash = outputsHasher.hash(data);
     return hash;
 }
 
+Bitcoin::SignatureHashCache Transaction::getSignatureHashCache() const {
+    return Bitcoin::SignatureHashCache{getPrevoutHash(), getSequenceHash(), getOutputsHash()};
+}
+
 Data Transaction::getJoinSplitsHash() const {
     Data vec(32, 0);
     return vec;
@@ -181,13 +216,14 @@ void Transaction::encode(Data& data) const {
 
 Data Transaction::getSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
                                    enum TWBitcoinSigHashType hashType, uint64_t amount,
-                                   Bitcoin::SignatureVersion version) const {
+                                   Bitcoin::SignatureVersion version,
+                                   const Bitcoin::SignatureHashCache* cache) const {
     Data personalization;
     personalization.reserve(16);
     std::copy(sigHashPersonalization.begin(), sigHashPersonalization.begin() + 12,
               std::back_inserter(personalization));
     std::copy(branchId.begin(), branchId.end(), std::back_inserter(personalization));
-    auto preimage = getPreImage(scriptCode, index, hashType, amount);
+    auto preimage = getPreImage(scriptCode, index, hashType, amount, cache);
     auto hash = Hash::blake2b(preimage, 32, personalization);
     return hash;
 }
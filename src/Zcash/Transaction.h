@@ -50,13 +50,17 @@ struct Transaction {
     /// Whether the transaction is empty.
     bool empty() const { return inputs.empty() && outputs.empty(); }
 
-    /// Generates the signature pre-image.
+    /// Generates the signature pre-image, with the shared hashes of cache if given (see `getSignatureHash`).
     Data getPreImage(const Bitcoin::Script& scriptCode, size_t index,
-                     enum TWBitcoinSigHashType hashType, uint64_t amount) const;
+                     enum TWBitcoinSigHashType hashType, uint64_t amount,
+                     const Bitcoin::SignatureHashCache* cache = nullptr) const;
     Data getPrevoutHash() const;
     Data getSequenceHash() const;
     Data getOutputsHash() const;
 
+    /// Computes the hashes shared by the signature hashes of all inputs, for signing many inputs.
+    Bitcoin::SignatureHashCache getSignatureHashCache() const;
+
     Data getJoinSplitsHash() const;
     Data getShieldedSpendsHash() const;
     Data getShieldedOutputsHash() const;
@@ -64,9 +68,12 @@ struct Transaction {
     /// Encodes the rawtx into the provided buffer.
     void encode(Data& data) const;
 
+    /// Generates the signature hash.  cache, if given, must come from `getSignatureHashCache` with the current inputs
+    /// and outputs.
     Data getSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
                           enum TWBitcoinSigHashType hashType, uint64_t amount,
-                          enum Bitcoin::SignatureVersion version) const;
+                          enum Bitcoin::SignatureVersion version,
+                          const Bitcoin::SignatureHashCache* cache = nullptr) const;
 
     /// Converts to Protobuf model
     Bitcoin::Proto::Transaction proto() const;
@@ -6,10 +6,54 @@
 
 #include <TrustWalletCore/TWAnySigner.h>
 
+#include "BinaryCoding.h"
 #include "Coin.h"
 
+#include <TrezorCrypto/memzero.h>
+
+#include <algorithm>
+
 using namespace TW;
 
+namespace {
+
+/// Inputs of a batch, copied out of the caller's buffer; they hold private keys, so they are wiped when done.
+struct BatchInputs {
+    std::vector<Data> inputs;
+
+    ~BatchInputs() {
+        for (auto& input : inputs) {
+            memzero(input.data(), input.size());
+        }
+    }
+};
+
+/// Runs a coin operation on a borrowed input, writing the result into a caller-provided buffer if it fits, and returns
+/// the size of the result.  The intermediate buffers are per thread and keep their capacity across calls, so that
+/// steady-state calls do not allocate them; both are wiped after each call, as the input holds private keys.
+template <typename Function>
+size_t operateInto(const uint8_t* input, size_t inputSize, uint8_t* output, size_t capacity, Function function) {
+    thread_local Data dataIn;
+    thread_local Data dataOut;
+    struct Wipe {
+        ~Wipe() {
+            memzero(dataIn.data(), dataIn.size());
+            dataIn.clear();
+            memzero(dataOut.data(), dataOut.size());
+            dataOut.clear();
+        }
+    } wipe;
+    dataIn.assign(input, input + inputSize);
+    function(dataIn, dataOut);
+    const auto size = dataOut.size();
+    if (output != nullptr && size <= capacity) {
+        std::copy(dataOut.begin(), dataOut.end(), output);
+    }
+    return size;
+}
+
+} // namespace
+
 TWData* _Nonnull TWAnySignerSign(TWData* _Nonnull data, enum TWCoinType coin) {
     const Data& dataIn = *(reinterpret_cast<const Data*>(data));
     Data dataOut;
@@ -17,6 +61,47 @@ TWData* _Nonnull TWAnySignerSign(TWData* _Nonnull data, enum TWCoinType coin) {
     return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
 }
 
+TWData* _Nullable TWAnySignerSignBatch(TWData* _Nonnull data, enum TWCoinType coin) {
+    const Data& dataIn = *(reinterpret_cast<const Data*>(data));
+    BatchInputs batch;
+    auto& inputs = batch.inputs;
+    size_t offset = 0;
+    while (offset < dataIn.size()) {
+        if (dataIn.size() - offset < 4) {
+            return nullptr;
+        }
+        const auto length = decode32LE(dataIn.data() + offset);
+        offset += 4;
+        if (dataIn.size() - offset < length) {
+            return nullptr;
+        }
+        inputs.emplace_back(dataIn.begin() + offset, dataIn.begin() + offset + length);
+        offset += length;
+    }
+
+    std::vector<BatchSignResult> results;
+    TW::anyCoinSignBatch(coin, inputs, results);
+
+    size_t size = 0;
+    for (const auto& result: results) {
+        size += 1 + 4 + (result.success ? result.output.size() : result.error.size());
+    }
+    Data dataOut;
+    dataOut.reserve(size);
+    for (const auto& result: results) {
+        if (result.success) {
+            dataOut.push_back(0);
+            encode32LE(static_cast<uint32_t>(result.output.size()), dataOut);
+            append(dataOut, result.output);
+        } else {
+            dataOut.push_back(1);
+            encode32LE(static_cast<uint32_t>(result.error.size()), dataOut);
+            dataOut.insert(dataOut.end(), result.error.begin(), result.error.end());
+        }
+    }
+    return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
+}
+
 TWString *_Nonnull TWAnySignerSignJSON(TWString *_Nonnull json, TWData *_Nonnull key, enum TWCoinType coin) {
     const Data& keyData = *(reinterpret_cast<const Data*>(key));
     const std::string& jsonString = *(reinterpret_cast<const std::string*>(json));
@@ -47,3 +132,21 @@ TWData* _Nonnull TWAnySignerPlan(TWData* _Nonnull data, enum TWCoinType coin) {
     TW::anyCoinPlan(coin, dataIn, dataOut);
     return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
 }
+
+size_t TWAnySignerSignInto(const uint8_t* _Nonnull input, size_t inputSize, enum TWCoinType coin,
+                           uint8_t* _Nullable output, size_t capacity) {
+    return operateInto(input, inputSize, output, capacity,
+                       [coin](const Data& dataIn, Data& dataOut) { TW::anyCoinSign(coin, dataIn, dataOut); });
+}
+
+size_t TWAnySignerEncodeInto(const uint8_t* _Nonnull input, size_t inputSize, enum TWCoinType coin,
+                             uint8_t* _Nullable output, size_t capacity) {
+    return operateInto(input, inputSize, output, capacity,
+                       [coin](const Data& dataIn, Data& dataOut) { TW::anyCoinEncode(coin, dataIn, dataOut); });
+}
+
+size_t TWAnySignerPlanInto(const uint8_t* _Nonnull input, size_t inputSize, enum TWCoinType coin,
+                           uint8_t* _Nullable output, size_t capacity) {
+    return operateInto(input, inputSize, output, capacity,
+                       [coin](const Data& dataIn, Data& dataOut) { TW::anyCoinPlan(coin, dataIn, dataOut); });
+}
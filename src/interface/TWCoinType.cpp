@@ -9,6 +9,10 @@
 
 #include "../Coin.h"
 
+#include <TrezorCrypto/memzero.h>
+
+#include <cstring>
+
 enum TWBlockchain TWCoinTypeBlockchain(enum TWCoinType coin) {
     return TW::blockchain(coin);
 }
@@ -49,6 +53,44 @@ TWString *_Nonnull TWCoinTypeDeriveAddressFromPublicKey(enum TWCoinType coin, st
     return TWStringCreateWithUTF8Bytes(string.c_str());
 }
 
+namespace {
+
+size_t copyAddressInto(const std::string& address, char* output, size_t capacity) {
+    if (output != nullptr && address.size() < capacity) {
+        std::memcpy(output, address.c_str(), address.size() + 1);
+    }
+    return address.size();
+}
+
+} // namespace
+
+size_t TWCoinTypeDeriveAddressFromPublicKeyInto(enum TWCoinType coin, const uint8_t *_Nonnull publicKey,
+                                                size_t publicKeySize, char *_Nullable output, size_t capacity) {
+    const auto type = TW::publicKeyType(coin);
+    const TW::Data data(publicKey, publicKey + publicKeySize);
+    if (!TW::PublicKey::isValid(data, type)) {
+        return 0;
+    }
+    return copyAddressInto(TW::deriveAddress(coin, TW::PublicKey(data, type)), output, capacity);
+}
+
+size_t TWCoinTypeDeriveAddressInto(enum TWCoinType coin, const uint8_t *_Nonnull privateKey, size_t privateKeySize,
+                                   char *_Nullable output, size_t capacity) {
+    // the only copy of the key bytes outside the private key's locked memory, wiped after use
+    TW::Data data(privateKey, privateKey + privateKeySize);
+    size_t size = 0;
+    try {
+        if (TW::PrivateKey::isValid(data, TW::curve(coin))) {
+            size = copyAddressInto(TW::deriveAddress(coin, TW::PrivateKey(data)), output, capacity);
+        }
+    } catch (...) {
+        memzero(data.data(), data.size());
+        throw;
+    }
+    memzero(data.data(), data.size());
+    return size;
+}
+
 enum TWHRP TWCoinTypeHRP(enum TWCoinType coin) {
     return TW::hrp(coin);
 }
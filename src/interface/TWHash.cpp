@@ -117,4 +117,39 @@ TWData* _Nonnull TWHashBlake256RIPEMD(TWData* _Nonnull data) {
 TWData* _Nonnull TWHashGroestl512Groestl512(TWData* _Nonnull data) {
     const auto result = Hash::groestl512d(reinterpret_cast<const byte*>(TWDataBytes(data)), TWDataSize(data));
     return TWDataCreateWithBytes(result.data(), result.size());
-}
\ No newline at end of file
+}
+
+void TWHashSHA256Into(const uint8_t* _Nonnull data, size_t size, uint8_t* _Nonnull output) {
+    sha256_Raw(data, size, output);
+}
+
+void TWHashSHA512Into(const uint8_t* _Nonnull data, size_t size, uint8_t* _Nonnull output) {
+    sha512_Raw(data, size, output);
+}
+
+void TWHashKeccak256Into(const uint8_t* _Nonnull data, size_t size, uint8_t* _Nonnull output) {
+    keccak_256(data, size, output);
+}
+
+void TWHashRIPEMDInto(const uint8_t* _Nonnull data, size_t size, uint8_t* _Nonnull output) {
+    ripemd160(data, static_cast<uint32_t>(size), output);
+}
+
+bool TWHashBlake2bInto(const uint8_t* _Nonnull data, size_t size, uint8_t* _Nonnull output, size_t outputSize) {
+    if (outputSize == 0 || outputSize > BLAKE2B_OUTBYTES) {
+        return false;
+    }
+    return blake2b(data, static_cast<uint32_t>(size), output, outputSize) == 0;
+}
+
+void TWHashSHA256SHA256Into(const uint8_t* _Nonnull data, size_t size, uint8_t* _Nonnull output) {
+    std::array<uint8_t, SHA256_DIGEST_LENGTH> first;
+    sha256_Raw(data, size, first.data());
+    sha256_Raw(first.data(), first.size(), output);
+}
+
+void TWHashSHA256RIPEMDInto(const uint8_t* _Nonnull data, size_t size, uint8_t* _Nonnull output) {
+    std::array<uint8_t, SHA256_DIGEST_LENGTH> first;
+    sha256_Raw(data, size, first.data());
+    ripemd160(first.data(), static_cast<uint32_t>(first.size()), output);
+}
@@ -41,7 +41,11 @@ struct TWPrivateKey *_Nullable TWPrivateKeyCreateWithData(TWData *_Nonnull data)
 }
 
 struct TWPrivateKey *_Nullable TWPrivateKeyCreateCopy(struct TWPrivateKey *_Nonnull key) {
-   return new TWPrivateKey{ PrivateKey(key->impl.bytes) };
+    // copies the key bytes only, not the extension and chain code; without going through unprotected memory
+    auto copy = new TWPrivateKey{ key->impl };
+    copy->impl.extensionBytes.clear();
+    copy->impl.chainCodeBytes.clear();
+    return copy;
 }
 
 void TWPrivateKeyDelete(struct TWPrivateKey *_Nonnull pk) {
@@ -28,6 +28,12 @@ public final class AnySigner {
         return TWDataNSData(TWAnySignerSign(inputData, TWCoinType(rawValue: coin.rawValue)))
     }
 
+    /// Signs into output, without allocating, and returns the size of the signed output.  Output is written only if
+    /// it is large enough; an empty output queries the size, which signs too (see `TWAnySignerSignInto`).
+    public static func nativeSignInto(data: Data, coin: CoinType, output: inout Data) -> Int {
+        return operateInto(TWAnySignerSignInto, data: data, coin: coin, output: &output)
+    }
+
     public static func supportsJSON(coin: CoinType) -> Bool {
         return TWAnySignerSupportsJSON(TWCoinType(rawValue: coin.rawValue))
     }
@@ -57,6 +63,10 @@ public final class AnySigner {
         return TWDataNSData(TWAnySignerEncode(inputData, TWCoinType(rawValue: coin.rawValue)))
     }
 
+    public static func nativeEncodeInto(data: Data, coin: CoinType, output: inout Data) -> Int {
+        return operateInto(TWAnySignerEncodeInto, data: data, coin: coin, output: &output)
+    }
+
     public static func decode(data: Data, coin: CoinType) -> Data {
         let inputData = TWDataCreateWithNSData(data)
         defer {
@@ -81,4 +91,24 @@ public final class AnySigner {
         }
         return TWDataNSData(TWAnySignerPlan(inputData, TWCoinType(rawValue: coin.rawValue)))
     }
+
+    public static func nativePlanInto(data: Data, coin: CoinType, output: inout Data) -> Int {
+        return operateInto(TWAnySignerPlanInto, data: data, coin: coin, output: &output)
+    }
+
+    private typealias IntoFunction = (UnsafePointer<UInt8>, Int, TWCoinType, UnsafeMutablePointer<UInt8>?, Int) -> Int
+
+    private static func operateInto(_ function: IntoFunction, data: Data, coin: CoinType, output: inout Data) -> Int {
+        let coinType = TWCoinType(rawValue: coin.rawValue)
+        var empty: UInt8 = 0
+        return data.withUnsafeBytes { (input: UnsafeRawBufferPointer) -> Int in
+            output.withUnsafeMutableBytes { (buffer: UnsafeMutableRawBufferPointer) -> Int in
+                let outputPointer = buffer.bindMemory(to: UInt8.self).baseAddress
+                guard let inputPointer = input.bindMemory(to: UInt8.self).baseAddress else {
+                    return function(&empty, 0, coinType, outputPointer, buffer.count)
+                }
+                return function(inputPointer, input.count, coinType, outputPointer, buffer.count)
+            }
+        }
+    }
 }
@@ -86,3 +86,26 @@ TEST(AlgorandSigner, Sign) {
     ASSERT_EQ(hex(signature), "de73363dbdeda0682adca06f6268a16a6ec47253c94d5692dc1c49a84a05847812cf66d7c4cf07c7e2f50f143ec365d405e30b35117b264a994626054d2af604");
     ASSERT_EQ(hex(result), "82a3736967c440de73363dbdeda0682adca06f6268a16a6ec47253c94d5692dc1c49a84a05847812cf66d7c4cf07c7e2f50f143ec365d405e30b35117b264a994626054d2af604a374786e89a3616d74cd034fa3666565ce000775e3a2667633a367656eac6d61696e6e65742d76312e30a26768c420c061c4d8fc1dbdded2d7604be4568e3f6d041987ac37bde4b620b5ab39248adfa26c763da3726376c420a089aa6922e3b998fadff6cd4808ddf9e021e4944e389ea3d5c638786689197ea3736e64c42074b000b6368551a6066d713e2866002e8dab34b69ede09a72e85a39bbb1f7928a474797065a3706179");
 }
+
+TEST(AlgorandSigner, SignGroup) {
+    std::vector<PrivateKey> keys = {
+        PrivateKey(parse_hex("c9d3cc16fecabe2747eab86b81528c6ed8b65efc1d6906d86aabc27187a1fe7c")),
+        PrivateKey(parse_hex("d5b43d706ef0cb641081d45a2ec213b5d8281f439f2425d1af54e2afdaabf55b")),
+    };
+    Data note;
+    std::string genesisId = "mainnet-v1.0";
+    auto genesisHash = Base64::decode("wGHE2Pwdvd7S12BL5FaOP20EGYesN73ktiC1qzkkit8=");
+    std::vector<Transaction> transactions;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto from = Address(keys[i].getPublicKey(TWPublicKeyTypeED25519));
+        auto to = Address(keys[1 - i].getPublicKey(TWPublicKeyTypeED25519));
+        transactions.emplace_back(from, to, 1000, 847 + i, 51, 61, note, "pay", genesisId, genesisHash);
+    }
+
+    const auto signatures = Signer::sign(keys, transactions);
+    ASSERT_EQ(signatures.size(), transactions.size());
+    EXPECT_EQ(hex(signatures[0]), hex(Signer::sign(keys[0], transactions[0])));
+    EXPECT_EQ(hex(signatures[1]), hex(Signer::sign(keys[1], transactions[1])));
+
+    EXPECT_THROW(Signer::sign({keys[0]}, transactions), std::invalid_argument);
+}
@@ -511,3 +511,118 @@ TEST(Cbor, GetTagElementNotTag) {
     }
     FAIL() << "Expected exception";
 }
+
+TEST(Cbor, EncStateful) {
+    // same as EncSample1, built into a single buffer
+    Encode e;
+    e.beginArray(2)
+        .addUint(5)
+        .beginMap(2)
+            .addString("x").addUint(100)
+            .addString("y").addNegInt(50);
+    EXPECT_EQ("8205a26178186461793831", hex(e.encoded()));
+
+    Encode e2;
+    e2.beginArray(3)
+        .beginTag(24).addBytes(parse_hex("0102"))
+        .beginArray(0)
+        .addEncoded(Encode::map({}));
+    EXPECT_EQ("83d81842010280a0", hex(e2.encoded()));
+}
+
+TEST(Cbor, EncStatefulErrorUnclosed) {
+    Encode e;
+    e.beginArray(2).addUint(1);
+    EXPECT_ANY_THROW(e.encoded());
+    e.addUint(2);
+    EXPECT_EQ("820102", hex(e.encoded()));
+
+    Encode unclosed;
+    unclosed.beginMap(1).addUint(1);
+    Encode outer;
+    EXPECT_ANY_THROW(outer.addEncoded(unclosed));
+}
+
+TEST(Cbor, IterateArray) {
+    Decode cbor = Decode(parse_hex("8301820203820405"));
+    std::vector<std::string> dumps;
+    for (const auto& elem: cbor.iterateArray()) {
+        dumps.push_back(elem.dumpToString());
+    }
+    ASSERT_EQ(3, dumps.size());
+    EXPECT_EQ("1", dumps[0]);
+    EXPECT_EQ("[2, 3]", dumps[1]);
+    EXPECT_EQ("[4, 5]", dumps[2]);
+
+    auto range = cbor.iterateArray();
+    auto it = range.begin();
+    EXPECT_EQ(1, it->getValue());
+    ++it;
+    EXPECT_EQ(2, std::distance(it->iterateArray().begin(), it->iterateArray().end()));
+    it++;
+    ++it;
+    EXPECT_TRUE(it == range.end());
+
+    // indefinite length
+    int count = 0;
+    for (const auto& elem: Decode(parse_hex("9f0102ff")).iterateArray()) {
+        EXPECT_EQ(++count, elem.getValue());
+    }
+    EXPECT_EQ(2, count);
+
+    // empty
+    auto empty = Decode(parse_hex("80")).iterateArray();
+    EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+TEST(Cbor, IterateMap) {
+    Decode cbor = Decode(parse_hex("a2616101616282020304"));
+    auto range = cbor.iterateMap();
+    auto it = range.begin();
+    EXPECT_EQ("a", it->first.getString());
+    EXPECT_EQ(1, it->second.getValue());
+    ++it;
+    EXPECT_EQ("b", it->first.getStringView());
+    EXPECT_EQ("[2, 3]", it->second.dumpToString());
+    ++it;
+    EXPECT_TRUE(it == range.end());
+
+    // indefinite length
+    int count = 0;
+    for (const auto& elem: Decode(parse_hex("bf01020304ff")).iterateMap()) {
+        EXPECT_EQ(2 * count + 1, elem.first.getValue());
+        EXPECT_EQ(2 * count + 2, elem.second.getValue());
+        ++count;
+    }
+    EXPECT_EQ(2, count);
+}
+
+TEST(Cbor, IterateInvalid) {
+    // too short
+    EXPECT_ANY_THROW({
+        for (const auto& elem: Decode(parse_hex("8301")).iterateArray()) { elem.getValue(); }
+    });
+    // not an array
+    EXPECT_ANY_THROW(Decode(parse_hex("a0")).iterateArray());
+    // missing map value
+    EXPECT_ANY_THROW({
+        for (const auto& elem: Decode(parse_hex("bf010203ff")).iterateMap()) { elem.first.getValue(); }
+    });
+}
+
+TEST(Cbor, GetStringView) {
+    Data data = Encode::array({Encode::string("abc"), Encode::bytes(parse_hex("0102"))}).encoded();
+    Decode cbor(std::move(data));
+    auto elems = cbor.getArrayElements();
+    EXPECT_EQ("abc", elems[0].getStringView());
+    EXPECT_EQ(2, elems[1].getStringView().size());
+    EXPECT_EQ("0102", hex(elems[1].getBytes()));
+    EXPECT_ANY_THROW(Decode(parse_hex("01")).getStringView());
+}
+
+TEST(Cbor, DecodeMovedInputNotCopied) {
+    Data data = Encode::string("abc").encoded();
+    const auto* bytes = data.data();
+    Decode cbor(std::move(data));
+    EXPECT_EQ(bytes + 1, reinterpret_cast<const TW::byte*>(cbor.getStringView().data()));
+}
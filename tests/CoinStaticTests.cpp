@@ -0,0 +1,66 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Generated/CoinStatic.h"
+#include "HexCoding.h"
+#include "proto/Filecoin.pb.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace TW {
+
+TEST(CoinStatic, Constants) {
+    static_assert(Coin<TWCoinTypeBitcoin>::p2pkh == 0);
+    static_assert(Coin<TWCoinTypeLitecoin>::p2sh == 50);
+    static_assert(Coin<TWCoinTypeEthereum>::publicKeyType == TWPublicKeyTypeSECP256k1Extended);
+    static_assert(Coin<TWCoinTypeEthereum>::hrp == nullptr);
+    EXPECT_STREQ("bnb", Coin<TWCoinTypeBinance>::hrp);
+}
+
+TEST(CoinStatic, MatchesDispatcher) {
+    const auto keyData = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    const auto privateKey = PrivateKey(keyData);
+    const auto privateKeyExt = PrivateKey(keyData, keyData, keyData);
+
+    size_t count = 0;
+    forEachCoin([&](auto coin) {
+        using StaticCoin = decltype(coin);
+        const auto type = StaticCoin::type;
+        ++count;
+
+        // the entry is the one the dispatcher uses for the coin
+        const auto entryCoins = typename StaticCoin::Entry().coinTypes();
+        EXPECT_NE(std::find(entryCoins.begin(), entryCoins.end(), type), entryCoins.end()) << type;
+
+        const auto& key = StaticCoin::curve == TWCurveED25519Extended ? privateKeyExt : privateKey;
+        const auto address = StaticCoin::deriveAddress(key);
+        EXPECT_EQ(TW::deriveAddress(type, key), address) << type;
+        EXPECT_EQ(TW::validateAddress(type, address), StaticCoin::validateAddress(address)) << type;
+        EXPECT_EQ(TW::normalizeAddress(type, address), StaticCoin::normalizeAddress(address)) << type;
+        EXPECT_FALSE(StaticCoin::validateAddress("")) << type;
+    });
+    EXPECT_EQ(TW::getCoinTypes().size(), count);
+}
+
+TEST(CoinStatic, Sign) {
+    Filecoin::Proto::SigningInput input;
+    auto privateKey = parse_hex("1d969865e189957b9824bd34f26d5cbf357fda1a6d844cbf0c9ab1ed93fa7dbe");
+    input.set_private_key(privateKey.data(), privateKey.size());
+    input.set_to("f3um6uo3qt5of54xjbx3hsxbw5mbsc6auxzrvfxekn5bv3duewqyn2tg5rhrlx73qahzzpkhuj7a34iq7oifsq");
+    input.set_nonce(2);
+    input.set_gas_limit(1000);
+    const auto dataIn = data(input.SerializeAsString());
+
+    Data expected;
+    anyCoinSign(TWCoinTypeFilecoin, dataIn, expected);
+    Data output;
+    Coin<TWCoinTypeFilecoin>::sign(dataIn, output);
+    EXPECT_EQ(hex(expected), hex(output));
+}
+
+} // namespace TW
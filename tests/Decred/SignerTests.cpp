@@ -427,3 +427,78 @@ TEST(DecredSigning, SignP2WPKH_NegativeAddressWrongType) {
 
     ASSERT_FALSE(result) << result.error().text;
 }
+
+TEST(DecredSigner, SignatureHashCache) {
+    auto tx = Transaction();
+    for (uint32_t i = 0; i < 3; ++i) {
+        auto txIn = TransactionInput();
+        txIn.previousOutput = OutPoint(Hash::blake256(Data{static_cast<byte>(i)}), i, 0);
+        txIn.sequence = UINT32_MAX - i;
+        tx.inputs.push_back(txIn);
+    }
+    for (int64_t i = 0; i < 2; ++i) {
+        auto txOut = TransactionOutput();
+        txOut.value = 1000 + i;
+        txOut.script = Bitcoin::Script(parse_hex("76a914f5eba6730a4052ba8c5e0306a91ee7e3b0b1a5a588ac"));
+        tx.outputs.push_back(txOut);
+    }
+    const auto script = Bitcoin::Script(parse_hex("76a914f5eba6730a4052ba8c5e0306a91ee7e3b0b1a5a588ac"));
+    const auto hashTypes = {TWBitcoinSigHashTypeAll, TWBitcoinSigHashTypeNone, TWBitcoinSigHashTypeSingle,
+                            static_cast<TWBitcoinSigHashType>(TWBitcoinSigHashTypeAll | TWBitcoinSigHashTypeAnyoneCanPay)};
+
+    std::vector<std::string> expected;
+    for (auto hashType : hashTypes) {
+        expected.push_back(hex(tx.computeSignatureHash(script, 1, hashType)));
+    }
+    const auto prefixHashCache = tx.computePrefixHashCache();
+    size_t i = 0;
+    for (auto hashType : hashTypes) {
+        EXPECT_EQ(expected[i++], hex(tx.computeSignatureHash(script, 1, hashType, &prefixHashCache))) << hashType;
+    }
+    EXPECT_NE(expected[0], expected[1]);
+
+    // SigHashSingle commits to the output with the index of the input
+    tx.outputs[1].value += 1;
+    EXPECT_NE(expected[2], hex(tx.computeSignatureHash(script, 1, TWBitcoinSigHashTypeSingle)));
+}
+
+TEST(DecredSigner, SignatureHashSingle) {
+    // Preimage laid out by hand following dcrd's calcSignatureHash: with SigHashSingle the prefix commits to outputs
+    // 0 through the signed index, the earlier ones with value -1 and an empty script, and later outputs are left out.
+    const auto script = parse_hex("76a914f5eba6730a4052ba8c5e0306a91ee7e3b0b1a5a588ac");
+    auto tx = Transaction();
+    for (uint32_t i = 0; i < 2; ++i) {
+        auto txIn = TransactionInput();
+        txIn.previousOutput = OutPoint(Data(32, static_cast<byte>(0x11 * (i + 1))), i, 0);
+        txIn.sequence = UINT32_MAX;
+        tx.inputs.push_back(txIn);
+    }
+    for (int64_t i = 0; i < 3; ++i) {
+        auto txOut = TransactionOutput();
+        txOut.value = 1000 * (i + 1);
+        txOut.script = Bitcoin::Script(script);
+        tx.outputs.push_back(txOut);
+    }
+
+    const auto prefix = parse_hex(
+        "01000100"
+        "02"
+        "1111111111111111111111111111111111111111111111111111111111111111" "00000000" "00" "00000000"
+        "2222222222222222222222222222222222222222222222222222222222222222" "01000000" "00" "ffffffff"
+        "02"
+        "ffffffffffffffff" "0000" "00"
+        "d007000000000000" "0000" "19" "76a914f5eba6730a4052ba8c5e0306a91ee7e3b0b1a5a588ac"
+        "00000000"
+        "00000000");
+    const auto witness = parse_hex(
+        "01000300"
+        "02"
+        "00"
+        "19" "76a914f5eba6730a4052ba8c5e0306a91ee7e3b0b1a5a588ac");
+    auto preimage = parse_hex("03000000");
+    append(preimage, Hash::blake256(prefix));
+    append(preimage, Hash::blake256(witness));
+
+    EXPECT_EQ(hex(tx.computeSignatureHash(Bitcoin::Script(script), 1, TWBitcoinSigHashTypeSingle)),
+              hex(Hash::blake256(preimage)));
+}
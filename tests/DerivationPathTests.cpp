@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "DerivationPath.h"
+#include "Coin.h"
 
 #include <gtest/gtest.h>
 
@@ -70,4 +71,56 @@ TEST(DerivationPath, Equal) {
     ASSERT_EQ(path1, path2);
 }
 
+TEST(DerivationPath, InitLimits) {
+    ASSERT_EQ(DerivationPath("m/4294967295'").indices[0], DerivationPathIndex(4294967295, true));
+    ASSERT_THROW(DerivationPath("m/4294967296"), std::invalid_argument);
+    ASSERT_THROW(DerivationPath("m/-1"), std::invalid_argument);
+    ASSERT_THROW(DerivationPath("m//0"), std::invalid_argument);
+    ASSERT_EQ(DerivationPath("m/0/1/2/3/4/5/6/7/8/9").indices.size(), 10);
+    ASSERT_THROW(DerivationPath("m/0/1/2/3/4/5/6/7/8/9/10"), std::invalid_argument);
+
+    DerivationPath path;
+    ASSERT_TRUE(DerivationPath::parse("m/44'/60'/0'/0/0", path));
+    ASSERT_EQ(path, DerivationPath("m/44'/60'/0'/0/0"));
+    ASSERT_FALSE(DerivationPath::parse("m/44'/x", path));
+    ASSERT_FALSE(DerivationPath::parse("m/0/1/2/3/4/5/6/7/8/9/10", path));
+    ASSERT_EQ(path, DerivationPath("m/44'/60'/0'/0/0"));
+}
+
+TEST(DerivationPath, StringBuffer) {
+    const auto path = DerivationPath("m/4294967295'/4294967295'/4294967295'/4294967295'/4294967295'/4294967295'/4294967295'/4294967295'/4294967295'/4294967295'");
+    char buffer[DerivationPath::maxStringLength];
+    const auto length = path.string(buffer);
+    ASSERT_EQ(length, DerivationPath::maxStringLength);
+    ASSERT_EQ(std::string(buffer, length), path.string());
+    ASSERT_EQ(DerivationPath().string(), "m");
+    ASSERT_EQ(DerivationPathIndex(7, false).string(), "7");
+}
+
+TEST(DerivationPath, PrefixAndHash) {
+    const auto path = DerivationPath("m/44'/60'/0'/0/0");
+    const auto account = path.prefix(3);
+    ASSERT_EQ(account, DerivationPath("m/44'/60'/0'"));
+    ASSERT_EQ(path.prefix(10), path);
+    ASSERT_TRUE(path.startsWith(account));
+    ASSERT_TRUE(path.startsWith(DerivationPath()));
+    ASSERT_FALSE(account.startsWith(path));
+    ASSERT_FALSE(path.startsWith(DerivationPath("m/44'/60'/1'")));
+
+    const std::hash<DerivationPath> hasher;
+    ASSERT_EQ(hasher(path), hasher(DerivationPath("44'/60'/0'/0/0")));
+    ASSERT_NE(hasher(path), hasher(DerivationPath("m/44'/60'/0'/0/1")));
+    ASSERT_NE(hasher(path), hasher(DerivationPath("m/44'/60'/0'/0/0'")));
+    ASSERT_NE(hasher(account), hasher(path));
+}
+
+TEST(DerivationPath, CoinDefault) {
+    const auto& path = TW::derivationPath(TWCoinTypeEthereum);
+    ASSERT_EQ(path, DerivationPath("m/44'/60'/0'/0/0"));
+    ASSERT_EQ(&path, &TW::derivationPath(TWCoinTypeEthereum));
+    ASSERT_EQ(TW::derivationPath(TWCoinTypeBitcoin).string(), "m/84'/0'/0'/0/0");
+    ASSERT_EQ(TW::derivationPath(TWCoinTypeSolana).string(), "m/44'/501'/0'");
+    ASSERT_TRUE(TW::derivationPath(TWCoinType(123456)).indices.empty());
+}
+
 } // namespace
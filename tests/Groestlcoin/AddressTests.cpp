@@ -29,6 +29,19 @@ TEST(GroestlcoinAddress, Invalid) {
     ASSERT_FALSE(Address::isValid(std::string("1JAd7XCBzGudGpJQSDSfpmJhiygtLQWaGL"))); // Valid bitcoin address
 }
 
+TEST(GroestlcoinAddress, ValidBatch) {
+    const std::vector<std::string> strings = {
+        "Fj62rBJi8LvbmWu2jzkaUX1NFXLEqDLoZM",
+        "1JAd7XCBzGudGpJQSDSfpmJhiygtLQWaGL", // Valid bitcoin address
+        "",
+        "31inaRqambLsd9D7Ke4USZmGEVd3PHkh7P",
+    };
+    const std::vector<bool> expected = {true, false, false, true};
+    EXPECT_EQ(Address::isValid(strings, {36, 5}), expected);
+    EXPECT_EQ(Address::isValid(strings, {36, 5}, 1), expected);
+    EXPECT_EQ(Address::isValid(strings, {36}), (std::vector<bool>{true, false, false, false}));
+}
+
 TEST(GroestlcoinAddress, FromString) {
     const auto string = "Fj62rBJi8LvbmWu2jzkaUX1NFXLEqDLoZM";
     const auto address = Address(string);
@@ -112,4 +112,42 @@ TEST(HDWallet, privateKeyFromXPRVForDGB) {
     EXPECT_EQ(hex(publicKey.bytes), "03238a5c541c2cbbf769dbe0fb2a373c22db4da029370767fbe746d59da4de07f1");
     EXPECT_EQ(address.string(), "D9Gv7jWSVsS9Y5q98C79WyfEj6P2iM5Nzs");
 }
+
+TEST(HDWallet, deriveAccounts) {
+    const auto wallet = HDWallet("ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal", "");
+    const auto coins = getCoinTypes();
+    const auto accounts = wallet.deriveAccounts(coins);
+    ASSERT_EQ(accounts.size(), coins.size());
+    for (size_t i = 0; i < coins.size(); ++i) {
+        const auto coin = coins[i];
+        const auto purpose = TW::derivationPath(coin).purpose();
+        EXPECT_EQ(accounts[i].address, wallet.deriveAddress(coin)) << coin;
+        EXPECT_EQ(accounts[i].extendedPublicKey, wallet.getExtendedPublicKey(purpose, coin, TW::xpubVersion(coin))) << coin;
+    }
+    EXPECT_TRUE(wallet.deriveAccounts({}).empty());
+}
+
+TEST(HDWallet, deriveAddresses) {
+    const auto wallet = HDWallet("ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal", "");
+    for (const auto coin : {TWCoinTypeSolana, TWCoinTypeStellar, TWCoinTypeNano, TWCoinTypeAlgorand, TWCoinTypeNEAR,
+                            TWCoinTypeBitcoin}) {
+        std::vector<DerivationPath> paths;
+        for (uint32_t account = 0; account < 20; ++account) {
+            auto path = TW::derivationPath(coin);
+            path.setAccount(account);
+            paths.push_back(path);
+        }
+        // a path without a common prefix beyond the purpose
+        paths.push_back(DerivationPath({DerivationPathIndex(44, true), DerivationPathIndex(0, true)}));
+
+        const auto addresses = wallet.deriveAddresses(coin, paths, 3);
+        ASSERT_EQ(addresses.size(), paths.size());
+        for (size_t i = 0; i < paths.size(); ++i) {
+            EXPECT_EQ(addresses[i], TW::deriveAddress(coin, wallet.getKey(coin, paths[i]))) << coin << " " << i;
+        }
+        EXPECT_EQ(wallet.deriveAddresses(coin, {TW::derivationPath(coin)})[0], wallet.deriveAddress(coin));
+    }
+    EXPECT_TRUE(wallet.deriveAddresses(TWCoinTypeSolana, {}).empty());
+}
+
 } // namespace
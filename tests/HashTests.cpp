@@ -6,9 +6,16 @@
 
 #include "Hash.h"
 #include "HexCoding.h"
+#include "../trezor-crypto/crypto/blake256_testing.h"
+#include "../trezor-crypto/crypto/groestl_testing.h"
+
+#include <TrezorCrypto/blake256.h>
+#include <TrezorCrypto/groestl.h>
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 using namespace std;
 using namespace TW;
 
@@ -33,6 +40,98 @@ TEST(HashTests, Blake2bPersonal) {
     ASSERT_EQ(result, string("20d9cd024d4fb086aae819a1432dd2466de12947831b75c5a30cf2676095d3b4"));
 }
 
+/// Returns length bytes of deterministic pseudo-random data.
+static Data randomData(std::mt19937& random, size_t length) {
+    Data data(length);
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(random());
+    }
+    return data;
+}
+
+/// Hashes data in updates of chunk bytes (the last one shorter), with a streaming hash of type Context.
+template <typename Context, typename Init, typename Update, typename Final>
+static Data hashInChunks(const Data& data, size_t chunk, size_t digestSize, Init init, Update update, Final final) {
+    Context ctx;
+    init(&ctx);
+    for (size_t offset = 0; offset < data.size(); offset += chunk) {
+        update(&ctx, data.data() + offset, std::min(chunk, data.size() - offset));
+    }
+    Data hash(digestSize);
+    final(&ctx, hash.data());
+    return hash;
+}
+
+TEST(HashTests, Blake256) {
+    // test vectors from the BLAKE submission
+    EXPECT_EQ(hex(Hash::blake256(Data(1))), "0ce8d4ef4dd7cd8d62dfded9d4edb0a774ae6a41929a74da23109e8f11139c87");
+    EXPECT_EQ(hex(Hash::blake256(Data(72))), "d419bad32d504fb7d44d460c42c5593fe544fa4c135dec31e21bd9abdcc22d41");
+    EXPECT_EQ(hex(Hash::blake256(brownFox)), "7576698ee9cad30173080678e5965916adbb11cb5245d386bf1ffda1cb26c9d7");
+
+    // updates around the 64-byte block boundary, including the padding-only final block
+    std::mt19937 random(256);
+    for (size_t length : {55, 56, 64, 119, 120, 128, 1000}) {
+        const auto data = randomData(random, length);
+        const auto expected = hex(Hash::blake256(data));
+        for (size_t chunk : {1, 13, 63, 64, 65, 200}) {
+            EXPECT_EQ(expected, hex(hashInChunks<BLAKE256_CTX>(data, chunk, BLAKE256_DIGEST_LENGTH, blake256_Init,
+                                                               blake256_Update, blake256_Final)))
+                << length << " " << chunk;
+        }
+    }
+}
+
+TEST(HashTests, Blake256Portable) {
+    // the SSSE3 code, where available, gives the same hashes as the portable code
+    std::mt19937 random(42);
+    std::vector<Data> inputs;
+    std::vector<std::string> expected;
+    for (size_t length = 0; length < 300; length += 7) {
+        inputs.push_back(randomData(random, length));
+        expected.push_back(hex(Hash::blake256(inputs.back())));
+    }
+    blake256_force_portable(1);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        EXPECT_EQ(expected[i], hex(Hash::blake256(inputs[i]))) << inputs[i].size();
+    }
+    blake256_force_portable(0);
+}
+
+TEST(HashTests, Groestl512) {
+    EXPECT_EQ(hex(Hash::groestl512(Data())), "6d3ad29d279110eef3adbd66de2a0345a77baede1557f5d099fce0c03d6dc2ba8e6d4a6633dfbd66053c20faa87d1a11f39a7fbe4a6c2f009801370308fc4ad8");
+    EXPECT_EQ(hex(Hash::groestl512(brownFox)), "badc1f70ccd69e0cf3760c3f93884289da84ec13c70b3d12a53a7a8a4a513f99715d46288f55e1dbf926e6d084a0538e4eebfc91cf2b21452921ccde9131718d");
+
+    // the AES-NI code compresses whole blocks of an update in place: updates that fill the buffered block and
+    // continue with several whole blocks, and updates that end within the 128-byte block
+    std::mt19937 random(512);
+    const auto data = randomData(random, 1000);
+    const auto expected = hex(Hash::groestl512(data));
+    for (size_t chunk : {1, 100, 127, 128, 129, 256, 300, 999}) {
+        EXPECT_EQ(expected, hex(hashInChunks<GROESTL512_CTX>(data, chunk, 64, groestl512_Init, groestl512_Update,
+                                                             groestl512_Final)))
+            << chunk;
+    }
+}
+
+TEST(HashTests, Groestl512Portable) {
+    // the AES-NI code, where available, gives the same hashes as the portable table code, also for the double hash
+    const auto hashes = [](const Data& data) {
+        return hex(Hash::groestl512(data)) + hex(Hash::groestl512d(data.data(), data.size()));
+    };
+    std::mt19937 random(43);
+    std::vector<Data> inputs;
+    std::vector<std::string> expected;
+    for (size_t length = 0; length < 600; length += 11) {
+        inputs.push_back(randomData(random, length));
+        expected.push_back(hashes(inputs.back()));
+    }
+    groestl512_force_portable(1);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        EXPECT_EQ(expected[i], hashes(inputs[i])) << inputs[i].size();
+    }
+    groestl512_force_portable(0);
+}
+
 TEST(HashTests, Sha512_256) {
     auto tests = {
         make_tuple(string(""), string("c672b8d1ef56ed28ab87c3622c5114069bdd3ad7b8f9737498d0c01ecef0967a")),
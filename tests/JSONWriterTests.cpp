@@ -0,0 +1,95 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "JSONWriter.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+using namespace TW;
+using json = nlohmann::json;
+
+TEST(JSONWriter, Document) {
+    JSONWriter writer;
+    writer.beginObject()
+        .field("amount", 1000)
+        .key("coins").beginArray()
+            .beginObject().field("amount", "10").field("denom", "uatom").endObject()
+            .value(-1)
+            .null()
+        .endArray()
+        .key("empty").beginObject().endObject()
+        .field("memo", "")
+        .key("raw").raw(json::parse(R"({"b":1,"a":[true]})").dump())
+        .field("valid", false)
+        .endObject();
+
+    const json expected = {
+        {"amount", 1000},
+        {"coins", json::array({{{"denom", "uatom"}, {"amount", "10"}}, -1, nullptr})},
+        {"empty", json::object()},
+        {"memo", ""},
+        {"raw", {{"a", {true}}, {"b", 1}}},
+        {"valid", false},
+    };
+    EXPECT_EQ(writer.string(), expected.dump());
+    EXPECT_EQ(writer.release(), expected.dump());
+    EXPECT_EQ(writer.string(), "");
+}
+
+TEST(JSONWriter, Escaping) {
+    const std::string value = "quote\" backslash\\ slash/ \b\f\n\r\t \x01\x1f\x7f unicode \xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80";
+    JSONWriter writer;
+    writer.beginArray().value(value).endArray();
+    EXPECT_EQ(writer.string(), json::array({value}).dump());
+    EXPECT_EQ(writer.string(), R"(["quote\" backslash\\ slash/ \b\f\n\r\t \u0001\u001f)" "\x7f" R"( unicode é€😀"])");
+}
+
+TEST(JSONWriter, InvalidUTF8) {
+    for (const auto& value : {"\xff", "\xc3", "\xc0\xaf", "\xed\xa0\x80", "\xf4\x90\x80\x80", "a\xe2\x82"}) {
+        JSONWriter writer;
+        EXPECT_THROW(writer.value(std::string(value)), std::invalid_argument) << value;
+    }
+}
+
+TEST(JSONWriter, KeyOrder) {
+    JSONWriter writer;
+    writer.beginObject().field("b", 1);
+    EXPECT_THROW(writer.key("a"), std::logic_error);
+
+    JSONWriter duplicate;
+    duplicate.beginObject().field("a", 1);
+    EXPECT_THROW(duplicate.key("a"), std::logic_error);
+
+    JSONWriter prefix;
+    prefix.beginObject().field("a", 1).field("a b", 2).field("validator", 3).field("validator_address", 4).endObject();
+    EXPECT_EQ(prefix.string(), R"({"a":1,"a b":2,"validator":3,"validator_address":4})");
+}
+
+TEST(JSONWriter, Structure) {
+    {
+        JSONWriter writer;
+        writer.beginObject();
+        EXPECT_THROW(writer.value(1), std::logic_error);
+    }
+    {
+        JSONWriter writer;
+        writer.beginObject().key("a");
+        EXPECT_THROW(writer.endObject(), std::logic_error);
+    }
+    {
+        JSONWriter writer;
+        writer.beginArray();
+        EXPECT_THROW(writer.key("a"), std::logic_error);
+        EXPECT_THROW(writer.endObject(), std::logic_error);
+        EXPECT_THROW(writer.release(), std::logic_error);
+    }
+    {
+        JSONWriter writer;
+        writer.value(1);
+        EXPECT_THROW(writer.value(2), std::logic_error);
+    }
+}
@@ -0,0 +1,100 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keystore/KeyStoreDirectory.h"
+
+#include "../interface/TWTestUtilities.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+extern std::string TESTS_ROOT;
+
+namespace TW::Keystore {
+
+using namespace std;
+
+static string createTempDirectory() {
+    auto pattern = getTestTempDir() + "/KeyStoreDirectoryXXXXXX";
+    return string(mkdtemp(pattern.data()));
+}
+
+static void copyFile(const string& from, const string& to) {
+    ifstream in(from, ios::binary);
+    ofstream out(to, ios::binary);
+    out << in.rdbuf();
+}
+
+TEST(KeyStoreDirectory, RefreshAndFind) {
+    const auto dir = createTempDirectory();
+    copyFile(TESTS_ROOT + "/Keystore/Data/key.json", dir + "/key.json");
+    copyFile(TESTS_ROOT + "/Keystore/Data/wallet.json", dir + "/wallet.json");
+    ofstream(dir + "/notakey.txt") << "not a key";
+
+    KeyStoreDirectory keys(dir);
+    EXPECT_EQ(keys.refresh(), 2);
+    EXPECT_EQ(keys.size(), 2);
+    EXPECT_EQ(keys.all().size(), 2);
+
+    const auto* entry = keys.findByAddress(TWCoinTypeEthereum, "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->fileName, "key.json");
+    EXPECT_EQ(entry->id, "e13b209c-3b2f-4327-bab0-3bef2e51630d");
+    EXPECT_EQ(entry->name, "Test Account");
+    EXPECT_EQ(keys.findById("e13b209c-3b2f-4327-bab0-3bef2e51630d"), entry);
+
+    const auto key = keys.load(*entry);
+    EXPECT_EQ(key.accounts[0].address, "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b");
+
+    EXPECT_NE(keys.findById("e0fe53d0-7a3d-4f65-88b1-9bb4e245a169"), nullptr);
+    EXPECT_EQ(keys.findByAddress(TWCoinTypeBitcoin, "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b"), nullptr);
+    EXPECT_EQ(keys.findById("missing"), nullptr);
+
+    // nothing changed
+    EXPECT_EQ(keys.refresh(), 0);
+}
+
+TEST(KeyStoreDirectory, IndexFile) {
+    const auto dir = createTempDirectory();
+    copyFile(TESTS_ROOT + "/Keystore/Data/key.json", dir + "/key.json");
+    copyFile(TESTS_ROOT + "/Keystore/Data/wallet.json", dir + "/wallet.json");
+    {
+        KeyStoreDirectory keys(dir);
+        EXPECT_EQ(keys.refresh(), 2);
+    }
+
+    // second instance is served from the index file
+    KeyStoreDirectory keys(dir);
+    EXPECT_EQ(keys.refresh(), 0);
+    EXPECT_EQ(keys.size(), 2);
+    EXPECT_NE(keys.findByAddress(TWCoinTypeEthereum, "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b"), nullptr);
+
+    // removed file
+    std::remove((dir + "/wallet.json").c_str());
+    EXPECT_EQ(keys.refresh(), 1);
+    EXPECT_EQ(keys.size(), 1);
+    EXPECT_EQ(keys.findById("e0fe53d0-7a3d-4f65-88b1-9bb4e245a169"), nullptr);
+
+    // modified file
+    ofstream(dir + "/key.json", ios::app) << "\n";
+    EXPECT_EQ(keys.refresh(), 1);
+    EXPECT_NE(keys.findById("e13b209c-3b2f-4327-bab0-3bef2e51630d"), nullptr);
+
+    // added file
+    copyFile(TESTS_ROOT + "/Keystore/Data/wallet.json", dir + "/wallet2.json");
+    EXPECT_EQ(keys.refresh(), 1);
+    EXPECT_EQ(keys.size(), 2);
+}
+
+TEST(KeyStoreDirectory, Nonexistent) {
+    KeyStoreDirectory keys(TESTS_ROOT + "/Keystore/Data/nonexistent");
+    EXPECT_THROW(keys.refresh(), std::invalid_argument);
+}
+
+} // namespace TW::Keystore
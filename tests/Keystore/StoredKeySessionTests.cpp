@@ -0,0 +1,89 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keystore/StoredKeySession.h"
+
+#include "Coin.h"
+#include "HexCoding.h"
+#include "Data.h"
+#include "PrivateKey.h"
+
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+
+namespace TW::Keystore {
+
+using namespace std;
+
+static const auto sessionPassword = TW::data(string("password"));
+static const auto sessionMnemonic = "team engine square letter hero song dizzy scrub tornado fabric divert saddle";
+
+TEST(StoredKeySession, Mnemonic) {
+    auto key = StoredKey::createWithMnemonic("name", sessionPassword, sessionMnemonic);
+    StoredKeySession session(key, sessionPassword);
+    ASSERT_TRUE(session.isUnlocked());
+
+    EXPECT_EQ(session.wallet().mnemonic, sessionMnemonic);
+    EXPECT_EQ(session.account(TWCoinTypeEthereum)->address, "0x494f60cb6Ac2c8F5E1393aD9FdBdF4Ad589507F7");
+    EXPECT_EQ(key.accounts.size(), 1);
+
+    const auto privateKey = session.privateKey(TWCoinTypeEthereum);
+    EXPECT_EQ(hex(privateKey.bytes), hex(key.privateKey(TWCoinTypeEthereum, sessionPassword).bytes));
+    EXPECT_EQ(hex(session.privateKey(TWCoinTypeBitcoin).bytes), hex(key.wallet(sessionPassword).getKey(TWCoinTypeBitcoin, TW::derivationPath(TWCoinTypeBitcoin)).bytes));
+    EXPECT_EQ(key.accounts.size(), 2);
+}
+
+TEST(StoredKeySession, PrivateKey) {
+    const auto privateKey = parse_hex("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266");
+    auto key = StoredKey::createWithPrivateKeyAddDefaultAddress("name", sessionPassword, TWCoinTypeBitcoin, privateKey);
+    key.accounts[0].address = "";
+
+    StoredKeySession session(key, sessionPassword);
+    EXPECT_EQ(hex(session.privateKey(TWCoinTypeBitcoin).bytes), hex(privateKey));
+    EXPECT_THROW(session.wallet(), std::invalid_argument);
+
+    session.fixAddresses();
+    EXPECT_EQ(key.accounts[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
+}
+
+TEST(StoredKeySession, InvalidPassword) {
+    auto key = StoredKey::createWithMnemonic("name", sessionPassword, sessionMnemonic);
+    EXPECT_THROW(StoredKeySession(key, TW::data(string("wrong"))), DecryptionError);
+}
+
+TEST(StoredKeySession, Lock) {
+    auto key = StoredKey::createWithMnemonic("name", sessionPassword, sessionMnemonic);
+    StoredKeySession session(key, sessionPassword);
+    session.lock();
+    EXPECT_FALSE(session.isUnlocked());
+    EXPECT_THROW(session.privateKey(TWCoinTypeEthereum), std::runtime_error);
+    EXPECT_THROW(session.wallet(), std::runtime_error);
+}
+
+TEST(StoredKeySession, Expired) {
+    auto key = StoredKey::createWithMnemonic("name", sessionPassword, sessionMnemonic);
+    StoredKeySession session(key, sessionPassword, std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_FALSE(session.isUnlocked());
+    EXPECT_THROW(session.account(TWCoinTypeEthereum), std::runtime_error);
+    EXPECT_EQ(key.accounts.size(), 0);
+}
+
+TEST(StoredKeySession, PurgeExpired) {
+    auto key = StoredKey::createWithMnemonic("name", sessionPassword, sessionMnemonic);
+    StoredKeySession active(key, sessionPassword);
+    EXPECT_FALSE(active.purgeExpired());
+    EXPECT_TRUE(active.isUnlocked());
+
+    StoredKeySession session(key, sessionPassword, std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_TRUE(session.purgeExpired());
+    EXPECT_FALSE(session.purgeExpired());
+    EXPECT_THROW(session.wallet(), std::runtime_error);
+}
+
+} // namespace TW::Keystore
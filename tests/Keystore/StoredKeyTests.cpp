@@ -216,6 +216,15 @@ TEST(StoredKey, WalletInvalid) {
     FAIL() << "Missing expected exception";
 }
 
+TEST(StoredKey, AccountPathTooDeep) {
+    auto indices = nlohmann::json::array();
+    for (uint32_t i = 0; i <= DerivationPathIndices::maxSize; ++i) {
+        indices.push_back({{"value", i}, {"hardened", false}});
+    }
+    const nlohmann::json json = {{"derivationPath", {{"indices", indices}}}, {"coin", 60}};
+    EXPECT_THROW(Account{json}, std::invalid_argument);
+}
+
 TEST(StoredKey, LoadNonexistent) {
     ASSERT_THROW(StoredKey::load(TESTS_ROOT + "/Keystore/Data/nonexistent.json"), invalid_argument);
 }
@@ -370,4 +379,24 @@ TEST(StoredKey, EtherWalletAddressNo0x) {
     EXPECT_EQ(key.account(TWCoinTypeEthereum, nullptr)->address, "0xAc1ec44E4f0ca7D172B7803f6836De87Fb72b309");
 }
 
+TEST(StoredKey, AddAccounts) {
+    auto key = StoredKey::createWithMnemonic("name", password, mnemonic);
+    const auto wallet = key.wallet(password);
+    key.addAccount("", coinTypeBc, TW::derivationPath(coinTypeBc), "");
+
+    key.addAccounts({coinTypeBc, coinTypeEth, coinTypeBnb, coinTypeEth, TWCoinTypeSolana, TWCoinTypeCardano}, wallet);
+    ASSERT_EQ(key.accounts.size(), 5);
+    EXPECT_EQ(key.accounts[0].coin, coinTypeBc);
+    EXPECT_EQ(key.accounts[0].address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+    EXPECT_EQ(key.accounts[1].address, "0x494f60cb6Ac2c8F5E1393aD9FdBdF4Ad589507F7");
+    EXPECT_EQ(key.accounts[2].address, wallet.deriveAddress(coinTypeBnb));
+    EXPECT_EQ(key.accounts[3].address, wallet.deriveAddress(TWCoinTypeSolana));
+    EXPECT_EQ(key.accounts[4].address, wallet.deriveAddress(TWCoinTypeCardano));
+
+    StoredKey other = StoredKey::createWithMnemonic("name", password, mnemonic);
+    EXPECT_EQ(other.account(coinTypeBc, &wallet)->extendedPublicKey, "zpub6qbsWdbcKW9sC6shTKK4VEhfWvDCoWpfLnnVfYKHLHt31wKYUwH3aFDz4WLjZvjHZ5W4qVEyk37cRwzTbfrrT1Gnu8SgXawASnkdQ994atn");
+    other.addAccounts({coinTypeEth}, wallet);
+    EXPECT_EQ(other.accounts[1].derivationPath.string(), "m/44'/60'/0'/0/0");
+}
+
 } // namespace TW::Keystore
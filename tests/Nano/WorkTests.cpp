@@ -0,0 +1,76 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Nano/Work.h"
+#include "Nano/Signer.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Nano;
+
+static std::array<byte, 32> rootFromHex(const std::string& string) {
+    const auto data = parse_hex(string);
+    std::array<byte, 32> root = {0};
+    std::copy_n(data.begin(), root.size(), root.begin());
+    return root;
+}
+
+TEST(NanoWork, Value) {
+    const auto root = rootFromHex("718CC2121C3E641059BC1C2CFC45666C99E8AE922F7A807B7D07B62C995D79E2");
+    const auto work = Work::parse("2bf29ef00786a6bc");
+    EXPECT_EQ(hex(Work::value(root, work)), "ffffffd21c3933f4");
+    EXPECT_TRUE(Work::isValid(root, work, 0xffffffc000000000));
+    EXPECT_FALSE(Work::isValid(root, work, Work::sendThreshold));
+    EXPECT_FALSE(Work::isValid(root, work + 1, 0xffffffc000000000));
+}
+
+TEST(NanoWork, Generate) {
+    const auto root = rootFromHex("f9a323153daefe041efb94d69b9669c882c935530ed953bbe8a665dfedda9696");
+    const uint64_t threshold = 0xfff0000000000000;
+    const auto work = Work::generate(root, threshold);
+    ASSERT_TRUE(work.has_value());
+    EXPECT_TRUE(Work::isValid(root, *work, threshold));
+
+    const auto singleThreaded = Work::generate(root, threshold, 1);
+    ASSERT_TRUE(singleThreaded.has_value());
+    EXPECT_TRUE(Work::isValid(root, *singleThreaded, threshold));
+}
+
+TEST(NanoWork, GenerateCancelled) {
+    const auto root = rootFromHex("f9a323153daefe041efb94d69b9669c882c935530ed953bbe8a665dfedda9696");
+    std::atomic<bool> cancel(true);
+    EXPECT_FALSE(Work::generate(root, 0xffffffffffffffff, 2, &cancel).has_value());
+}
+
+TEST(NanoWork, String) {
+    EXPECT_EQ(Work::string(0x2bf29ef00786a6bc), "2bf29ef00786a6bc");
+    EXPECT_EQ(Work::string(1), "0000000000000001");
+    EXPECT_EQ(Work::parse("0000000000000001"), 1);
+    EXPECT_THROW(Work::parse("2bf29ef00786a6"), std::invalid_argument);
+    EXPECT_THROW(Work::parse("2bf29ef00786a6zz"), std::invalid_argument);
+}
+
+TEST(NanoWork, Root) {
+    const auto privateKey = parse_hex("173c40e97fe2afcd24187e74f6b603cb949a5365e72fbdd065a6b165e2189e34");
+    const auto linkBlock = parse_hex("491fca2c69a84607d374aaf1f6acd3ce70744c5be0721b5ed394653e85233507");
+
+    auto input = Proto::SigningInput();
+    input.set_private_key(privateKey.data(), privateKey.size());
+    input.set_link_block(linkBlock.data(), linkBlock.size());
+    input.set_representative("xrb_3arg3asgtigae3xckabaaewkx3bzsh7nwz7jkmjos79ihyaxwphhm6qgjps4");
+    input.set_balance("96242336390000000000000000000");
+    {
+        const auto signer = Signer(input);
+        EXPECT_EQ(hex(signer.workRoot()), hex(signer.publicKey.bytes));
+    }
+
+    const auto parentBlock = parse_hex("f9a323153daefe041efb94d69b9669c882c935530ed953bbe8a665dfedda9696");
+    input.set_parent_block(parentBlock.data(), parentBlock.size());
+    const auto signer = Signer(input);
+    EXPECT_EQ(hex(signer.workRoot()), "f9a323153daefe041efb94d69b9669c882c935530ed953bbe8a665dfedda9696");
+}
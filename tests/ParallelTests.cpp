@@ -0,0 +1,69 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Parallel.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace TW {
+
+TEST(Parallel, ProcessesAllItems) {
+    std::vector<int> done(100, 0);
+    parallelFor(done.size(), [&](size_t i) { done[i] += 1; }, 4);
+    EXPECT_EQ(std::count(done.begin(), done.end(), 1), 100);
+}
+
+TEST(Parallel, RethrowsFirstException) {
+    EXPECT_THROW(parallelFor(10, [](size_t i) {
+        if (i == 3) {
+            throw std::runtime_error("item failed");
+        }
+    }, 4), std::runtime_error);
+}
+
+TEST(Parallel, NestedCallsRunOnCallingThread) {
+    std::vector<std::vector<std::thread::id>> threads(4, std::vector<std::thread::id>(8));
+    std::vector<std::thread::id> outer(4);
+    parallelFor(4, [&](size_t i) {
+        outer[i] = std::this_thread::get_id();
+        parallelFor(8, [&](size_t j) { threads[i][j] = std::this_thread::get_id(); }, 4);
+    }, 4);
+    for (size_t i = 0; i < 4; ++i) {
+        for (const auto& id : threads[i]) {
+            EXPECT_EQ(id, outer[i]);
+        }
+    }
+
+    // the calling thread runs items in parallel again afterwards
+    std::vector<std::thread::id> after(64);
+    parallelFor(after.size(), [&](size_t i) {
+        after[i] = std::this_thread::get_id();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }, 4);
+    EXPECT_TRUE(std::any_of(after.begin(), after.end(), [](auto id) { return id != std::this_thread::get_id(); }));
+}
+
+TEST(Parallel, ReusesPoolThreads) {
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+    for (int call = 0; call < 100; ++call) {
+        parallelFor(8, [&](size_t) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ids.insert(std::this_thread::get_id());
+        }, 8);
+    }
+    EXPECT_LE(ids.size(), internal::WorkerPool::maxThreads + 1);
+}
+
+} // namespace TW
@@ -0,0 +1,76 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Polkadot/ExtrinsicTemplate.h"
+#include "Polkadot/Signer.h"
+#include "Polkadot/Address.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "proto/Polkadot.pb.h"
+#include "uint256.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Polkadot {
+
+Proto::SigningInput transferInput(uint64_t nonce, uint64_t blockNumber, const Data& blockHash, const Address& to, const uint256_t& value) {
+    const auto privateKey = PrivateKey(parse_hex("70a794d4f1019c3ce002f33062f45029c4f930a56b3d20ec477f7668c6bbc37f"));
+    const auto genesisHash = parse_hex("91b171bb158e2d3848fa23a9f1c25182fb8e20313b2c1eb49219da7a70ce90c3");
+
+    auto input = Proto::SigningInput();
+    input.set_genesis_hash(genesisHash.data(), genesisHash.size());
+    input.set_block_hash(blockHash.data(), blockHash.size());
+    input.set_nonce(nonce);
+    input.set_spec_version(26);
+    input.set_private_key(privateKey.bytes.data(), privateKey.bytes.size());
+    input.set_network(Proto::Network::POLKADOT);
+    input.set_transaction_version(5);
+    if (blockNumber != 0) {
+        auto era = input.mutable_era();
+        era->set_block_number(blockNumber);
+        era->set_period(64);
+    }
+    auto transfer = input.mutable_balance_call()->mutable_transfer();
+    auto storedValue = store(value);
+    transfer->set_to_address(to.string());
+    transfer->set_value(storedValue.data(), storedValue.size());
+    return input;
+}
+
+TEST(PolkadotExtrinsicTemplate, Sign) {
+    const auto blockHash = parse_hex("0x5d2143bb808626d63ad7e1cda70fa8697059d670a992e82cd440fbb95ea40351");
+    const auto to = Address("13ZLCqJNPsRZYEbwjtZZFpWt9GyFzg5WahXCVWKpWdUJqrQ5");
+    const auto input = transferInput(3, 3541050, blockHash, to, 2000000000);
+
+    auto extrinsicTemplate = ExtrinsicTemplate(input);
+    // https://polkadot.subscan.io/extrinsic/0x9fd06208a6023e489147d8d93f0182b0cb7e45a40165247319b87278e08362d8
+    EXPECT_EQ(hex(extrinsicTemplate.sign()), "3502849dca538b7a925b8ea979cc546464a3c5f81d2398a3a272f6f93bdf4803f2f7830073e59cef381aedf56d7af076bafff9857ffc1e3bd7d1d7484176ff5b58b73f1211a518e1ed1fd2ea201bd31869c0798bba4ffe753998c409d098b65d25dff801a5030c0005007120f76076bcb0efdf94c7219e116899d0163ea61cb428183d71324eb33b2bce0300943577");
+}
+
+TEST(PolkadotExtrinsicTemplate, Patch) {
+    const auto blockHash = parse_hex("0x5d2143bb808626d63ad7e1cda70fa8697059d670a992e82cd440fbb95ea40351");
+    const auto to = Address("13ZLCqJNPsRZYEbwjtZZFpWt9GyFzg5WahXCVWKpWdUJqrQ5");
+    auto extrinsicTemplate = ExtrinsicTemplate(transferInput(3, 3541050, blockHash, to, 2000000000));
+
+    const auto otherBlockHash = parse_hex("0x6d2143bb808626d63ad7e1cda70fa8697059d670a992e82cd440fbb95ea40351");
+    const auto otherTo = Address("14xKzzU1ZYDnzFj7FgdtDAYSMJNARjDc2gNw4XAFDgr4uXgp");
+    Data encoded;
+    for (uint64_t nonce = 4; nonce < 7; ++nonce) {
+        const auto value = uint256_t(1000000000) * nonce;
+        extrinsicTemplate.setNonce(nonce);
+        extrinsicTemplate.setEra(3541100, 64, otherBlockHash);
+        extrinsicTemplate.setTransfer(otherTo, value);
+        extrinsicTemplate.sign(encoded);
+        EXPECT_EQ(hex(encoded), hex(Signer::sign(transferInput(nonce, 3541100, otherBlockHash, otherTo, value)).encoded()));
+    }
+
+    // immortal era, checked against the genesis block
+    const auto genesisHash = parse_hex("91b171bb158e2d3848fa23a9f1c25182fb8e20313b2c1eb49219da7a70ce90c3");
+    extrinsicTemplate.setImmortalEra();
+    EXPECT_EQ(hex(extrinsicTemplate.sign()), hex(Signer::sign(transferInput(6, 0, genesisHash, otherTo, 6000000000)).encoded()));
+}
+
+} // namespace TW::Polkadot
@@ -40,6 +40,21 @@ TEST(PolkadotCodec, EncodeCompact) {
     ASSERT_EQ(hex(encodeCompact(18446744073709551615u)), "13ffffffffffffffff");
 }
 
+TEST(PolkadotCodec, EncodeCompactBigInteger) {
+    // beyond 64 bits
+    ASSERT_EQ(hex(encodeCompact(CompactInteger(1) << 64)), "17000000000000000001");
+    ASSERT_EQ(hex(encodeCompact(CompactInteger(18446744073709551615u))), "13ffffffffffffffff");
+
+    // appending, and the predicted sizes
+    Data data;
+    for (uint64_t value : {0ull, 63ull, 64ull, 16383ull, 16384ull, 1073741823ull, 1073741824ull, 4294967296ull, 18446744073709551615ull}) {
+        const auto size = data.size();
+        encodeCompact(value, data);
+        EXPECT_EQ(data.size() - size, compactSize(value)) << value;
+        EXPECT_EQ(hex(Data(data.begin() + size, data.end())), hex(encodeCompact(CompactInteger(value)))) << value;
+    }
+}
+
 TEST(PolkadotCodec, EncodeBool) {
     ASSERT_EQ(hex(encodeBool(true)), "01");    
     ASSERT_EQ(hex(encodeBool(false)), "00");
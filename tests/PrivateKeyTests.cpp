@@ -131,6 +131,28 @@ TEST(PrivateKey, PublicKey) {
     }
 }
 
+TEST(PrivateKey, PublicKeys) {
+    // more than one batch, and a partial one
+    std::vector<PrivateKey> privateKeys;
+    for (int i = 0; i < 37; ++i) {
+        privateKeys.emplace_back(Hash::sha256(data(std::to_string(i))));
+    }
+    for (const auto type : {TWPublicKeyTypeED25519, TWPublicKeyTypeED25519Blake2b, TWPublicKeyTypeSECP256k1}) {
+        const auto publicKeys = PrivateKey::getPublicKeys(privateKeys, type);
+        ASSERT_EQ(publicKeys.size(), privateKeys.size());
+        for (size_t i = 0; i < privateKeys.size(); ++i) {
+            EXPECT_EQ(publicKeys[i].type, type);
+            EXPECT_EQ(hex(publicKeys[i].bytes), hex(privateKeys[i].getPublicKey(type).bytes)) << type << " " << i;
+        }
+    }
+    EXPECT_TRUE(PrivateKey::getPublicKeys({}, TWPublicKeyTypeED25519).empty());
+
+    // RFC 8032 test 1
+    const auto rfcKey = PrivateKey(parse_hex("9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60"));
+    EXPECT_EQ(hex(PrivateKey::getPublicKeys({rfcKey}, TWPublicKeyTypeED25519)[0].bytes),
+              "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a");
+}
+
 TEST(PrivateKey, Cleanup) {
     Data privKeyData = parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
     auto privateKey = new PrivateKey(privKeyData);
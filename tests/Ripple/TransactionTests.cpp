@@ -124,3 +124,100 @@ TEST(RippleTransaction, preImage) {
     );
     ASSERT_EQ(unsignedTx.size(), 114);
 }
+
+TEST(RippleTransaction, deserialize) {
+    const auto signed_ = parse_hex("12000022800000002400000001614000000001ba8140684000000000030d407321026cc34b92cefb3a4537b3edb0b6044c04af27c01583c577823ecc69a9a21119b6744630440220067f20b3eebfc7107dd0bcc72337a236ac3be042c0469f2341d76694a17d4bb9022048393d7ee7dcb729783b33f5038939ddce1bb8337e66d752974626854556bbb681148400b6b6d08d5d495653d73eda6804c249a5148883148132e4e20aecf29090ac428a9c43f230a829220d");
+    const auto tx1 = Transaction::deserialize(signed_);
+    EXPECT_EQ(tx1.amount, 29000000);
+    EXPECT_EQ(tx1.fee, 200000);
+    EXPECT_EQ(tx1.flags, 2147483648);
+    EXPECT_EQ(tx1.sequence, 1);
+    EXPECT_EQ(tx1.last_ledger_sequence, 0);
+    EXPECT_EQ(tx1.account.string(), "rDpysuumkweqeC7XdNgYNtzL5GxbdsmrtF");
+    EXPECT_EQ(Address(tx1.destination).string(), "rU893viamSnsfP3zjzM2KPxjqZjXSXK6VF");
+    EXPECT_FALSE(tx1.encode_tag);
+    EXPECT_EQ(hex(tx1.pub_key), "026cc34b92cefb3a4537b3edb0b6044c04af27c01583c577823ecc69a9a21119b6");
+    EXPECT_EQ(tx1.signature.size(), 70ul);
+    EXPECT_EQ(hex(tx1.serialize()), hex(signed_));
+
+    const auto unsigned_ = parse_hex("120000220000000024000000012ef72d50ca6140000000017d784068400000000000000c8114e851bbbe79e328e43d68f43445368133df5fba5a831476dac5e814cd4aa74142c3ab45e69a900e637aa2");
+    const auto tx2 = Transaction::deserialize(unsigned_);
+    EXPECT_TRUE(tx2.encode_tag);
+    EXPECT_EQ(tx2.destination_tag, 4146942154);
+    EXPECT_TRUE(tx2.pub_key.empty());
+    EXPECT_TRUE(tx2.signature.empty());
+    EXPECT_EQ(hex(tx2.serialize()), hex(unsigned_));
+}
+
+TEST(RippleTransaction, deserializeInvalid) {
+    const auto valid = parse_hex("120000220000000024000000026140000000017d784068400000000000000a81145ccb151f6e9d603f394ae778acf10d3bece874f68314e851bbbe79e328e43d68f43445368133df5fba5a");
+    ASSERT_NO_THROW(Transaction::deserialize(valid));
+
+    // truncated
+    EXPECT_THROW(Transaction::deserialize(Data(valid.begin(), valid.end() - 1)), std::invalid_argument);
+    // missing destination
+    EXPECT_THROW(Transaction::deserialize(Data(valid.begin(), valid.end() - 22)), std::invalid_argument);
+    // flags before type
+    auto reordered = Data(valid.begin() + 3, valid.begin() + 8);
+    reordered.insert(reordered.end(), valid.begin(), valid.begin() + 3);
+    reordered.insert(reordered.end(), valid.begin() + 8, valid.end());
+    EXPECT_THROW(Transaction::deserialize(reordered), std::invalid_argument);
+    // not a payment (an offer create)
+    auto offer = valid;
+    offer[2] = 7;
+    EXPECT_THROW(Transaction::deserialize(offer), std::invalid_argument);
+    // issued currency amount
+    auto issued = valid;
+    issued[14] |= 0x80;
+    EXPECT_THROW(Transaction::deserialize(issued), std::invalid_argument);
+}
+
+TEST(RippleTransaction, decodeFields) {
+    // a memo object in an array, a path set and a hash: not produced by serialize, but decoded
+    const auto data = parse_hex(
+        "5011" "00000000000000000000000000000000000000000000000000000000000000aa"
+        "f9" "ea" "7d03616263" "e1" "f1"
+        "0112" "11" "0000000000000000000000000000000000000001" "1111111111111111111111111111111111111111"
+        "ff" "01" "2222222222222222222222222222222222222222" "00");
+    const auto fields = decodeFields(data);
+    ASSERT_EQ(fields.size(), 3ul);
+    EXPECT_EQ(fields[0].type, FieldType::hash256);
+    EXPECT_EQ(fields[0].key, 17);
+    EXPECT_EQ(fields[0].value.size(), 32ul);
+    EXPECT_EQ(fields[1].type, FieldType::array);
+    EXPECT_EQ(fields[1].key, 9);
+    EXPECT_EQ(hex(fields[1].value), "ea7d03616263e1");
+    EXPECT_EQ(fields[2].type, FieldType::pathset);
+    EXPECT_EQ(fields[2].key, 1);
+    EXPECT_EQ(fields[2].value.size(), 63ul);
+
+    size_t offset = 0;
+    EXPECT_EQ(decodeVariableLength(parse_hex("f10000"), offset), 12481ul);
+    offset = 0;
+    EXPECT_EQ(decodeVariableLength(parse_hex("c1ff"), offset), 448ul);
+    EXPECT_EQ(offset, 2ul);
+
+    // unterminated object, unknown path step
+    EXPECT_THROW(decodeFields(parse_hex("ea7d03616263")), std::invalid_argument);
+    EXPECT_THROW(decodeFields(parse_hex("011202" "1111111111111111111111111111111111111111" "00")), std::invalid_argument);
+}
+
+TEST(RippleTransaction, decodeFieldsNested) {
+    // objects nested up to the maximum depth
+    const auto nested = [](size_t depth) {
+        auto data = Data(depth, 0xe2);
+        data.insert(data.end(), depth, 0xe1);
+        return data;
+    };
+    EXPECT_EQ(decodeFields(nested(maxFieldDepth)).size(), 1ul);
+    EXPECT_THROW(decodeFields(nested(maxFieldDepth + 1)), std::invalid_argument);
+    // a long run of object headers is rejected instead of recursing through it
+    EXPECT_THROW(decodeFields(Data(100000, 0xe2)), std::invalid_argument);
+    EXPECT_THROW(decodeFields(Data(100000, 0xf9)), std::invalid_argument);
+
+    // the fields of nested objects are in canonical order too
+    EXPECT_EQ(decodeFields(parse_hex("e2" "2100000001" "2200000002" "e1")).size(), 1ul);
+    EXPECT_THROW(decodeFields(parse_hex("e2" "2200000002" "2100000001" "e1")), std::invalid_argument);
+    EXPECT_THROW(decodeFields(parse_hex("e2" "2100000001" "2100000001" "e1")), std::invalid_argument);
+    EXPECT_THROW(decodeFields(parse_hex("f9" "ea" "2200000002" "2100000001" "e1" "f1")), std::invalid_argument);
+}
@@ -0,0 +1,58 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SecureAllocator.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace TW {
+
+TEST(SecureAllocator, ReusesZeroizedBlocks) {
+    auto& pool = SecurePool::shared();
+    auto block = static_cast<byte*>(pool.allocate(32));
+    std::memset(block, 0xAB, 32);
+    pool.deallocate(block, 32);
+
+    // the freed block is handed out again for the same size class, zeroized
+    auto again = static_cast<byte*>(pool.allocate(20));
+    EXPECT_TRUE(std::all_of(again, again + 32, [](byte b) { return b == 0; }));
+    pool.deallocate(again, 20);
+}
+
+// key material is only copied out of the pool explicitly, with TW::data
+static_assert(!std::is_convertible_v<const SecureData&, const Data&>, "SecureData must not convert to Data implicitly");
+
+TEST(SecureAllocator, LargeAllocations) {
+    SecureData large(4 * SecurePool::maxBlockSize, 0x11);
+    EXPECT_EQ(0x11, large.back());
+    large.resize(1);
+    large.shrink_to_fit();
+    EXPECT_EQ(1, large.size());
+}
+
+TEST(SecureAllocator, PrivateKey) {
+    const auto keyData = parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+    const auto slabs = SecurePool::shared().slabCount();
+    {
+        const auto privateKey = PrivateKey(keyData);
+        EXPECT_EQ(hex(keyData), hex(privateKey.bytes));
+        const auto copy = privateKey;
+        EXPECT_EQ(hex(keyData), hex(copy.bytes));
+    }
+    // keys come from the already mapped slabs
+    for (int i = 0; i < 100; ++i) {
+        const auto privateKey = PrivateKey(keyData);
+    }
+    EXPECT_LE(SecurePool::shared().slabCount(), slabs + 1);
+}
+
+} // namespace TW
@@ -0,0 +1,95 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SigningKey.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW {
+
+const auto keyHex = "afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5";
+
+TEST(SigningKey, MatchesPrivateKey) {
+    const auto privateKey = PrivateKey(parse_hex(keyHex));
+    const auto extendedKey = PrivateKey(
+        parse_hex("b0884d248cb301edd1b34cf626ba6d880bb3ae8fd91b4696446999dc4f0b5744"),
+        parse_hex("309941d56938e943980d11643c535e046653ca6f498c014b88f2ad9fd6e71eff"),
+        parse_hex("bf36a8fa9f5e11eb7a852c41e185e3969d518e66e6893c81d3fc7227009952d4"));
+
+    for (auto curve : {TWCurveSECP256k1, TWCurveED25519, TWCurveED25519HD, TWCurveED25519Blake2bNano,
+                       TWCurveCurve25519, TWCurveNIST256p1, TWCurveED25519Extended}) {
+        const auto& key = curve == TWCurveED25519Extended ? extendedKey : privateKey;
+        const auto signingKey = SigningKey(key, curve);
+        EXPECT_EQ(curve, signingKey.curve());
+        for (const auto& message : {"", "Hello", "a longer message, which is signed over and over again"}) {
+            const auto digest = Hash::sha256(data(std::string(message)));
+            EXPECT_EQ(hex(key.sign(digest, curve)), hex(signingKey.sign(digest))) << curve;
+        }
+    }
+}
+
+TEST(SigningKey, PublicKey) {
+    const auto privateKey = PrivateKey(parse_hex(keyHex));
+    EXPECT_EQ(hex(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes),
+              hex(SigningKey(privateKey, TWCurveSECP256k1).publicKey().bytes));
+    EXPECT_EQ(hex(privateKey.getPublicKey(TWPublicKeyTypeED25519Blake2b).bytes),
+              hex(SigningKey(privateKey, TWCurveED25519Blake2bNano).publicKey().bytes));
+
+    const auto signingKey = SigningKey(privateKey, TWCurveED25519);
+    const auto digest = Hash::sha256(data("Hello"));
+    EXPECT_TRUE(signingKey.publicKey().verify(signingKey.sign(digest), digest));
+}
+
+TEST(SigningKey, Invalid) {
+    // secp256k1 order
+    const auto privateKey = PrivateKey(parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141"));
+    EXPECT_THROW(SigningKey(privateKey, TWCurveSECP256k1), std::invalid_argument);
+    EXPECT_NO_THROW(SigningKey(privateKey, TWCurveED25519));
+    EXPECT_THROW(SigningKey(privateKey, TWCurveED25519Extended), std::invalid_argument);
+    EXPECT_THROW(SigningKey(privateKey, TWCurveNone), std::invalid_argument);
+
+    // too short for ECDSA
+    EXPECT_TRUE(SigningKey(PrivateKey(parse_hex(keyHex)), TWCurveSECP256k1).sign(parse_hex("0102")).empty());
+}
+
+TEST(SigningKey, SignAll) {
+    std::vector<PrivateKey> privateKeys;
+    std::vector<Data> messages;
+    for (int i = 0; i < 9; ++i) {
+        const auto seed = Hash::sha256(data(std::to_string(i)));
+        privateKeys.emplace_back(seed);
+        messages.push_back(Data(seed.begin(), seed.begin() + i * 3));
+    }
+
+    for (const size_t threadCount : {size_t(0), size_t(1), size_t(3)}) {
+        const auto keys = SigningKey::prepareAll(privateKeys, TWCurveED25519, threadCount);
+        ASSERT_EQ(keys.size(), privateKeys.size());
+        std::vector<Data> signatures(keys.size(), Data(64));
+        std::vector<SigningRequest> requests;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            // keys sign each other's messages
+            const auto& message = messages[(i + 1) % messages.size()];
+            requests.push_back({&keys[i], message.data(), message.size(), signatures[i].data()});
+        }
+        SigningKey::signAll(requests, threadCount);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const auto& message = messages[(i + 1) % messages.size()];
+            EXPECT_EQ(hex(signatures[i]), hex(privateKeys[i].sign(message, TWCurveED25519)));
+        }
+    }
+
+    // the first invalid key or failed signature throws
+    privateKeys.emplace_back(parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141"));
+    EXPECT_THROW(SigningKey::prepareAll(privateKeys, TWCurveSECP256k1, 3), std::invalid_argument);
+    const auto key = SigningKey(PrivateKey(parse_hex(keyHex)), TWCurveSECP256k1);
+    const auto digest = parse_hex("0102");
+    Data signature(65);
+    EXPECT_THROW(SigningKey::signAll({{&key, digest.data(), digest.size(), signature.data()}}), std::invalid_argument);
+}
+
+} // namespace TW
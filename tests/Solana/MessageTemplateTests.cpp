@@ -0,0 +1,120 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Solana/MessageTemplate.h"
+#include "Solana/Signer.h"
+#include "Solana/Transaction.h"
+#include "HexCoding.h"
+#include "PublicKey.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Solana;
+
+TEST(SolanaMessageTemplate, SignMatchesTransaction) {
+    const auto privateKey =
+        PrivateKey(Base58::bitcoin.decode("A7psj2GW7ZMdY4E5hJq14KMeYg7HFjULSsWSrTXZLvYr"));
+    const auto from = Address(privateKey.getPublicKey(TWPublicKeyTypeED25519));
+    const auto to = Address("EN2sCsJ1WDV8UFqsiTXHcUPUxQ4juE71eCknHYYMifkd");
+    Solana::Hash recentBlockhash("11111111111111111111111111111111");
+    const auto message = Message(from, to, 42, recentBlockhash);
+
+    const auto messageTemplate = MessageTemplate(message);
+    EXPECT_EQ(hex(messageTemplate.data()), hex(Transaction(message).messageData()));
+    EXPECT_EQ(messageTemplate.numRequiredSignatures(), 1ul);
+    EXPECT_EQ(messageTemplate.accountCount(), 3ul);
+    EXPECT_EQ(messageTemplate.accountKey(1), to);
+    EXPECT_EQ(messageTemplate.accountIndex(from), 0ul);
+    EXPECT_EQ(messageTemplate.instructionCount(), 1ul);
+
+    const auto signed_ = messageTemplate.sign({SigningKey(privateKey, TWCurveED25519)});
+    EXPECT_EQ(Base58::bitcoin.encode(signed_),
+        "3p2kzZ1DvquqC6LApPuxpTg5CCDVPqJFokGSnGhnBHrta4uq7S2EyehV1XNUVXp51D69GxGzQZU"
+        "jikfDzbWBG2aFtG3gHT1QfLzyFKHM4HQtMQMNXqay1NAeiiYZjNhx9UvMX4uAQZ4Q6rx6m2AYfQ"
+        "7aoMUrejq298q1wBFdtS9XVB5QTiStnzC7zs97FUEK2T4XapjF1519EyFBViTfHpGpnf5bfizDz"
+        "sW9kYUtRDW1UC2LgHr7npgq5W9TBmHf9hSmRgM9XXucjXLqubNWE7HUMhbKjuBqkirRM");
+}
+
+TEST(SolanaMessageTemplate, Patch) {
+    const auto privateKey =
+        PrivateKey(Base58::bitcoin.decode("A7psj2GW7ZMdY4E5hJq14KMeYg7HFjULSsWSrTXZLvYr"));
+    const auto signingKey = SigningKey(privateKey, TWCurveED25519);
+    const auto from = Address(privateKey.getPublicKey(TWPublicKeyTypeED25519));
+    auto messageTemplate = MessageTemplate(Message(from, Address("EN2sCsJ1WDV8UFqsiTXHcUPUxQ4juE71eCknHYYMifkd"),
+                                                   42, Solana::Hash("11111111111111111111111111111111")));
+
+    const std::vector<std::string> recipients = {
+        "4iSnyfDKaejniaPc2pBBckwQqV3mDS93go15NdxWJq2y",
+        "56B334QvCDMSirsmtEJGfanZm8GqeQarrSjdAb2MbeNM",
+    };
+    const Solana::Hash blockhash("GgBaCs3NCBuZN12kCJgAW63ydqohFkHEdfdEXBPzLHq");
+    Data signed_;
+    for (size_t i = 0; i < recipients.size(); ++i) {
+        const auto to = Address(recipients[i]);
+        const uint64_t value = 1000 + i;
+        messageTemplate.setAccountKey(1, to);
+        messageTemplate.setRecentBlockhash(blockhash);
+        // system transfer data: instruction type, then the lamports
+        messageTemplate.setInstructionValue(0, 4, value);
+        messageTemplate.sign({signingKey}, signed_);
+
+        auto transaction = Transaction(from, to, value, blockhash);
+        Signer::sign({privateKey}, transaction);
+        EXPECT_EQ(hex(messageTemplate.data()), hex(transaction.messageData()));
+        EXPECT_EQ(Base58::bitcoin.encode(signed_), transaction.serialize());
+    }
+}
+
+TEST(SolanaMessageTemplate, MultipleSigners) {
+    const auto privateKey0 =
+        PrivateKey(Base58::bitcoin.decode("96PKHuMPtniu1T74RvUNkbDPXPPRZ8Mg1zXwciCAyaDq"));
+    const auto address0 = Address(privateKey0.getPublicKey(TWPublicKeyTypeED25519));
+    const auto privateKey1 =
+        PrivateKey(Base58::bitcoin.decode("GvGmNPMQLZE2VNx3KG2GdiC4ndS8uCqd7PjioPgm9Qhi"));
+    const auto address1 = Address(privateKey1.getPublicKey(TWPublicKeyTypeED25519));
+
+    Address programId("11111111111111111111111111111111");
+    Instruction instruction(programId, {AccountMeta(address0, true, false), AccountMeta(address1, false, false)},
+                            Data{0, 0, 0, 0});
+    Message message(MessageHeader{2, 0, 1}, {address0, address1, programId},
+                    Solana::Hash("11111111111111111111111111111111"), {instruction});
+    auto transaction = Transaction(message);
+    Signer::sign({privateKey1, privateKey0}, transaction);
+
+    const auto messageTemplate = MessageTemplate(message);
+    // sign order does not matter
+    const auto signed_ = messageTemplate.sign({SigningKey(privateKey1, TWCurveED25519), SigningKey(privateKey0, TWCurveED25519)});
+    EXPECT_EQ(Base58::bitcoin.encode(signed_), transaction.serialize());
+
+    // a missing signature is left zero
+    const auto partial = messageTemplate.sign({SigningKey(privateKey0, TWCurveED25519)});
+    EXPECT_EQ(hex(Data(partial.begin() + 65, partial.begin() + 129)), hex(Data(64)));
+}
+
+TEST(SolanaMessageTemplate, Invalid) {
+    const auto privateKey =
+        PrivateKey(Base58::bitcoin.decode("A7psj2GW7ZMdY4E5hJq14KMeYg7HFjULSsWSrTXZLvYr"));
+    const auto from = Address(privateKey.getPublicKey(TWPublicKeyTypeED25519));
+    const auto to = Address("EN2sCsJ1WDV8UFqsiTXHcUPUxQ4juE71eCknHYYMifkd");
+    auto messageTemplate = MessageTemplate(Message(from, to, 42, Solana::Hash("11111111111111111111111111111111")));
+
+    auto data = messageTemplate.data();
+    data.pop_back();
+    EXPECT_THROW(MessageTemplate{data}, std::invalid_argument);
+    data.push_back(0);
+    data.push_back(0);
+    EXPECT_THROW(MessageTemplate{data}, std::invalid_argument);
+
+    EXPECT_THROW(messageTemplate.setAccountKey(1, from), std::invalid_argument);
+    EXPECT_THROW(messageTemplate.setAccountKey(3, to), std::out_of_range);
+    EXPECT_THROW(messageTemplate.setInstructionValue(0, 5, 1), std::out_of_range);
+    EXPECT_THROW(messageTemplate.setInstructionValue(1, 4, 1), std::out_of_range);
+
+    const auto other = PrivateKey(Base58::bitcoin.decode("96PKHuMPtniu1T74RvUNkbDPXPPRZ8Mg1zXwciCAyaDq"));
+    EXPECT_THROW(messageTemplate.sign({SigningKey(other, TWCurveED25519)}), std::invalid_argument);
+    EXPECT_THROW(messageTemplate.sign({SigningKey(privateKey, TWCurveSECP256k1)}), std::invalid_argument);
+}
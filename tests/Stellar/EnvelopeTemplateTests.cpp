@@ -0,0 +1,50 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Stellar/EnvelopeTemplate.h"
+#include "Stellar/Signer.h"
+#include "Base64.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include <TrustWalletCore/TWStellarPassphrase.h>
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Stellar;
+
+TEST(StellarEnvelopeTemplate, SetSequence) {
+    auto privateKey = PrivateKey(parse_hex("59a313f46ef1c23a9e4f71cea10fc0c56a2a6bb8a4b9ea3d5348823e5a478722"));
+    auto input = Proto::SigningInput();
+    input.set_passphrase(TWStellarPassphrase_Stellar);
+    input.set_account("GAE2SZV4VLGBAPRYRFV2VY7YYLYGYIP5I7OU7BSP6DJT7GAZ35OKFDYI");
+    input.set_fee(1000);
+    input.set_sequence(2);
+    input.mutable_memo_id()->set_id(1234567890);
+    input.mutable_op_payment()->set_destination("GDCYBNRRPIHLHG7X7TKPUPAZ7WVUXCN3VO7WCCK64RIFV5XM5V5K4A52");
+    input.mutable_op_payment()->set_amount(10000000);
+    input.set_private_key(privateKey.bytes.data(), privateKey.bytes.size());
+
+    auto envelopeTemplate = EnvelopeTemplate(input);
+    EXPECT_EQ(envelopeTemplate.sign(), Signer(input).sign());
+    EXPECT_EQ(hex(envelopeTemplate.transaction()), hex(Signer(input).encode(input)));
+
+    Data envelope;
+    for (const int64_t sequence : {int64_t(3), int64_t(0x1ffeeddccbbaa99)}) {
+        envelopeTemplate.setSequence(sequence);
+        envelopeTemplate.sign(envelope);
+        input.set_sequence(sequence);
+        EXPECT_EQ(Base64::encode(envelope), Signer(input).sign());
+        EXPECT_EQ(Signer::decode(envelopeTemplate.transaction()).sequence(), sequence);
+    }
+}
+
+TEST(StellarEnvelopeTemplate, NetworkId) {
+    const auto& stellar = Signer::networkId(TWStellarPassphrase_Stellar);
+    EXPECT_EQ(hex(stellar), "7ac33997544e3175d266bd022439b22cdb16508c01163f26e5cb2a3e1045a979");
+    EXPECT_EQ(&Signer::networkId(TWStellarPassphrase_Stellar), &stellar);
+    EXPECT_NE(hex(Signer::networkId(TWStellarPassphrase_Kin)), hex(stellar));
+}
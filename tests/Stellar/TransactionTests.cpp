@@ -143,3 +143,55 @@ TEST(StellarTransaction, signAcreateAccount) {
     const auto signature = signer.sign();
     ASSERT_EQ(signature, "AAAAAAmpZryqzBA+OIlrquP4wvBsIf1H3U+GT/DTP5gZ31yiAAAD6AAAAAAAAAACAAAAAAAAAAIAAAAASZYC0gAAAAEAAAAAAAAAAAAAAADFgLYxeg6zm/f81Po8Gf2rS4m7q79hCV7kUFr27O16rgAAAAAAmJaAAAAAAAAAAAEZ31yiAAAAQNgqNDqbe0X60gyH+1xf2Tv2RndFiJmyfbrvVjsTfjZAVRrS2zE9hHlqPQKpZkGKEFka7+1ElOS+/m/1JDnauQg=");
 }
+
+TEST(StellarTransaction, decode) {
+    auto input = Proto::SigningInput();
+    input.set_account("GAE2SZV4VLGBAPRYRFV2VY7YYLYGYIP5I7OU7BSP6DJT7GAZ35OKFDYI");
+    input.set_fee(1000);
+    input.set_sequence(2);
+    input.mutable_memo_text()->set_text("Hello, world!");
+    input.mutable_op_payment()->set_destination("GDCYBNRRPIHLHG7X7TKPUPAZ7WVUXCN3VO7WCCK64RIFV5XM5V5K4A52");
+    input.mutable_op_payment()->mutable_asset()->set_issuer("GA6HCMBLTZS5VYYBCATRBRZ3BZJMAFUDKYYF6AH6MVCMGWMRDNSWJPIH");
+    input.mutable_op_payment()->mutable_asset()->set_alphanum4("MOB");
+    input.mutable_op_payment()->set_amount(10000000);
+    const auto encoded = Signer(input).encode(input);
+    EXPECT_EQ(Signer::decode(encoded).SerializeAsString(), input.SerializeAsString());
+
+    auto trust = Proto::SigningInput();
+    trust.set_account("GAE2SZV4VLGBAPRYRFV2VY7YYLYGYIP5I7OU7BSP6DJT7GAZ35OKFDYI");
+    trust.set_fee(10000);
+    trust.set_sequence(144098454883270659);
+    const auto hash = parse_hex("315f5bdb76d078c43b8ac0064e4a0164612b1fce77c869345bfc94c75894edd3");
+    trust.mutable_memo_return_hash()->set_hash(hash.data(), hash.size());
+    trust.mutable_op_change_trust()->mutable_asset()->set_issuer("GA6HCMBLTZS5VYYBCATRBRZ3BZJMAFUDKYYF6AH6MVCMGWMRDNSWJPIH");
+    trust.mutable_op_change_trust()->mutable_asset()->set_alphanum4("MOBI");
+    trust.mutable_op_change_trust()->set_valid_before(1613336576);
+    const auto encodedTrust = Signer(trust).encode(trust);
+    EXPECT_EQ(Signer::decode(encodedTrust).SerializeAsString(), trust.SerializeAsString());
+}
+
+TEST(StellarTransaction, decodeInvalid) {
+    auto input = Proto::SigningInput();
+    input.set_account("GAE2SZV4VLGBAPRYRFV2VY7YYLYGYIP5I7OU7BSP6DJT7GAZ35OKFDYI");
+    input.set_fee(1000);
+    input.set_sequence(2);
+    input.mutable_memo_text()->set_text("Hi");
+    input.mutable_op_create_account()->set_destination("GDCYBNRRPIHLHG7X7TKPUPAZ7WVUXCN3VO7WCCK64RIFV5XM5V5K4A52");
+    input.mutable_op_create_account()->set_amount(10000000);
+    const auto encoded = Signer(input).encode(input);
+    ASSERT_NO_THROW(Signer::decode(encoded));
+
+    // truncated, extra data
+    EXPECT_THROW(Signer::decode(Data(encoded.begin(), encoded.end() - 1)), std::invalid_argument);
+    auto extra = encoded;
+    append(extra, Data(4));
+    EXPECT_THROW(Signer::decode(extra), std::invalid_argument);
+    // memo text padding, after account, fee, sequence, time bounds, memo type, length and "Hi"
+    auto padding = encoded;
+    padding[36 + 4 + 8 + 4 + 4 + 4 + 2] = 1;
+    EXPECT_THROW(Signer::decode(padding), std::invalid_argument);
+    // unsupported operation type (path payment)
+    auto operation = encoded;
+    operation[36 + 4 + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 3] = 2;
+    EXPECT_THROW(Signer::decode(operation), std::invalid_argument);
+}
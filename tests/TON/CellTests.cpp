@@ -256,4 +256,119 @@ TEST(TONCell, CellStateInit2)
         EXPECT_EQ("b5ee9c7241010301007e00020134010200a2ff0020dd2082014c97ba9730ed44d0d70b1fe0a4f260810200d71820d70b1fed44d0d31fd3ffd15112baf2a122f901541044f910f2a2f80001d31f3120d74a96d307d402fb00ded1a4c8cb1fcbffc9ed5400480000000037f14c50f6435b11b9326e1218524f7f072d0a5ea8221cca71682e7d6ed6421381c553bd",
             hex(ser));
     }
-}
\ No newline at end of file
+}
+
+TEST(TONCell, CellDepth)
+{
+    // three levels: root -> mid -> leaf
+    auto leaf = std::make_shared<Cell>();
+    leaf->setSliceBytesStr("123456");
+    auto mid = std::make_shared<Cell>();
+    mid->setSliceBytesStr("FEDCBA");
+    mid->addCell(leaf);
+    Cell root;
+    root.setSliceBytesStr("ABCD");
+    root.addCell(mid);
+    EXPECT_EQ(0, leaf->depth());
+    EXPECT_EQ(1, mid->depth());
+    EXPECT_EQ(2, root.depth());
+    EXPECT_EQ("3d378871d00f823cd9f61d0300fdeaa288da0da1cb98259ffea67fafae609b61", hex(mid->hash()));
+    EXPECT_EQ("478555ed1ecca2dd9ce39737899888d70fd597c8ce7b168489b4c4ba9b8005ef", hex(root.hash()));
+    EXPECT_EQ(31, root.serializedSize(Cell::SerializationMode::WithCRC32C));
+    Data ser;
+    root.serialize(ser, Cell::SerializationMode::WithCRC32C);
+    EXPECT_EQ("b5ee9c72410103010010000104abcd010106fedcba02000612345693615d86", hex(ser));
+}
+
+TEST(TONCell, CellHashCacheInvalidation)
+{
+    auto leaf = std::make_shared<Cell>();
+    leaf->setSliceBytesStr("123456");
+    auto mid = std::make_shared<Cell>();
+    mid->setSliceBytesStr("FEDCBA");
+    mid->addCell(leaf);
+    Cell root;
+    root.setSliceBytesStr("ABCD");
+    root.addCell(mid);
+    const auto hash1 = root.hash();
+    EXPECT_EQ("478555ed1ecca2dd9ce39737899888d70fd597c8ce7b168489b4c4ba9b8005ef", hex(hash1));
+    // repeated call returns the cached value
+    EXPECT_EQ(hex(hash1), hex(root.hash()));
+
+    // modifying a grandchild changes the root hash
+    leaf->setSliceBytesStr("123457");
+    EXPECT_EQ("5fa3d71bc154f900af8f23866bf96d2c74e22ce2aea920c1d23f4d502775eec8", hex(root.hash()));
+    // a copy keeps the hash, and is invalidated independently
+    Cell copy = root;
+    EXPECT_EQ("5fa3d71bc154f900af8f23866bf96d2c74e22ce2aea920c1d23f4d502775eec8", hex(copy.hash()));
+    leaf->setSliceBytesStr("123456");
+    EXPECT_EQ("478555ed1ecca2dd9ce39737899888d70fd597c8ce7b168489b4c4ba9b8005ef", hex(root.hash()));
+    EXPECT_EQ("478555ed1ecca2dd9ce39737899888d70fd597c8ce7b168489b4c4ba9b8005ef", hex(copy.hash()));
+
+    // adding a child changes the hash
+    auto leaf2 = std::make_shared<Cell>();
+    mid->addCell(leaf2);
+    EXPECT_NE(hex(hash1), hex(root.hash()));
+}
+
+TEST(TONCell, CellSerializeDeduplicated)
+{
+    {
+        // identical children are serialized once
+        auto c1 = std::make_shared<Cell>();
+        c1->setSliceBytesStr("123456");
+        auto c2 = std::make_shared<Cell>();
+        c2->setSliceBytesStr("123456");
+        Cell c;
+        c.addCell(c1);
+        c.addCell(c2);
+        EXPECT_EQ("bdc230713cf997da2a05689058b3b87cb2e8b475187e1bf93a92575bbd10e132", hex(c.hash()));
+        EXPECT_EQ(24, c.serializedSize(Cell::SerializationMode::WithCRC32C));
+        Data ser;
+        c.serialize(ser, Cell::SerializationMode::WithCRC32C);
+        EXPECT_EQ("b5ee9c7241010201000900020001010006123456a3ca13cb", hex(ser));
+    }
+    {
+        // shared subtree: root -> [a, b], a -> [b]
+        auto b = std::make_shared<Cell>();
+        b->setSliceBytesStr("0B");
+        auto a = std::make_shared<Cell>();
+        a->setSliceBytesStr("0A");
+        a->addCell(b);
+        Cell c;
+        c.addCell(a);
+        c.addCell(b);
+        EXPECT_EQ("ade87e0cdf4f41f4bb3ec7f385fd877e943693969b31c6c2202050dd9eec93eb", hex(c.hash()));
+        Data ser;
+        c.serialize(ser, Cell::SerializationMode::WithCRC32C);
+        EXPECT_EQ("b5ee9c7241010301000b000200010201020a0200020baaaf4013", hex(ser));
+    }
+}
+
+TEST(TONCell, CellArena)
+{
+    CellArena arena;
+    auto leaf = arena.add(Slice::createFromHex("123456"));
+    auto mid = arena.add(Slice::createFromHex("FEDCBA"), {leaf});
+    auto root = arena.add(Slice::createFromHex("ABCD"), {mid});
+    EXPECT_EQ(3, arena.size());
+    EXPECT_EQ(2, arena.depth(root));
+    EXPECT_EQ(1, arena.refCount(root));
+    EXPECT_EQ(mid, arena.ref(root, 0));
+    EXPECT_EQ("478555ed1ecca2dd9ce39737899888d70fd597c8ce7b168489b4c4ba9b8005ef", hex(arena.hash(root)));
+    // identical cell is not added again
+    EXPECT_EQ(leaf, arena.add(Slice::createFromHex("123456")));
+    EXPECT_EQ(3, arena.size());
+
+    Data ser;
+    arena.serialize(root, ser, Cell::SerializationMode::WithCRC32C);
+    EXPECT_EQ("b5ee9c72410103010010000104abcd010106fedcba02000612345693615d86", hex(ser));
+    // serialize a subtree only
+    Data ser2;
+    arena.serialize(mid, ser2, Cell::SerializationMode::None);
+    EXPECT_EQ(arena.serializedSize(mid), ser2.size());
+
+    EXPECT_ANY_THROW(arena.add(Slice::createFromHex("00"), {10}));
+    EXPECT_ANY_THROW(arena.add(Slice::createFromHex("00"), {0, 0, 0, 0, 0}));
+    EXPECT_ANY_THROW(arena.hash(10));
+}
@@ -190,4 +190,92 @@ TEST(TezosTransaction, forgeUndelegate) {
     auto serialized = forgeOperation(delegateOperation);
 
     ASSERT_EQ(hex(serialized.begin(), serialized.end()), expected);
-}
\ No newline at end of file
+}
+TEST(Forging, ForgeIntoBuffer) {
+    auto transactionOperation = TW::Tezos::Proto::Operation();
+    transactionOperation.set_source("tz1XVJ8bZUXs7r5NV8dHvuiBhzECvLRLR3jW");
+    transactionOperation.set_fee(1272);
+    transactionOperation.set_counter(30738);
+    transactionOperation.set_gas_limit(10100);
+    transactionOperation.set_storage_limit(257);
+    transactionOperation.set_kind(TW::Tezos::Proto::Operation::TRANSACTION);
+    transactionOperation.mutable_transaction_operation_data()->set_amount(1);
+    transactionOperation.mutable_transaction_operation_data()->set_destination("tz1Yju7jmmsaUiG9qQLoYv35v5pHgnWoLWbt");
+
+    const auto expected = "6c0081faa75f741ef614b0e35fcc8c90dfa3b0b95721f80992f001f44e81020100008fb5cea62d147c696afd9a93dbce962f4c8a9c9100";
+    EXPECT_EQ(forgedOperationSize(transactionOperation), parse_hex(expected).size());
+
+    // operations are appended, with the addresses decoded once
+    ForgedPublicKeyHashCache cache;
+    Data forged;
+    forgeOperation(transactionOperation, forged, &cache);
+    forgeOperation(transactionOperation, forged, &cache);
+    EXPECT_EQ(hex(forged), std::string(expected) + expected);
+    EXPECT_EQ(cache.size(), 2ul);
+
+    // nothing is appended for an invalid operation
+    transactionOperation.mutable_transaction_operation_data()->set_destination("tz1eZwq8b5cvE2bPKokatLkVMzkxz24z3AAAA");
+    EXPECT_THROW(forgeOperation(transactionOperation, forged, &cache), std::invalid_argument);
+    EXPECT_EQ(hex(forged), std::string(expected) + expected);
+}
+
+TEST(Forging, UnforgeZarith) {
+    for (uint64_t value : {0ull, 10ull, 150ull, 2107451ull, 0xffffffffffffffffull}) {
+        const auto forged = forgeZarith(value);
+        EXPECT_EQ(forgedZarithSize(value), forged.size());
+        size_t offset = 0;
+        EXPECT_EQ(unforgeZarith(forged, offset), value);
+        EXPECT_EQ(offset, forged.size());
+    }
+
+    size_t offset = 0;
+    EXPECT_THROW(unforgeZarith(parse_hex("8080"), offset), std::invalid_argument);
+    offset = 0;
+    EXPECT_THROW(unforgeZarith(parse_hex("ffffffffffffffffff02"), offset), std::invalid_argument);
+    offset = 0;
+    EXPECT_THROW(unforgeZarith(parse_hex("8a00"), offset), std::invalid_argument);
+    offset = 0;
+    EXPECT_THROW(unforgeZarith(parse_hex("8000"), offset), std::invalid_argument);
+}
+
+TEST(Forging, UnforgePublicKeyHash) {
+    for (auto address : {"tz1eZwq8b5cvE2bPKokatLkVMzkxz24z3Don", "tz2Rh3NYeLxrqTuvaZJmaMiVMqCajeXMWtYo", "tz3RDC3Jdn4j15J7bBHZd29EUee9gVB1CxD9"}) {
+        const auto forged = forgePublicKeyHash(address);
+        size_t offset = 0;
+        EXPECT_EQ(unforgePublicKeyHash(forged, offset), address);
+        EXPECT_EQ(offset, forged.size());
+    }
+    size_t offset = 0;
+    EXPECT_THROW(unforgePublicKeyHash(parse_hex("030000000000000000000000000000000000000000"), offset), std::invalid_argument);
+}
+
+TEST(TezosTransaction, unforge) {
+    for (auto expected : {
+        "6c0081faa75f741ef614b0e35fcc8c90dfa3b0b95721f80992f001f44e81020100008fb5cea62d147c696afd9a93dbce962f4c8a9c9100",
+        "6b0081faa75f741ef614b0e35fcc8c90dfa3b0b95721f80992f001f44e810200429a986c8072a40a1f3a3e2ab5a5819bb1b2fb69993c5004837815b9dc55923e",
+        "6e0081faa75f741ef614b0e35fcc8c90dfa3b0b95721f80992f001f44e8102ff003e47f837f0467b4acde406ed5842f35e2414b1a8",
+        "6e0081faa75f741ef614b0e35fcc8c90dfa3b0b95721f80992f001f44e810200",
+    }) {
+        const auto forged = parse_hex(expected);
+        size_t offset = 0;
+        const auto operation = unforgeOperation(forged, offset);
+        EXPECT_EQ(offset, forged.size());
+        EXPECT_EQ(operation.source(), "tz1XVJ8bZUXs7r5NV8dHvuiBhzECvLRLR3jW");
+        EXPECT_EQ(operation.fee(), 1272);
+        EXPECT_EQ(operation.counter(), 30738);
+        EXPECT_EQ(hex(forgeOperation(operation)), expected);
+    }
+
+    const auto transaction = parse_hex("6c0081faa75f741ef614b0e35fcc8c90dfa3b0b95721f80992f001f44e81020100008fb5cea62d147c696afd9a93dbce962f4c8a9c9100");
+    size_t offset = 0;
+    EXPECT_EQ(unforgeOperation(transaction, offset).transaction_operation_data().destination(), "tz1Yju7jmmsaUiG9qQLoYv35v5pHgnWoLWbt");
+    for (size_t size = 0; size < transaction.size(); ++size) {
+        offset = 0;
+        EXPECT_THROW(unforgeOperation(Data(transaction.begin(), transaction.begin() + size), offset), std::invalid_argument);
+    }
+    // transaction parameters
+    auto withParameters = transaction;
+    withParameters.back() = 0xff;
+    offset = 0;
+    EXPECT_THROW(unforgeOperation(withParameters, offset), std::invalid_argument);
+}
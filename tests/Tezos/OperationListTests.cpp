@@ -179,3 +179,20 @@ TEST(TezosOperationList, ForgeOperationList_RevealWithoutPublicKey) {
 
     ASSERT_EQ(hex(forged.begin(), forged.end()), expected);
 }
+
+TEST(TezosOperationList, Unforge) {
+    const auto forged = parse_hex("3756ef37b1be849e3114643f0aa5847cabf9a896d3bfe4dd51448de68e91da016b003e47f837f0467b4acde406ed5842f35e2414b1a8f80992f001f44e810200603247bbf52501498293686da89ad8b2aca85f83b90903d4521dd2aba66054eb6c003e47f837f0467b4acde406ed5842f35e2414b1a8f80993f001f44e8102010000e42504da69a7c8d5baeaaeebe157a02db6b22ed800");
+    const auto op_list = TW::Tezos::OperationList::unforge(forged);
+
+    EXPECT_EQ(op_list.branch, "BL8euoCWqNCny9AR3AKjnpi38haYMxjei1ZqNHuXMn19JSQnoWp");
+    ASSERT_EQ(op_list.operation_list.size(), 2ul);
+    EXPECT_EQ(op_list.operation_list[0].kind(), Operation::REVEAL);
+    EXPECT_EQ(op_list.operation_list[1].kind(), Operation::TRANSACTION);
+    EXPECT_EQ(op_list.operation_list[1].counter(), 30739);
+    EXPECT_EQ(op_list.operation_list[1].transaction_operation_data().destination(), "tz1gSM6yiwr85jEASZ1q3UekgHEoxYt7wg2M");
+
+    auto key = parsePrivateKey("edsk4bMQMM6HYtMazF3m7mYhQ6KQ1WCEcBuRwh6DTtdnoqAvC3nPCc");
+    EXPECT_EQ(hex(op_list.forge(key)), hex(forged));
+
+    EXPECT_THROW(TW::Tezos::OperationList::unforge(Data(forged.begin(), forged.end() - 1)), std::invalid_argument);
+}
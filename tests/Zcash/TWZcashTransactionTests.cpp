@@ -186,3 +186,60 @@ TEST(TWZcashTransaction, BlossomSigning) {
     signedTx.encode(serialized);
     ASSERT_EQ(hex(serialized), "0400008085202f8901de8c02c79c01018bd91dbc6b293eba03945be25762994409209a06d95c828123000000006b483045022100e6e5071811c08d0c2e81cb8682ee36a8c6b645f5c08747acd3e828de2a4d8a9602200b13b36a838c7e8af81f2d6e7e694ede28833a480cfbaaa68a47187655298a7f0121024bc2a31265153f07e70e0bab08724e6b85e217f8cd628ceb62974247bb493382ffffffff01cf440000000000001976a914c3bacb129d85288a3deb5890ca9b711f7f71392688ac00000000000000000000000000000000000000");
 }
+
+TEST(TWZcashTransaction, SigningManyInputs) {
+    // enough inputs to be signed in parallel, each signature checked against one computed on its own
+    const auto inputCount = 12;
+    const std::string toAddress = "t1biXYN8wJahR76SqZTe1LBzTLf3JAsmT93";
+
+    auto input = Bitcoin::Proto::SigningInput();
+    input.set_hash_type(TWBitcoinSigHashTypeAll);
+    input.set_use_max_amount(true);
+    input.set_byte_fee(1);
+    input.set_to_address(toAddress);
+    input.set_coin_type(TWCoinTypeZcash);
+
+    auto utxoKey = PrivateKey(parse_hex("4646464646464646464646464646464646464646464646464646464646464646"));
+    auto utxoAddr = TW::deriveAddress(TWCoinTypeZcash, utxoKey);
+    auto script = Bitcoin::Script::lockScriptForAddress(utxoAddr, TWCoinTypeZcash);
+    input.add_private_key(utxoKey.bytes.data(), utxoKey.bytes.size());
+    for (auto i = 0; i < inputCount; ++i) {
+        auto txHash = Hash::sha256(data(std::to_string(i)));
+        auto utxo = input.add_utxo();
+        utxo->mutable_out_point()->set_hash(txHash.data(), txHash.size());
+        utxo->mutable_out_point()->set_index(i);
+        utxo->mutable_out_point()->set_sequence(UINT32_MAX - i);
+        utxo->set_amount(10000 + i);
+        utxo->set_script(script.bytes.data(), script.bytes.size());
+    }
+
+    auto plan = Zcash::TransactionBuilder::plan(input);
+    ASSERT_EQ(inputCount, plan.utxos.size());
+    *input.mutable_plan() = plan.proto();
+
+    auto result = Bitcoin::TransactionSigner<Zcash::Transaction, Zcash::TransactionBuilder>(input).sign();
+    ASSERT_TRUE(result) << result.error().text;
+    const auto signedTx = result.payload();
+
+    auto unsignedTx = Zcash::TransactionBuilder::build<Zcash::Transaction>(plan, toAddress, "", TWCoinTypeZcash);
+    const auto publicKey = utxoKey.getPublicKey(TWPublicKeyTypeSECP256k1);
+    ASSERT_EQ(inputCount, signedTx.inputs.size());
+    for (auto i = 0; i < inputCount; ++i) {
+        const auto& prevout = unsignedTx.inputs[i].previousOutput;
+        const auto& utxo = *std::find_if(plan.utxos.begin(), plan.utxos.end(), [&](const auto& utxo) {
+            return utxo.out_point().index() == prevout.index;
+        });
+        auto sighash = unsignedTx.getSignatureHash(script, i, TWBitcoinSigHashTypeAll, utxo.amount(), Bitcoin::BASE);
+        auto signature = utxoKey.signAsDER(sighash, TWCurveSECP256k1);
+        signature.push_back(TWBitcoinSigHashTypeAll);
+        const auto scriptSig =
+            Bitcoin::TransactionSigner<Zcash::Transaction, Zcash::TransactionBuilder>::pushAll({signature, publicKey.bytes});
+        EXPECT_EQ(hex(scriptSig), hex(signedTx.inputs[i].script.bytes)) << i;
+    }
+
+    // cached shared hashes give the same signature hashes
+    const auto sighash = unsignedTx.getSignatureHash(script, 3, TWBitcoinSigHashTypeAll, 10003, Bitcoin::BASE);
+    const auto cache = unsignedTx.getSignatureHashCache();
+    EXPECT_EQ(hex(unsignedTx.getPrevoutHash()), hex(cache.prevoutHash));
+    EXPECT_EQ(hex(sighash), hex(unsignedTx.getSignatureHash(script, 3, TWBitcoinSigHashTypeAll, 10003, Bitcoin::BASE, &cache)));
+}
@@ -0,0 +1,164 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TWTestUtilities.h"
+#include <TrustWalletCore/TWAnySigner.h>
+
+#include "BinaryCoding.h"
+#include "Coin.h"
+#include "CoinEntry.h"
+#include "Data.h"
+#include "HexCoding.h"
+#include "proto/Filecoin.pb.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+
+namespace {
+
+Data filecoinInput(uint64_t nonce) {
+    Filecoin::Proto::SigningInput input;
+    auto privateKey = parse_hex("1d969865e189957b9824bd34f26d5cbf357fda1a6d844cbf0c9ab1ed93fa7dbe");
+    auto value = parse_hex("2086ac351052600000");
+    auto gasFeeCap = parse_hex("25f273933db5700000");
+    auto gasPremium = parse_hex("2b5e3af16b18800000");
+    input.set_private_key(privateKey.data(), privateKey.size());
+    input.set_to("f3um6uo3qt5of54xjbx3hsxbw5mbsc6auxzrvfxekn5bv3duewqyn2tg5rhrlx73qahzzpkhuj7a34iq7oifsq");
+    input.set_nonce(nonce);
+    input.set_value(value.data(), value.size());
+    input.set_gas_limit(1000);
+    input.set_gas_fee_cap(gasFeeCap.data(), gasFeeCap.size());
+    input.set_gas_premium(gasPremium.data(), gasPremium.size());
+    return data(input.SerializeAsString());
+}
+
+Data signSingle(const Data& input) {
+    auto inputData = WRAPD(TWDataCreateWithBytes(input.data(), input.size()));
+    auto outputData = WRAPD(TWAnySignerSign(inputData.get(), TWCoinTypeFilecoin));
+    return data(TWDataBytes(outputData.get()), TWDataSize(outputData.get()));
+}
+
+} // namespace
+
+TEST(TWAnySigner, SignBatch) {
+    const size_t count = 20;
+    std::vector<Data> inputs;
+    Data stream;
+    for (size_t i = 0; i < count; ++i) {
+        inputs.push_back(filecoinInput(i));
+        encode32LE(static_cast<uint32_t>(inputs.back().size()), stream);
+        append(stream, inputs.back());
+    }
+    auto streamData = WRAPD(TWDataCreateWithBytes(stream.data(), stream.size()));
+    auto outputData = WRAPD(TWAnySignerSignBatch(streamData.get(), TWCoinTypeFilecoin));
+    ASSERT_NE(outputData.get(), nullptr);
+    const auto output = data(TWDataBytes(outputData.get()), TWDataSize(outputData.get()));
+
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_LE(offset + 5, output.size());
+        const auto status = output[offset];
+        const auto length = decode32LE(output.data() + offset + 1);
+        offset += 5;
+        ASSERT_LE(offset + length, output.size());
+        const auto result = data(output.data() + offset, length);
+        offset += length;
+        EXPECT_EQ(0, status);
+        // same as signing one by one, in input order
+        EXPECT_EQ(hex(signSingle(inputs[i])), hex(result));
+    }
+    EXPECT_EQ(output.size(), offset);
+}
+
+TEST(TWAnySigner, SignBatchEmpty) {
+    auto streamData = WRAPD(TWDataCreateWithBytes(nullptr, 0));
+    auto outputData = WRAPD(TWAnySignerSignBatch(streamData.get(), TWCoinTypeFilecoin));
+    ASSERT_NE(outputData.get(), nullptr);
+    EXPECT_EQ(0, TWDataSize(outputData.get()));
+}
+
+TEST(TWAnySigner, SignBatchMalformed) {
+    {
+        // truncated length
+        auto streamData = DATA("0500");
+        EXPECT_EQ(TWAnySignerSignBatch(streamData.get(), TWCoinTypeFilecoin), nullptr);
+    }
+    {
+        // length larger than remaining data
+        auto streamData = DATA("05000000010203");
+        EXPECT_EQ(TWAnySignerSignBatch(streamData.get(), TWCoinTypeFilecoin), nullptr);
+    }
+}
+
+TEST(TWAnySigner, SignBatchThreads) {
+    std::vector<Data> inputs;
+    for (size_t i = 0; i < 17; ++i) {
+        inputs.push_back(filecoinInput(100 + i));
+    }
+    std::vector<BatchSignResult> results;
+    anyCoinSignBatch(TWCoinTypeFilecoin, inputs, results, 4);
+    ASSERT_EQ(inputs.size(), results.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        EXPECT_TRUE(results[i].success);
+        EXPECT_EQ(hex(signSingle(inputs[i])), hex(results[i].output));
+    }
+}
+
+TEST(TWAnySigner, SignWithArena) {
+    google::protobuf::Arena arena;
+    const auto input = filecoinInput(2);
+    const auto expected = hex(signSingle(input));
+    {
+        ScopedSigningArena scopedArena(&arena);
+        EXPECT_EQ(&arena, signingArena());
+        for (int i = 0; i < 3; ++i) {
+            Data output;
+            anyCoinSign(TWCoinTypeFilecoin, input, output);
+            EXPECT_EQ(expected, hex(output));
+        }
+    }
+    EXPECT_EQ(nullptr, signingArena());
+    EXPECT_GT(arena.SpaceUsed(), 0);
+
+    // shared by batch workers
+    arena.Reset();
+    std::vector<BatchSignResult> results;
+    anyCoinSignBatch(TWCoinTypeFilecoin, {input, input, input}, results, 2, &arena);
+    ASSERT_EQ(3, results.size());
+    for (const auto& result: results) {
+        EXPECT_EQ(expected, hex(result.output));
+    }
+    EXPECT_GT(arena.SpaceUsed(), 0);
+}
+
+TEST(TWAnySigner, SignInto) {
+    const auto input = filecoinInput(1);
+    const auto expected = signSingle(input);
+
+    // size query
+    EXPECT_EQ(expected.size(), TWAnySignerSignInto(input.data(), input.size(), TWCoinTypeFilecoin, nullptr, 0));
+
+    // too small, nothing written
+    Data small(expected.size() - 1, 0);
+    EXPECT_EQ(expected.size(), TWAnySignerSignInto(input.data(), input.size(), TWCoinTypeFilecoin, small.data(), small.size()));
+    EXPECT_EQ(Data(expected.size() - 1, 0), small);
+
+    uint8_t buffer[1024];
+    for (int i = 0; i < 3; ++i) {
+        const auto size = TWAnySignerSignInto(input.data(), input.size(), TWCoinTypeFilecoin, buffer, sizeof(buffer));
+        ASSERT_EQ(expected.size(), size);
+        EXPECT_EQ(hex(expected), hex(buffer, buffer + size));
+    }
+
+    // a size query keeps nothing for the next call
+    const auto other = filecoinInput(3);
+    const auto otherExpected = signSingle(other);
+    EXPECT_EQ(expected.size(), TWAnySignerSignInto(input.data(), input.size(), TWCoinTypeFilecoin, nullptr, 0));
+    const auto size = TWAnySignerSignInto(other.data(), other.size(), TWCoinTypeFilecoin, buffer, sizeof(buffer));
+    ASSERT_EQ(otherExpected.size(), size);
+    EXPECT_EQ(hex(otherExpected), hex(buffer, buffer + size));
+}
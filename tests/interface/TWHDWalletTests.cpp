@@ -148,6 +148,34 @@ TEST(HDWallet, DeriveBitcoinExtended) {
     assertStringsEqual(address, "bc1qumwjg8danv2vm29lp5swdux4r60ezptzz7ce85");
 }
 
+TEST(HDWallet, DeriveAddressInto) {
+    auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(words.get(), passphrase.get()));
+    auto key = WRAP(TWPrivateKey, TWHDWalletGetKeyForCoin(wallet.get(), TWCoinTypeBitcoin));
+    auto keyData = WRAPD(TWPrivateKeyData(key.get()));
+    auto publicKey = WRAP(TWPublicKey, TWPrivateKeyGetPublicKeySecp256k1(key.get(), true));
+    auto publicKeyData = WRAPD(TWPublicKeyData(publicKey.get()));
+    const std::string expected = "bc1qumwjg8danv2vm29lp5swdux4r60ezptzz7ce85";
+
+    char buffer[128];
+    auto size = TWCoinTypeDeriveAddressFromPublicKeyInto(TWCoinTypeBitcoin, TWDataBytes(publicKeyData.get()), TWDataSize(publicKeyData.get()), buffer, sizeof(buffer));
+    ASSERT_EQ(expected.size(), size);
+    EXPECT_EQ(expected, std::string(buffer));
+
+    size = TWCoinTypeDeriveAddressInto(TWCoinTypeBitcoin, TWDataBytes(keyData.get()), TWDataSize(keyData.get()), buffer, sizeof(buffer));
+    ASSERT_EQ(expected.size(), size);
+    EXPECT_EQ(expected, std::string(buffer));
+
+    // no room for the terminator
+    char small[42] = {};
+    EXPECT_EQ(expected.size(), TWCoinTypeDeriveAddressFromPublicKeyInto(TWCoinTypeBitcoin, TWDataBytes(publicKeyData.get()), TWDataSize(publicKeyData.get()), small, sizeof(small)));
+    EXPECT_EQ(0, small[0]);
+
+    const uint8_t invalid[33] = {0x05};
+    EXPECT_EQ(0, TWCoinTypeDeriveAddressFromPublicKeyInto(TWCoinTypeBitcoin, invalid, sizeof(invalid), buffer, sizeof(buffer)));
+    const uint8_t zero[32] = {};
+    EXPECT_EQ(0, TWCoinTypeDeriveAddressInto(TWCoinTypeBitcoin, zero, sizeof(zero), buffer, sizeof(buffer)));
+}
+
 TEST(HDWallet, DeriveAddressBitcoin) {
     auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(words.get(), passphrase.get()));
     auto address = WRAP(TWString, TWHDWalletGetAddressForCoin(wallet.get(), TWCoinTypeBitcoin));
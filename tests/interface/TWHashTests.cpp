@@ -285,3 +285,29 @@ TEST(TWHashTests, Groestl512Groestl512) {
         EXPECT_EQ(hex(data(TWDataBytes(hash.get()), TWDataSize(hash.get()))), get<1>(test));
     }
 }
+
+TEST(TWHashTests, Into) {
+    for (const auto& input: {string(""), brownFox, brownFoxDot}) {
+        const auto bytes = reinterpret_cast<const uint8_t *>(input.c_str());
+        const auto inData = WRAPD(TWDataCreateWithBytes(bytes, input.length()));
+        uint8_t output[64];
+
+        TWHashSHA256Into(bytes, input.length(), output);
+        EXPECT_EQ(hex(output, output + 32), hex(*reinterpret_cast<const Data*>(WRAPD(TWHashSHA256(inData.get())).get())));
+        TWHashSHA512Into(bytes, input.length(), output);
+        EXPECT_EQ(hex(output, output + 64), hex(*reinterpret_cast<const Data*>(WRAPD(TWHashSHA512(inData.get())).get())));
+        TWHashKeccak256Into(bytes, input.length(), output);
+        EXPECT_EQ(hex(output, output + 32), hex(*reinterpret_cast<const Data*>(WRAPD(TWHashKeccak256(inData.get())).get())));
+        TWHashRIPEMDInto(bytes, input.length(), output);
+        EXPECT_EQ(hex(output, output + 20), hex(*reinterpret_cast<const Data*>(WRAPD(TWHashRIPEMD(inData.get())).get())));
+        EXPECT_TRUE(TWHashBlake2bInto(bytes, input.length(), output, 32));
+        EXPECT_EQ(hex(output, output + 32), hex(*reinterpret_cast<const Data*>(WRAPD(TWHashBlake2b(inData.get(), 32)).get())));
+        TWHashSHA256SHA256Into(bytes, input.length(), output);
+        EXPECT_EQ(hex(output, output + 32), hex(*reinterpret_cast<const Data*>(WRAPD(TWHashSHA256SHA256(inData.get())).get())));
+        TWHashSHA256RIPEMDInto(bytes, input.length(), output);
+        EXPECT_EQ(hex(output, output + 20), hex(*reinterpret_cast<const Data*>(WRAPD(TWHashSHA256RIPEMD(inData.get())).get())));
+
+        EXPECT_FALSE(TWHashBlake2bInto(bytes, input.length(), output, 0));
+        EXPECT_FALSE(TWHashBlake2bInto(bytes, input.length(), output, 65));
+    }
+}
@@ -41,6 +41,21 @@ TEST(TWPrivateKeyTests, CreateCopy) {
     ASSERT_TRUE(privateKey1.get() != nullptr);
     const auto privateKey2 = WRAP(TWPrivateKey, TWPrivateKeyCreateCopy(privateKey1.get()));
     ASSERT_TRUE(privateKey2.get() != nullptr);
+    EXPECT_EQ(TW::hex(privateKey1->impl.bytes), TW::hex(privateKey2->impl.bytes));
+}
+
+TEST(TWPrivateKeyTests, CreateCopyExtended) {
+    // only the key bytes are copied
+    const auto extendedHex = std::string(key1Hex) + key1Hex + key1Hex;
+    const auto extended = DATA(extendedHex.c_str());
+    const auto privateKey1 = WRAP(TWPrivateKey, TWPrivateKeyCreateWithData(extended.get()));
+    ASSERT_TRUE(privateKey1.get() != nullptr);
+    ASSERT_EQ(32, privateKey1->impl.extensionBytes.size());
+    const auto privateKey2 = WRAP(TWPrivateKey, TWPrivateKeyCreateCopy(privateKey1.get()));
+    ASSERT_TRUE(privateKey2.get() != nullptr);
+    EXPECT_EQ(TW::hex(privateKey1->impl.bytes), TW::hex(privateKey2->impl.bytes));
+    EXPECT_TRUE(privateKey2->impl.extensionBytes.empty());
+    EXPECT_TRUE(privateKey2->impl.chainCodeBytes.empty());
 }
 
 TEST(TWPrivateKeyTests, AllZeros) {
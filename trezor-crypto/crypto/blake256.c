@@ -12,8 +12,15 @@
  */
 #include <TrezorCrypto/blake256.h>
 
+#include "blake256_testing.h"
+
 #include <string.h>
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BLAKE256_SSSE3 1
+#include <tmmintrin.h>
+#endif
+
 #define U8TO32_BIG(p)					      \
   (((uint32_t)((p)[0]) << 24) | ((uint32_t)((p)[1]) << 16) |  \
    ((uint32_t)((p)[2]) <<  8) | ((uint32_t)((p)[3])      ))
@@ -117,6 +124,129 @@ static void blake256_compress( BLAKE256_CTX *S, const uint8_t *block )
   for( i = 0; i < 8 ; ++i )  S->h[i] ^= S->s[i % 4];
 }
 
+#ifdef BLAKE256_SSSE3
+
+/*
+   Compression with the state held in four rows of 4 words: the four G functions of
+   a column or diagonal step run in parallel, the diagonals being lined up by
+   rotating rows b, c and d.
+ */
+__attribute__((target("ssse3")))
+static void blake256_compress_ssse3( BLAKE256_CTX *S, const uint8_t *block )
+{
+  const __m128i bswap = _mm_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+  const __m128i rot16 = _mm_setr_epi8( 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13 );
+  const __m128i rot8 = _mm_setr_epi8( 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12 );
+  uint32_t m[16];
+  __m128i a, b, c, d, s, t;
+  int i;
+
+  for( i = 0; i < 4; ++i )
+    _mm_storeu_si128( ( __m128i * ) ( m + 4 * i ),
+                      _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i * ) ( block + 16 * i ) ), bswap ) );
+
+  s = _mm_loadu_si128( ( const __m128i * ) S->s );
+  a = _mm_loadu_si128( ( const __m128i * ) S->h );
+  b = _mm_loadu_si128( ( const __m128i * ) ( S->h + 4 ) );
+  c = _mm_xor_si128( s, _mm_loadu_si128( ( const __m128i * ) u256 ) );
+  d = _mm_loadu_si128( ( const __m128i * ) ( u256 + 4 ) );
+
+  /* don't xor t when the block is only padding */
+  if ( !S->nullt )
+    d = _mm_xor_si128( d, _mm_setr_epi32( ( int ) S->t[0], ( int ) S->t[0], ( int ) S->t[1], ( int ) S->t[1] ) );
+
+#define ROT12(x) _mm_or_si128( _mm_srli_epi32( (x), 12 ), _mm_slli_epi32( (x), 20 ) )
+#define ROT7(x) _mm_or_si128( _mm_srli_epi32( (x), 7 ), _mm_slli_epi32( (x), 25 ) )
+#define MSG(e, f) \
+  _mm_setr_epi32( ( int ) ( m[sg[(e)]] ^ u256[sg[(f)]] ), ( int ) ( m[sg[(e) + 2]] ^ u256[sg[(f) + 2]] ), \
+                  ( int ) ( m[sg[(e) + 4]] ^ u256[sg[(f) + 4]] ), ( int ) ( m[sg[(e) + 6]] ^ u256[sg[(f) + 6]] ) )
+#define G4(e)                                             \
+  t = MSG( e, e + 1 );                                    \
+  a = _mm_add_epi32( _mm_add_epi32( a, t ), b );          \
+  d = _mm_shuffle_epi8( _mm_xor_si128( d, a ), rot16 );   \
+  c = _mm_add_epi32( c, d );                              \
+  b = ROT12( _mm_xor_si128( b, c ) );                     \
+  t = MSG( e + 1, e );                                    \
+  a = _mm_add_epi32( _mm_add_epi32( a, t ), b );          \
+  d = _mm_shuffle_epi8( _mm_xor_si128( d, a ), rot8 );    \
+  c = _mm_add_epi32( c, d );                              \
+  b = ROT7( _mm_xor_si128( b, c ) );
+
+  for( i = 0; i < 14; ++i )
+  {
+    const uint8_t *sg = sigma[i];
+    /* column step */
+    G4( 0 );
+    /* diagonal step */
+    b = _mm_shuffle_epi32( b, _MM_SHUFFLE( 0, 3, 2, 1 ) );
+    c = _mm_shuffle_epi32( c, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+    d = _mm_shuffle_epi32( d, _MM_SHUFFLE( 2, 1, 0, 3 ) );
+    G4( 8 );
+    b = _mm_shuffle_epi32( b, _MM_SHUFFLE( 2, 1, 0, 3 ) );
+    c = _mm_shuffle_epi32( c, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+    d = _mm_shuffle_epi32( d, _MM_SHUFFLE( 0, 3, 2, 1 ) );
+  }
+
+#undef G4
+#undef MSG
+#undef ROT7
+#undef ROT12
+
+  a = _mm_xor_si128( _mm_xor_si128( a, c ), s );
+  b = _mm_xor_si128( _mm_xor_si128( b, d ), s );
+  _mm_storeu_si128( ( __m128i * ) S->h, _mm_xor_si128( _mm_loadu_si128( ( const __m128i * ) S->h ), a ) );
+  _mm_storeu_si128( ( __m128i * ) ( S->h + 4 ), _mm_xor_si128( _mm_loadu_si128( ( const __m128i * ) ( S->h + 4 ) ), b ) );
+}
+
+/* set at load time, as the CPU check is too slow to run per block; until then the portable code is used */
+static int blake256_ssse3_available;
+/* whether the SSSE3 code is used: when available, unless forced to the portable code by tests */
+static int blake256_ssse3;
+
+__attribute__((constructor))
+static void blake256_detect_ssse3( void )
+{
+  __builtin_cpu_init();
+  blake256_ssse3_available = __builtin_cpu_supports( "ssse3" ) != 0;
+  __atomic_store_n( &blake256_ssse3, blake256_ssse3_available, __ATOMIC_RELAXED );
+}
+
+#endif
+
+int blake256_force_portable( int portable )
+{
+#ifdef BLAKE256_SSSE3
+  __atomic_store_n( &blake256_ssse3, !portable && blake256_ssse3_available, __ATOMIC_RELAXED );
+  return blake256_ssse3_available;
+#else
+  ( void ) portable;
+  return 0;
+#endif
+}
+
+/* Compresses count consecutive blocks, with the block counter advanced before each. */
+static void blake256_compress_blocks( BLAKE256_CTX *S, const uint8_t *blocks, size_t count )
+{
+#ifdef BLAKE256_SSSE3
+  if ( __atomic_load_n( &blake256_ssse3, __ATOMIC_RELAXED ) )
+  {
+    for( ; count > 0; --count, blocks += 64 )
+    {
+      S->t[0] += 512;
+      if ( S->t[0] == 0 ) S->t[1]++;
+      blake256_compress_ssse3( S, blocks );
+    }
+    return;
+  }
+#endif
+  for( ; count > 0; --count, blocks += 64 )
+  {
+    S->t[0] += 512;
+    if ( S->t[0] == 0 ) S->t[1]++;
+    blake256_compress( S, blocks );
+  }
+}
+
 
 void blake256_Init( BLAKE256_CTX *S )
 {
@@ -142,26 +272,18 @@ void blake256_Update( BLAKE256_CTX *S, const uint8_t *in, size_t inlen )
   if( left && ( inlen >= fill ) )
   {
     memcpy( ( void * ) ( S->buf + left ), ( void * ) in, fill );
-    S->t[0] += 512;
-
-    if ( S->t[0] == 0 ) S->t[1]++;
-
-    blake256_compress( S, S->buf );
+    blake256_compress_blocks( S, S->buf, 1 );
     in += fill;
     inlen  -= fill;
     left = 0;
   }
 
   /* compress blocks of data received */
-  while( inlen >= 64 )
+  if( inlen >= 64 )
   {
-    S->t[0] += 512;
-
-    if ( S->t[0] == 0 ) S->t[1]++;
-
-    blake256_compress( S, in );
-    in += 64;
-    inlen -= 64;
+    blake256_compress_blocks( S, in, inlen / 64 );
+    in += inlen & ~( size_t ) 63;
+    inlen &= 63;
   }
 
   /* store any data left */
@@ -0,0 +1,18 @@
+/* Test hooks of blake256.c, not part of the installed headers. */
+
+#ifndef __BLAKE256_TESTING_H__
+#define __BLAKE256_TESTING_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* If portable is non-zero, uses the portable code instead of the vector code selected for the CPU, in all threads.
+   Returns whether the vector code is available. */
+int blake256_force_portable(int portable);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __BLAKE256_TESTING_H__ */
@@ -190,6 +190,37 @@ void ge25519_pack(unsigned char r[32], const ge25519 *p) {
 	r[31] ^= ((parity[0] & 1) << 7);
 }
 
+void ge25519_pack_batch(unsigned char r[][32], const ge25519 *p, size_t count, bignum25519 *scratch) {
+	bignum25519 tx, ty, zi, inv;
+	unsigned char parity[32];
+	size_t i;
+
+	if (count == 0) {
+		return;
+	}
+
+	/* Montgomery's trick: scratch[i] = z0 * ... * zi, inverted once */
+	curve25519_copy(scratch[0], p[0].z);
+	for (i = 1; i < count; i++) {
+		curve25519_mul(scratch[i], scratch[i - 1], p[i].z);
+	}
+	curve25519_recip(inv, scratch[count - 1]);
+	for (i = count - 1; i > 0; i--) {
+		curve25519_mul(zi, inv, scratch[i - 1]);
+		curve25519_mul(inv, inv, p[i].z);
+		curve25519_mul(tx, p[i].x, zi);
+		curve25519_mul(ty, p[i].y, zi);
+		curve25519_contract(r[i], ty);
+		curve25519_contract(parity, tx);
+		r[i][31] ^= ((parity[0] & 1) << 7);
+	}
+	curve25519_mul(tx, p[0].x, inv);
+	curve25519_mul(ty, p[0].y, inv);
+	curve25519_contract(r[0], ty);
+	curve25519_contract(parity, tx);
+	r[0][31] ^= ((parity[0] & 1) << 7);
+}
+
 int ge25519_unpack_negative_vartime(ge25519 *r, const unsigned char p[32]) {
 	const unsigned char zero[32] = {0};
 	const bignum25519 one = {1};
@@ -530,6 +561,26 @@ void ge25519_scalarmult_base_niels(ge25519 *r, const uint8_t basepoint_table[256
 	}
 }
 
+void ge25519_scalarmult_base_niels_wide(ge25519 *r, const uint8_t even_table[256][96], const uint8_t odd_table[256][96], const bignum256modm s) {
+	signed char b[64];
+	uint32_t i;
+	ge25519_niels t;
+
+	contract256_window4_modm(b, s);
+
+	/* the first even entries hold 2xy instead of 2dxy, so that they start the sum */
+	ge25519_scalarmult_base_choose_niels(&t, even_table, 0, b[0]);
+	curve25519_sub_reduce(r->x, t.xaddy, t.ysubx);
+	curve25519_add_reduce(r->y, t.xaddy, t.ysubx);
+	memset(r->z, 0, sizeof(bignum25519));
+	curve25519_copy(r->t, t.t2d);
+	r->z[0] = 2;
+	for (i = 1; i < 64; i++) {
+		ge25519_scalarmult_base_choose_niels(&t, (i & 1) ? odd_table : even_table, i / 2, b[i]);
+		ge25519_nielsadd2(r, &t);
+	}
+}
+
 int ge25519_check(const ge25519 *r){
 	/* return (z % q != 0 and
 						 x * y % q == z * t % q and
@@ -50,10 +50,33 @@ ED25519_FN(ed25519_publickey) (const ed25519_secret_key sk, ed25519_public_key p
 	ed25519_extsk(extsk, sk);
 
 	expand256_modm(a, extsk, 32);
-	ge25519_scalarmult_base_niels(&A, ge25519_niels_base_multiples, a);
+	ge25519_scalarmult_base_niels_wide(&A, ge25519_niels_base_multiples, ge25519_niels_base_multiples_odd, a);
 	ge25519_pack(pk, &A);
 }
 
+void
+ED25519_FN(ed25519_publickey_batch) (const ed25519_secret_key *sks, ed25519_public_key *pks, size_t count) {
+	bignum256modm a;
+	ge25519 ALIGN(16) A[ED25519_PUBLICKEY_BATCH_SIZE];
+	bignum25519 scratch[ED25519_PUBLICKEY_BATCH_SIZE];
+	hash_512bits extsk;
+	size_t i, n;
+
+	/* A = aB for each key, packed together in chunks */
+	while (count > 0) {
+		n = count < ED25519_PUBLICKEY_BATCH_SIZE ? count : ED25519_PUBLICKEY_BATCH_SIZE;
+		for (i = 0; i < n; i++) {
+			ed25519_extsk(extsk, sks[i]);
+			expand256_modm(a, extsk, 32);
+			ge25519_scalarmult_base_niels_wide(&A[i], ge25519_niels_base_multiples, ge25519_niels_base_multiples_odd, a);
+		}
+		ge25519_pack_batch(pks, A, n, scratch);
+		sks += n;
+		pks += n;
+		count -= n;
+	}
+}
+
 void
 ED25519_FN(ed25519_publickey_ext) (const ed25519_secret_key sk, const ed25519_secret_key skext, ed25519_public_key pk) {
 	bignum256modm a;
@@ -65,7 +88,7 @@ ED25519_FN(ed25519_publickey_ext) (const ed25519_secret_key sk, const ed25519_se
 	memcpy(extsk, sk, 32);
 	memcpy(extsk+32, skext, 32);
 	expand256_modm(a, extsk, 32);
-	ge25519_scalarmult_base_niels(&A, ge25519_niels_base_multiples, a);
+	ge25519_scalarmult_base_niels_wide(&A, ge25519_niels_base_multiples, ge25519_niels_base_multiples_odd, a);
 	ge25519_pack(pk, &A);
 }
 
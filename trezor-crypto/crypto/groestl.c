@@ -35,10 +35,18 @@
 #include <string.h>
 
 #include "groestl_internal.h"
+#include "groestl_testing.h"
 
 #include <TrezorCrypto/memzero.h>
 #include <TrezorCrypto/groestl.h>
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GROESTL_AESNI 1
+#include <cpuid.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+#endif
+
 #define C32e(x)     ((SPH_C32(x) >> 24) \
                     | ((SPH_C32(x) >>  8) & SPH_C32(0x0000FF00)) \
                     | ((SPH_C32(x) <<  8) & SPH_C32(0x00FF0000)) \
@@ -672,6 +680,268 @@ static const sph_u32 T1dn[] = {
 	} while (0)
 
 
+#ifdef GROESTL_AESNI
+
+/*
+ * Groestl-1024 permutations with AES-NI, without lookup tables.
+ *
+ * The 8x16 byte state is held as one vector per row (the state bytes are
+ * stored column by column, so loading and storing transposes it).  SubBytes
+ * is AESENCLAST with a zero key; the AES ShiftRows it applies is undone by
+ * the byte shuffle which also does ShiftBytes.  MixBytes multiplies the
+ * columns by circ(2, 2, 3, 4, 5, 3, 5, 7), split into the rows weighted by
+ * 1, 2 and 4.
+ */
+
+/* ShiftBytes distances of the rows, for P and Q */
+static const unsigned char groestl_shift_p[8] = { 0, 1, 2, 3, 4, 5, 6, 11 };
+static const unsigned char groestl_shift_q[8] = { 1, 3, 5, 11, 0, 2, 4, 6 };
+
+typedef struct {
+	__m128i shuffle_p[8];
+	__m128i shuffle_q[8];
+} groestl_aesni_masks;
+
+static void
+groestl_aesni_init_masks(groestl_aesni_masks *masks)
+{
+	unsigned char mp[16], mq[16];
+	int row, c, r;
+
+	for (row = 0; row < 8; row ++) {
+		for (c = 0; c < 4; c ++) {
+			for (r = 0; r < 4; r ++) {
+				/* the byte that AES ShiftRows moves to position 4c + r */
+				int from = 4 * ((c - r + 4) & 3) + r;
+				mp[4 * c + r] = (unsigned char)((from + groestl_shift_p[row]) & 15);
+				mq[4 * c + r] = (unsigned char)((from + groestl_shift_q[row]) & 15);
+			}
+		}
+		memcpy(&masks->shuffle_p[row], mp, 16);
+		memcpy(&masks->shuffle_q[row], mq, 16);
+	}
+}
+
+__attribute__((target("sse2")))
+static inline __m128i
+groestl_aesni_xtime(__m128i x)
+{
+	__m128i carry = _mm_cmplt_epi8(x, _mm_setzero_si128());
+	return _mm_xor_si128(_mm_add_epi8(x, x),
+		_mm_and_si128(carry, _mm_set1_epi8(0x1B)));
+}
+
+__attribute__((target("aes,ssse3")))
+static void
+groestl_aesni_round(__m128i a[8], const __m128i shuffle[8])
+{
+	__m128i t[8], x1, x2, x4;
+	int i;
+
+	/* SubBytes and ShiftBytes */
+	for (i = 0; i < 8; i ++)
+		t[i] = _mm_aesenclast_si128(_mm_shuffle_epi8(a[i], shuffle[i]),
+			_mm_setzero_si128());
+
+	/* MixBytes */
+	for (i = 0; i < 8; i ++) {
+		x1 = _mm_xor_si128(_mm_xor_si128(t[(i + 2) & 7], t[(i + 4) & 7]),
+			_mm_xor_si128(_mm_xor_si128(t[(i + 5) & 7], t[(i + 6) & 7]), t[(i + 7) & 7]));
+		x2 = _mm_xor_si128(_mm_xor_si128(t[i], t[(i + 1) & 7]),
+			_mm_xor_si128(_mm_xor_si128(t[(i + 2) & 7], t[(i + 5) & 7]), t[(i + 7) & 7]));
+		x4 = _mm_xor_si128(_mm_xor_si128(t[(i + 3) & 7], t[(i + 4) & 7]),
+			_mm_xor_si128(t[(i + 6) & 7], t[(i + 7) & 7]));
+		a[i] = _mm_xor_si128(x1,
+			groestl_aesni_xtime(_mm_xor_si128(x2, groestl_aesni_xtime(x4))));
+	}
+}
+
+__attribute__((target("aes,ssse3")))
+static void
+groestl_aesni_perm_p(__m128i a[8], const groestl_aesni_masks *masks)
+{
+	__m128i columns = _mm_setr_epi8(0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70,
+		(char)0x80, (char)0x90, (char)0xA0, (char)0xB0, (char)0xC0, (char)0xD0, (char)0xE0, (char)0xF0);
+	int r;
+
+	for (r = 0; r < 14; r ++) {
+		a[0] = _mm_xor_si128(a[0], _mm_xor_si128(columns, _mm_set1_epi8((char)r)));
+		groestl_aesni_round(a, masks->shuffle_p);
+	}
+}
+
+__attribute__((target("aes,ssse3")))
+static void
+groestl_aesni_perm_q(__m128i a[8], const groestl_aesni_masks *masks)
+{
+	__m128i ones = _mm_set1_epi8(-1);
+	__m128i columns = _mm_setr_epi8(-1, (char)0xEF, (char)0xDF, (char)0xCF,
+		(char)0xBF, (char)0xAF, (char)0x9F, (char)0x8F, 0x7F, 0x6F, 0x5F, 0x4F,
+		0x3F, 0x2F, 0x1F, 0x0F);
+	int r, i;
+
+	for (r = 0; r < 14; r ++) {
+		for (i = 0; i < 7; i ++)
+			a[i] = _mm_xor_si128(a[i], ones);
+		a[7] = _mm_xor_si128(a[7], _mm_xor_si128(columns, _mm_set1_epi8((char)r)));
+		groestl_aesni_round(a, masks->shuffle_q);
+	}
+}
+
+/* Transposes 8x8 matrices of 16-bit elements: lane r of vector k goes to lane k of vector r. */
+__attribute__((target("sse2")))
+static inline void
+groestl_aesni_transpose(__m128i a[8])
+{
+	__m128i b[8], c[8];
+	int i;
+
+	for (i = 0; i < 4; i ++) {
+		b[i] = _mm_unpacklo_epi16(a[2 * i], a[2 * i + 1]);
+		b[i + 4] = _mm_unpackhi_epi16(a[2 * i], a[2 * i + 1]);
+	}
+	/* b[0..3]: lanes 0-3 of pairs of vectors, b[4..7]: lanes 4-7 */
+	for (i = 0; i < 2; i ++) {
+		c[4 * i] = _mm_unpacklo_epi32(b[4 * i], b[4 * i + 1]);
+		c[4 * i + 1] = _mm_unpackhi_epi32(b[4 * i], b[4 * i + 1]);
+		c[4 * i + 2] = _mm_unpacklo_epi32(b[4 * i + 2], b[4 * i + 3]);
+		c[4 * i + 3] = _mm_unpackhi_epi32(b[4 * i + 2], b[4 * i + 3]);
+	}
+	/* c[4i + j]: two lanes of vectors 0-3 (j < 2) or 4-7 (j >= 2) */
+	for (i = 0; i < 2; i ++) {
+		a[4 * i] = _mm_unpacklo_epi64(c[4 * i], c[4 * i + 2]);
+		a[4 * i + 1] = _mm_unpackhi_epi64(c[4 * i], c[4 * i + 2]);
+		a[4 * i + 2] = _mm_unpacklo_epi64(c[4 * i + 1], c[4 * i + 3]);
+		a[4 * i + 3] = _mm_unpackhi_epi64(c[4 * i + 1], c[4 * i + 3]);
+	}
+}
+
+/*
+ * Loads a state stored column by column into rows: each 16 bytes hold two
+ * columns, which are interleaved into the 16-bit lanes of the rows, and
+ * the lanes then transposed.
+ */
+__attribute__((target("ssse3")))
+static void
+groestl_aesni_load(__m128i a[8], const unsigned char *state)
+{
+	const __m128i interleave = _mm_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+	int i;
+
+	for (i = 0; i < 8; i ++)
+		a[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(state + 16 * i)), interleave);
+	groestl_aesni_transpose(a);
+}
+
+__attribute__((target("ssse3")))
+static void
+groestl_aesni_store(unsigned char *state, const __m128i a[8])
+{
+	const __m128i deinterleave = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+	__m128i t[8];
+	int i;
+
+	memcpy(t, a, sizeof t);
+	groestl_aesni_transpose(t);
+	for (i = 0; i < 8; i ++)
+		_mm_storeu_si128((__m128i *)(state + 16 * i), _mm_shuffle_epi8(t[i], deinterleave));
+}
+
+/* H = P(H ^ m) ^ Q(m) ^ H for count blocks; H holds the little-endian state words. */
+__attribute__((target("aes,ssse3")))
+static void
+groestl_big_compress_aesni(sph_u32 *H, const unsigned char *blocks, size_t count)
+{
+	groestl_aesni_masks masks;
+	__m128i h[8], g[8], m[8];
+	int i;
+
+	groestl_aesni_init_masks(&masks);
+	groestl_aesni_load(h, (const unsigned char *)H);
+	for (; count > 0; count --, blocks += 128) {
+		groestl_aesni_load(m, blocks);
+		for (i = 0; i < 8; i ++)
+			g[i] = _mm_xor_si128(h[i], m[i]);
+		groestl_aesni_perm_p(g, &masks);
+		groestl_aesni_perm_q(m, &masks);
+		for (i = 0; i < 8; i ++)
+			h[i] = _mm_xor_si128(h[i], _mm_xor_si128(g[i], m[i]));
+	}
+	groestl_aesni_store((unsigned char *)H, h);
+}
+
+/* H = P(H) ^ H */
+__attribute__((target("aes,ssse3")))
+static void
+groestl_big_final_aesni(sph_u32 *H)
+{
+	groestl_aesni_masks masks;
+	__m128i h[8], x[8];
+	int i;
+
+	groestl_aesni_init_masks(&masks);
+	groestl_aesni_load(h, (const unsigned char *)H);
+	memcpy(x, h, sizeof x);
+	groestl_aesni_perm_p(x, &masks);
+	for (i = 0; i < 8; i ++)
+		h[i] = _mm_xor_si128(h[i], x[i]);
+	groestl_aesni_store((unsigned char *)H, h);
+}
+
+/* set at load time, as cpuid is too slow to run per block; until then the portable code is used */
+static int groestl_aesni_available;
+/* whether the AES-NI code is used: when available, unless forced to the portable code by tests */
+static int groestl_aesni;
+
+__attribute__((constructor))
+static void
+groestl_detect_aesni(void)
+{
+	unsigned int eax, ebx, ecx, edx;
+
+	if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		groestl_aesni_available = (ecx & bit_AES) != 0 && (ecx & bit_SSSE3) != 0;
+	__atomic_store_n(&groestl_aesni, groestl_aesni_available, __ATOMIC_RELAXED);
+}
+
+#endif
+
+int
+groestl512_force_portable(int portable)
+{
+#ifdef GROESTL_AESNI
+	__atomic_store_n(&groestl_aesni, !portable && groestl_aesni_available, __ATOMIC_RELAXED);
+	return groestl_aesni_available;
+#else
+	(void)portable;
+	return 0;
+#endif
+}
+
+static void
+groestl_big_compress(sph_u32 *H, const unsigned char *buf)
+{
+#ifdef GROESTL_AESNI
+	if (__atomic_load_n(&groestl_aesni, __ATOMIC_RELAXED)) {
+		groestl_big_compress_aesni(H, buf, 1);
+		return;
+	}
+#endif
+	COMPRESS_BIG;
+}
+
+static void
+groestl_big_final(sph_u32 *H)
+{
+#ifdef GROESTL_AESNI
+	if (__atomic_load_n(&groestl_aesni, __ATOMIC_RELAXED)) {
+		groestl_big_final_aesni(H);
+		return;
+	}
+#endif
+	FINAL_BIG;
+}
+
 static void
 groestl_big_init(sph_groestl_big_context *sc, unsigned out_size)
 {
@@ -705,6 +975,18 @@ groestl_big_core(sph_groestl_big_context *sc, const void *data, size_t len)
 	while (len > 0) {
 		size_t clen;
 
+#ifdef GROESTL_AESNI
+		/* whole blocks are compressed in place, keeping the state in registers */
+		if (groestl_aesni && ptr == 0 && len >= sizeof sc->buf) {
+			size_t blocks = len / sizeof sc->buf;
+
+			groestl_big_compress_aesni(H, (const unsigned char *)data, blocks);
+			sc->count += blocks;
+			data = (const unsigned char *)data + blocks * sizeof sc->buf;
+			len -= blocks * sizeof sc->buf;
+			continue;
+		}
+#endif
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
@@ -713,7 +995,7 @@ groestl_big_core(sph_groestl_big_context *sc, const void *data, size_t len)
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		if (ptr == sizeof sc->buf) {
-			COMPRESS_BIG;
+			groestl_big_compress(H, buf);
 			sc->count ++;
 			ptr = 0;
 		}
@@ -746,7 +1028,7 @@ groestl_big_close(sph_groestl_big_context *sc,
 	sph_enc64be(pad + pad_len - 8, count);
 	groestl_big_core(sc, pad, pad_len);
 	READ_STATE_BIG(sc);
-	FINAL_BIG;
+	groestl_big_final(H);
 	for (u2 = 0; u2 < 16; u2 ++)
 		enc32e(pad + (u2 << 2), H[u2 + 16]);
 	memcpy(dst, pad + 64 - out_len, out_len);
@@ -0,0 +1,23 @@
+/* Test hooks of groestl.c, not part of the installed headers. */
+
+#ifndef GROESTL_TESTING_H__
+#define GROESTL_TESTING_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * If portable is non-zero, use the portable code instead of the AES-NI code
+ * selected for the CPU, in all threads.
+ *
+ * @param portable   whether to use the portable code
+ * @return non-zero if the AES-NI code is available
+ */
+int groestl512_force_portable(int portable);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -8,9 +8,11 @@ extern "C" {
 #endif
 
 void ed25519_publickey_blake2b(const ed25519_secret_key sk, ed25519_public_key pk);
+void ed25519_publickey_batch_blake2b(const ed25519_secret_key *sks, ed25519_public_key *pks, size_t count);
 
 int ed25519_sign_open_blake2b(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
 void ed25519_sign_blake2b(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS);
+void ed25519_sign_ext_blake2b(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_secret_key skext, const ed25519_public_key pk, ed25519_signature RS);
 
 int ed25519_scalarmult_blake2b(ed25519_public_key res, const ed25519_secret_key sk, const ed25519_public_key pk);
 
@@ -5,6 +5,9 @@ extern "C" {
 /* multiples of the base point in packed {ysubx, xaddy, t2d} form */
 extern const uint8_t ALIGN(16) ge25519_niels_base_multiples[256][96];
 
+/* multiples of 16 times the base point, the odd nibble positions, in packed {ysubx, xaddy, t2d} form */
+extern const uint8_t ALIGN(16) ge25519_niels_base_multiples_odd[256][96];
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -47,6 +47,9 @@ void ge25519_pnielsadd(ge25519_pniels *r, const ge25519 *p, const ge25519_pniels
 
 void ge25519_pack(unsigned char r[32], const ge25519 *p);
 
+/* packs count points, with a single field inversion; scratch holds count elements */
+void ge25519_pack_batch(unsigned char r[][32], const ge25519 *p, size_t count, bignum25519 *scratch);
+
 int ge25519_unpack_negative_vartime(ge25519 *r, const unsigned char p[32]);
 
 /*
@@ -66,6 +69,9 @@ void ge25519_scalarmult_base_choose_niels(ge25519_niels *t, const uint8_t table[
 /* computes [s]basepoint */
 void ge25519_scalarmult_base_niels(ge25519 *r, const uint8_t basepoint_table[256][96], const bignum256modm s);
 
+/* computes [s]basepoint without doublings, with a table for the even and one for the odd nibble positions */
+void ge25519_scalarmult_base_niels_wide(ge25519 *r, const uint8_t even_table[256][96], const uint8_t odd_table[256][96], const bignum256modm s);
+
 /* check if r is on curve */
 int ge25519_check(const ge25519 *r);
 
@@ -8,6 +8,7 @@ extern "C" {
 #endif
 
 void ed25519_publickey_keccak(const ed25519_secret_key sk, ed25519_public_key pk);
+void ed25519_publickey_batch_keccak(const ed25519_secret_key *sks, ed25519_public_key *pks, size_t count);
 
 int ed25519_sign_open_keccak(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
 void ed25519_sign_keccak(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS);
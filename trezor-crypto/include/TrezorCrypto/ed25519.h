@@ -16,6 +16,12 @@ typedef unsigned char ed25519_cosi_signature[32];
 void ed25519_publickey(const ed25519_secret_key sk, ed25519_public_key pk);
 void ed25519_publickey_ext(const ed25519_secret_key sk, const ed25519_secret_key skext, ed25519_public_key pk);
 
+/* number of keys ed25519_publickey_batch derives per field inversion */
+#define ED25519_PUBLICKEY_BATCH_SIZE 16
+
+/* derives count public keys, same as ed25519_publickey for each */
+void ed25519_publickey_batch(const ed25519_secret_key *sks, ed25519_public_key *pks, size_t count);
+
 int ed25519_sign_open(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
 void ed25519_sign(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS);
 void ed25519_sign_ext(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_secret_key skext, const ed25519_public_key pk, ed25519_signature RS);